@@ -0,0 +1,62 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Interface IAlignmentFile
+//
+//  DESCRIPTION   :	Common interface of alignment output files
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <string>
+#include <vector>
+
+// -- forward declarations -----------------------------------------------
+struct samRecord;
+struct samHeader;
+
+// -- exported constants, types, classes ---------------------------------
+
+class IAlignmentFile
+{
+public:
+	// constructor
+	IAlignmentFile(){};
+
+	// virtual destructor
+	virtual ~IAlignmentFile(){};
+
+	// write header, must be called before records are appended
+	virtual void writeHeader(samHeader header) = 0;
+
+	// append records to file
+	virtual void append(std::vector<samRecord>& records) = 0;
+
+	// append record in file format to buffer, safe to call from multiple threads
+	virtual void encode(samRecord const & record, std::string& buffer) const = 0;
+
+	// append records encoded by encode to file
+	virtual void appendEncoded(std::string const & data) = 0;
+
+	// write pending output, no records are appended afterwards
+	virtual void close(void) = 0;
+
+protected:
+
+private:
+	// methods
+	// Copy constructor must not be used
+	IAlignmentFile(const IAlignmentFile& object);
+
+	// Assignment operator must not be used
+	const IAlignmentFile& operator=(const IAlignmentFile& rhs);
+};
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
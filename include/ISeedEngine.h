@@ -0,0 +1,56 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Interface ISeedEngine
+//
+//  DESCRIPTION   :	Selection of read substrings looked up as seeds
+//					of the seed alignment
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+typedef struct readSeed
+{
+	uint32_t offset = 0;			// position in read
+	std::string sequence;
+}readSeed;
+
+class ISeedEngine
+{
+public:
+	// constructor
+	ISeedEngine(){};
+
+	// virtual destructor
+	virtual ~ISeedEngine(){};
+
+	// seeds of read in order of offset, safe to call from multiple threads
+	virtual std::vector<readSeed> getSeeds(std::string const & sequence) = 0;
+
+protected:
+
+private:
+	// methods
+	// Copy constructor must not be used
+	ISeedEngine(const ISeedEngine& object);
+
+	// Assignment operator must not be used
+	const ISeedEngine& operator=(const ISeedEngine& rhs);
+};
+
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
@@ -0,0 +1,60 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Interface suffixArray
+//
+//  DESCRIPTION   :	Interface implemented by suffix array construction
+//					engines streaming the suffix array in segments
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+
+class ISuffixArray
+{
+public:
+	// constructor
+	ISuffixArray(){};
+
+	// virtual destructor
+	virtual ~ISuffixArray(){};
+
+	// get alphabet
+	virtual std::string getAlphabet(void) = 0;
+
+	// get number of characters for each letter in alphabet
+	virtual std::vector<uint32_t> getAlphabetCount(void) = 0;
+
+	// prepare for streaming suffix array, return max segment size
+	virtual uint32_t prepareForStream(uint32_t maxBlockSize) = 0;
+
+	// get next segment from suffix array stream, empty at end of stream
+	virtual std::vector<uint32_t> getNextSegment(void) = 0;
+
+protected:
+
+private:
+	// methods
+	// Copy constructor must not be used
+	ISuffixArray(const ISuffixArray& object);
+
+	// Assignment operator must not be used
+	const ISuffixArray& operator=(const ISuffixArray& rhs);
+};
+
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
@@ -0,0 +1,40 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : banded global alignment
+//
+//  DESCRIPTION   :	Global alignment of short sequences within a band
+//					around the main diagonal, vectorized over anti-diagonals
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+typedef struct cigarOperation
+{
+	char operation = 'M';			// one of M, I, D, S
+	uint32_t length = 0;
+}cigarOperation;
+
+// -- exported functions - declarations ----------------------------------
+// append operation to cigar, merged with last operation of same type
+void appendCigar(std::vector<cigarOperation>& cigar, char operation, uint32_t length);
+
+// SAM representation of cigar
+std::string cigarString(std::vector<cigarOperation> const & cigar);
+
+// global alignment of query to reference appended to cigar, band is widened by length difference
+void bandedGlobalAlignment(std::string const & query, std::string const & reference, uint32_t bandWidth, std::vector<cigarOperation>& cigar);
+
+// -- exported global variables - declarations (should be empty)----------
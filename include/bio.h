@@ -1,26 +1,27 @@
-// \HEADER\---------------------------------------------------------------
-//
-//  CONTENTS      : Biological helper functions
-//
-//  DESCRIPTION   :	none
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-//  All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-#pragma once
-// -- required headers ---------------------------------------------------
-#include <string>
-
-// -- forward declarations -----------------------------------------------
-
-// -- exported constants, types, classes ---------------------------------
-
-// -- exported functions - declarations ----------------------------------
-std::string reverseComplement(std::string templateString);
-std::string complement(std::string templateString);
-
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Biological helper functions
+//
+//  DESCRIPTION   :	none
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <string>
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+
+// -- exported functions - declarations ----------------------------------
+std::string reverseComplement(std::string templateString);
+std::string complement(std::string templateString);
+bool isHomoPolymer(std::string const & str);
+
 // -- exported global variables - declarations (should be empty)----------
\ No newline at end of file
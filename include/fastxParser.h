@@ -0,0 +1,71 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class fastxParser
+//
+//  DESCRIPTION   :	Block buffered Fasta/ Fastq parser, records refer to
+//					fields within the shared input block
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <vector>
+#include <memory>
+#include <istream>
+#include "sequenceBase.h"
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+class fastxParser
+{
+public:
+	// constructor, recordStartIndicator '>' for fasta and '@' for fastq
+	fastxParser(std::istream& stream, char recordStartIndicator);
+
+	// virtual destructor
+	virtual ~fastxParser();
+
+	// return next record, NULL at end of stream
+	std::shared_ptr<sequenceBase> getRecord(void);
+
+protected:
+
+private:
+	// methods
+	// default constructor
+	fastxParser();
+
+	// Copy constructor must not be used
+	fastxParser(const fastxParser& object);
+
+	// Assignment operator must not be used
+	const fastxParser& operator=(const fastxParser& rhs);
+
+	// move unparsed data to new block and append from stream
+	void readBlock(void);
+
+	// end of line starting at position, NULL if incomplete
+	const char* findLineEnd(const char* line) const;
+
+	// parse record at current position, NULL if incomplete
+	std::shared_ptr<sequenceBase> parseFastq(void);
+	std::shared_ptr<sequenceBase> parseFasta(void);
+
+	// member
+	std::istream& m_stream;
+	char m_recordStartIndicator;
+	std::shared_ptr<std::vector<char>> m_block;
+	size_t m_blockFill = 0;			// valid bytes in block
+	size_t m_blockPosition = 0;		// start of unparsed data
+	bool m_streamEnd = false;
+};
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
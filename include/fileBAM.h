@@ -0,0 +1,117 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class fileBAM
+//
+//  DESCRIPTION   :	Writer of binary BAM files, BGZF blocks are compressed
+//					in parallel
+//
+//  RESTRICTIONS  : records are appended by one thread
+//
+//  REQUIRES      : zlib
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <queue>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+#include <zlib.h>
+#include "fileBase.h"
+#include "fileSAM.h"
+#include "IAlignmentFile.h"
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+class fileBAM : public fileBase, public IAlignmentFile
+{
+public:
+	// constructor, existing file is replaced
+	fileBAM(std::string filePath, uint32_t threads);
+
+	// virtual destructor, closes file if not done before
+	virtual ~fileBAM();
+
+	// write BAM header with reference sequences
+	void writeHeader(samHeader header);
+
+	// append records to file
+	void append(std::vector<samRecord>& records);
+
+	// append binary record to buffer, safe to call from multiple threads
+	void encode(samRecord const & record, std::string& buffer) const;
+
+	// append records encoded by encode to file
+	void appendEncoded(std::string const & data);
+
+	// compress and write remaining records, append end of file marker
+	void close(void);
+
+protected:
+
+private:
+	// types
+	// consecutive BGZF blocks compressed by one worker
+	typedef struct bgzfJob
+	{
+		std::string data;
+		std::vector<char> compressed;
+		bool done = false;
+		bool failed = false;
+	}bgzfJob;
+
+	// methods
+	// default constructor
+	fileBAM();
+
+	// Copy constructor must not be used
+	fileBAM(const fileBAM& object);
+
+	// Assignment operator must not be used
+	const fileBAM& operator=(const fileBAM& rhs);
+
+	// reference id of sequence name, -1 if not in header
+	int32_t referenceId(std::string const & name) const;
+
+	// pass uncompressed data to workers, partial jobs only if requested
+	void queueData(bool all);
+
+	// write compressed jobs in order, waits for pending jobs if requested
+	void writeJobs(bool all);
+
+	// compress data of job into BGZF blocks, false on zlib error
+	static bool deflateBlocks(z_stream& stream, bgzfJob& job);
+
+	// worker thread compressing queued jobs
+	void deflateWorker(void);
+
+	// member
+	std::ofstream m_output;
+	std::map<std::string, int32_t> m_referenceIds;
+	std::string m_data;								// uncompressed, not yet queued
+	bool m_closed = false;
+	// parallel BGZF
+	std::deque<std::shared_ptr<bgzfJob>> m_jobs;		// in output order
+	std::queue<std::shared_ptr<bgzfJob>> m_pending;		// waiting for worker
+	std::vector<std::thread> m_workers;
+	size_t m_maxJobs = 0;
+	bool m_stop = false;
+	std::mutex m_mutex;
+	std::condition_variable m_jobQueued;
+	std::condition_variable m_jobDone;
+};
+
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
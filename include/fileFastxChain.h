@@ -0,0 +1,94 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class fileFastxChain
+//
+//  DESCRIPTION   :	Sequence records of multiple Fasta/ Fastq files read
+//					in order, following file is opened in advance
+//
+//  RESTRICTIONS  : all files contain the same record type
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <exception>
+#include "ISequenceFile.h"
+#include "fileFastx.h"
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+class fileFastxChain : public ISequenceFile
+{
+public:
+	// constructor, threads used to decompress BGZF input
+	fileFastxChain(std::vector<std::string> filePaths, uint32_t threads);
+
+	// virtual destructor
+	virtual ~fileFastxChain();
+
+	// files, directories and wildcard patterns to sorted list of files
+	static std::vector<std::string> expandPaths(std::vector<std::string> const & inputs);
+
+	// return true if no more sequences available
+	bool empty();
+
+	// return next sequence in file, NULL if not available
+	std::shared_ptr<sequenceBase> getRecord();
+
+	// replace records by next batch of sequences, false if no more available,
+	// throws read errors of member files and errors opening the next file
+	bool getRecords(std::vector<std::shared_ptr<sequenceBase>>& records);
+
+	// return extension for output file writer
+	std::string extension() const;
+
+	// return read progress in range 0 - 1.0
+	float progress();
+
+protected:
+
+private:
+	// methods
+	// default constructor
+	fileFastxChain();
+
+	// Copy constructor must not be used
+	fileFastxChain(const fileFastxChain& object);
+
+	// Assignment operator must not be used
+	const fileFastxChain& operator=(const fileFastxChain& rhs);
+
+	// open next file in list, NULL if none left
+	std::shared_ptr<fileFastx> openNext(void);
+
+	// open file following the current one, errors are kept until the current file is read
+	void prefetchNext(void);
+
+	// member
+	std::vector<std::string> m_filePaths;
+	std::string m_extension;
+	uint32_t m_threads;
+	// current and prefetched file, guarded by m_chainMutex
+	std::shared_ptr<fileFastx> m_current;
+	std::shared_ptr<fileFastx> m_next;
+	size_t m_nextFile = 0;
+	size_t m_currentFile = 0;
+	std::exception_ptr m_openError;		// raised once the files before are read
+	std::mutex m_chainMutex;
+	// partially consumed batch of single record access
+	std::vector<std::shared_ptr<sequenceBase>> m_currentBatch;
+	size_t m_currentRecord = 0;
+	std::mutex m_readMutex;
+};
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
@@ -1,177 +1,311 @@
-// \HEADER\---------------------------------------------------------------
-//
-//  CONTENTS      : Class FM-Index
-//
-//  DESCRIPTION   :	FM-Index
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-//  All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-#pragma once
-// -- required headers ---------------------------------------------------
-#include <cstdint>
-#include <string>
-#include <vector>
-#include <map>
-#include <thread>
-#include <condition_variable>
-#include <H5Cpp.h>
-#include "fmIndex_settings.h"
-
-// -- forward declarations -----------------------------------------------
-struct indexValuePair;
-
-// -- exported constants, types, classes ---------------------------------
-typedef struct lcsDefinition
-{
-	uint32_t indexStart = 0;		// offset of match in index
-	uint32_t strStart = 0;			// offset of match in pattern
-	uint32_t lcsLength = 0;			// length of match
-	bool errorFlag = false;
-}lcsDefinition;
-
-
-class fmIndex
-{
-public:
-	// constructor loading index from disk
-	fmIndex(fmIndex_settings& settings, std::string indexFileName);
-
-	// virtual destructor
-	virtual ~fmIndex();
-
-	// allocate memory of input string
-	static void allocateMemory(std::string& str, uint32_t expectedSize);
-
-	// build index
-	static void build(fmIndex_settings& settings, std::string& str, std::string outputFilename);
-
-	// build index using chapters
-	static void build(fmIndex_settings& settings, std::string& str, std::string outputFilename, 
-					  std::map<uint32_t, std::string> chapters);
-
-	// load existing index from disk
-	void load(std::string indexFile);
-
-	// return complete index sequence
-	std::string getIndexSequence(void);
-
-	// get substr of index sequence
-	std::string getIndexSequence(uint32_t start, uint32_t length);
-
-	// return vector containing all occurences of pattern in index
-	std::vector<uint32_t> getMatchingPositions(std::string const & pattern);
-
-	// limit matching positions for performance reasons
-	std::vector<uint32_t> getMatchingPositions(std::string const & pattern, const uint32_t maxResults);
-
-	// return positions of longest common substring of pattern and index
-	std::vector<lcsDefinition> getLongestCommonSubsequence(std::string const & pattern);
-
-	// return name and relative position in chapter
-	std::pair<std::string, uint32_t> getRelativePosition(uint32_t absolutPosition);
-
-	// optionally return names and lengths of chapters in order
-	std::vector<std::pair<std::string, uint32_t>> getChapters(void);
-
-protected:
-
-private:
-	// methods
-	// default constructor for private use only
-	fmIndex();
-
-	// Copy constructor must not be used
-	fmIndex(const fmIndex& object);
-
-	// Assignment operator must not be used
-	const fmIndex& operator=(const fmIndex& rhs);
-
-	// init
-	void init();
-
-	// build index
-	void buildIndex(std::string& str, std::string outputFilename);
-
-	// output file writer
-	void fileWriter(std::string outputFilename);
-
-	// return row index for character of given rank
-	inline
-	uint32_t getRowFromRank(const char chr, const uint32_t rank)
-	{
-		const uint8_t charIndex = m_charIndex[chr];
-		uint32_t index = 1;
-		for (uint32_t i = 0; i < charIndex; i++)
-			index += m_bwtFirst[i];
-		return index + rank;
-	}
-
-	// get count of character up to row
-	inline
-	uint32_t getCount(const char chr, const uint32_t row)
-	{
-		// determine closest checkpoint
-		const uint32_t TallyStepSize = m_settings.m_tallyStepSize;
-		const uint32_t tallyRow = row / TallyStepSize;
-		std::vector<uint32_t> const & col = m_tally[m_charIndex[chr]];
-		uint32_t rank = col[tallyRow];
-		// loop over bwt segment for final count
-		for (uint32_t i = row - row % TallyStepSize + 1; i <= row; ++i)
-		{
-			if (m_bwtLast[i] == chr)
-				rank++;
-		}
-		return rank;
-	}
-
-	// get position from suffix array sample
-	int64_t getPositionFromRow(uint32_t row);
-
-	// process chunk of suffix array
-	void processChunk(std::string const & s, std::vector<uint32_t> const & sfx, const uint32_t offset);
-
-	// init file datatype for tally
-	void initTallyDatatype(std::string alphabet);
-
-	// clear all members
-	void clearDataStructures();
-
-	// member
-	// settings
-	fmIndex_settings m_settings;
-	// write thread activation and flow control
-	bool m_writeActive = false;
-	bool m_writeBlock = false;
-	std::mutex m_writeMutex;
-	std::condition_variable m_writeCondition;
-	// definitions of h5 datatypes
-	std::map<std::string, H5::DataType> m_fileDataTypes;
-	// length of input string
-	uint32_t m_N = 0;
-	// alphabet of input string
-	std::string m_alphabet;
-	// names and offsets of subsequences 
-	std::map<uint32_t, std::string>  m_nameOffset;
-	// index lookup for char in bwt
-	std::vector<uint8_t> m_charIndex;
-	// first column of bwt matrix (elements per character)
-	std::vector<uint32_t> m_bwtFirst;
-	// last column of bwt matrix
-	std::string m_bwtLast;
-	// ranks of characters in last column
-	std::vector<std::vector<uint32_t>> m_tally;
-	// suffix array sample
-	std::vector<indexValuePair> m_suffixArraySample;
-	// complete array for debugging
-	std::vector<uint32_t> m_suffixArray;
-};
-
-
-// -- exported functions - declarations ----------------------------------
-
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class FM-Index
+//
+//  DESCRIPTION   :	FM-Index
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <thread>
+#include <condition_variable>
+#include <H5Cpp.h>
+#include "fmIndex_settings.h"
+#include "occurrenceTable.h"
+#include "packedOccurrenceTable.h"
+#include "packedText.h"
+#include "rankBitvector.h"
+#include "mappedFile.h"
+
+// -- forward declarations -----------------------------------------------
+struct indexValuePair;
+
+// -- exported constants, types, classes ---------------------------------
+typedef struct lcsDefinition
+{
+	uint32_t indexStart = 0;		// offset of match in index
+	uint32_t strStart = 0;			// offset of match in pattern
+	uint32_t lcsLength = 0;			// length of match
+	bool errorFlag = false;
+}lcsDefinition;
+
+
+class fmIndex
+{
+public:
+	// constructor loading index from disk
+	fmIndex(fmIndex_settings& settings, std::string indexFileName);
+
+	// virtual destructor
+	virtual ~fmIndex();
+
+	// allocate memory of input string
+	static void allocateMemory(std::string& str, uint32_t expectedSize);
+
+	// build index
+	static void build(fmIndex_settings& settings, std::string& str, std::string outputFilename);
+
+	// build index using chapters
+	static void build(fmIndex_settings& settings, std::string& str, std::string outputFilename, 
+					  std::map<uint32_t, std::string> chapters);
+
+	// load existing index from disk, native index files are memory mapped
+	void load(std::string indexFile);
+
+	// write loaded index in native format for memory mapping
+	void saveNative(std::string indexFile);
+
+	// return complete index sequence
+	std::string getIndexSequence(void);
+
+	// get substr of index sequence
+	std::string getIndexSequence(uint32_t start, uint32_t length);
+
+	// return vector containing all occurences of pattern in index
+	std::vector<uint32_t> getMatchingPositions(std::string const & pattern);
+
+	// limit matching positions for performance reasons
+	std::vector<uint32_t> getMatchingPositions(std::string const & pattern, const uint32_t maxResults);
+
+	// limit matching positions of all patterns, searches advance in lock-step
+	std::vector<std::vector<uint32_t>> getMatchingPositions(std::vector<std::string> const & patterns, const uint32_t maxResults);
+
+	// return positions of longest common substring of pattern and index
+	std::vector<lcsDefinition> getLongestCommonSubsequence(std::string const & pattern);
+
+	// return name and relative position in chapter
+	std::pair<std::string, uint32_t> getRelativePosition(uint32_t absolutPosition);
+
+	// optionally return names and lengths of chapters in order
+	std::vector<std::pair<std::string, uint32_t>> getChapters(void);
+
+	// names and lengths of chapters read from index file without loading the index
+	static std::vector<std::pair<std::string, uint32_t>> readChapters(std::string indexFile);
+
+	// true if native index was converted from the current hdf5 index
+	static bool isNativeCurrent(std::string nativeFile, std::string sourceFile);
+
+	// return length of indexed sequence
+	uint32_t getLength(void);
+
+protected:
+
+private:
+	// methods
+	// default constructor for private use only
+	fmIndex();
+
+	// Copy constructor must not be used
+	fmIndex(const fmIndex& object);
+
+	// Assignment operator must not be used
+	const fmIndex& operator=(const fmIndex& rhs);
+
+	// init
+	void init();
+
+	// map index in native format
+	void loadNative(std::string indexFile);
+
+	// compute k-mer interval table of loaded index and add it to index file
+	void addKmerIntervals(std::string indexFile);
+
+	// compute intervals of all k-mers over ACGT
+	void buildKmerIntervals(void);
+
+	// add 2-bit packed text to index file
+	void addPackedText(std::string const & str, std::string indexFile);
+
+	// build index
+	void buildIndex(std::string& str, std::string outputFilename);
+
+	// output file writer
+	void fileWriter(std::string outputFilename);
+
+	// return row index for character of given rank
+	inline
+	uint32_t getRowFromRank(const char chr, const uint32_t rank)
+	{
+		return m_firstRow[static_cast<uint8_t>(chr)] + rank;
+	}
+
+	// get count of character up to row
+	inline
+	uint32_t getCount(const char chr, const uint32_t row)
+	{
+		const uint8_t code = m_charIndex[static_cast<uint8_t>(chr)];
+		if (m_settings.m_packedBwt)
+			return m_packedOccurrenceTable.getCount(code, row);
+		return m_occurrenceTable.getCount(code, row);
+	}
+
+	// hint cache lines used by rank queries at row
+	inline
+	void prefetchRow(const uint32_t row)
+	{
+		if (m_settings.m_packedBwt)
+			m_packedOccurrenceTable.prefetch(row);
+		else
+			m_occurrenceTable.prefetch(row);
+	}
+
+	// get character of last column in row, '$' for sentinel
+	inline
+	char getLastColumn(const uint32_t row)
+	{
+		const uint8_t code = m_settings.m_packedBwt ? m_packedOccurrenceTable.getSymbol(row) :
+													  m_occurrenceTable.getSymbol(row);
+		return code < m_alphabet.size() ? m_alphabet[code] : '$';
+	}
+
+	// start backward search with interval of k-mer ending at suffixStart,
+	// suffixStart is moved in front of the k-mer
+	inline
+	bool getKmerInterval(std::string const & pattern, int64_t& suffixStart, uint32_t& rowStart, uint32_t& rowStop)
+	{
+		const int64_t k = m_settings.m_kmerTableLength;
+		if (m_kmerIntervals == NULL || suffixStart + 1 < k)
+			return false;
+		uint32_t code = 0;
+		for (int64_t i = suffixStart + 1 - k; i <= suffixStart; i++)
+		{
+			const uint8_t symbol = m_kmerSymbol[static_cast<uint8_t>(pattern[i])];
+			if (symbol > 3)
+				return false;
+			code = (code << 2) | symbol;
+		}
+		if (m_kmerIntervals[2 * code + 1] <= m_kmerIntervals[2 * code])
+			return false;
+		rowStart = m_kmerIntervals[2 * code];
+		rowStop = m_kmerIntervals[2 * code + 1];
+		suffixStart -= k;
+		return true;
+	}
+
+	// start backward search at suffixStart, with the k-mer table if the
+	// k-mer lies behind first, interval is empty if the character does not occur
+	inline
+	void startBackwardSearch(std::string const & pattern, const int64_t first, int64_t& suffixStart, uint32_t& rowStart, uint32_t& rowStop)
+	{
+		if (suffixStart - first + 1 >= m_settings.m_kmerTableLength && getKmerInterval(pattern, suffixStart, rowStart, rowStop))
+			return;
+		const uint8_t chr = static_cast<uint8_t>(pattern[suffixStart]);
+		if (m_charIndex[chr] >= m_alphabet.size())
+		{
+			rowStart = rowStop = 0;
+			return;
+		}
+		rowStart = getRowFromRank(chr, 0);
+		rowStop = rowStart + m_bwtFirst[m_charIndex[chr]];
+		suffixStart--;
+	}
+
+	// extend matching suffix to the left until a character does not occur
+	// or first is passed, suffixStart is left at the mismatch
+	inline
+	void extendBackwardSearch(std::string const & pattern, const int64_t first, int64_t& suffixStart, uint32_t& rowStart, uint32_t& rowStop)
+	{
+		while (suffixStart >= first && rowStop > rowStart)
+		{
+			const char currentChar = pattern[suffixStart];
+			uint32_t startCount = 0;
+			if (rowStart > 0)
+				startCount = getCount(currentChar, rowStart - 1);
+			uint32_t stopCount = getCount(currentChar, rowStop - 1);
+			if (stopCount > startCount)
+			{
+				rowStart = getRowFromRank(currentChar, startCount);
+				rowStop = getRowFromRank(currentChar, stopCount);
+				suffixStart--;
+			}
+			else
+				break;
+		}
+	}
+
+	// get position from suffix array sample
+	int64_t getPositionFromRow(uint32_t row);
+
+	// process chunk of suffix array
+	void processChunk(std::string const & s, std::vector<uint32_t> const & sfx, const uint32_t offset);
+
+	// init file datatype for tally
+	void initTallyDatatype(std::string alphabet);
+
+	// clear all members
+	void clearDataStructures();
+
+	// member
+	// settings
+	fmIndex_settings m_settings;
+	// write thread activation and flow control
+	bool m_writeActive = false;
+	bool m_writeBlock = false;
+	std::mutex m_writeMutex;
+	std::condition_variable m_writeCondition;
+	// definitions of h5 datatypes
+	std::map<std::string, H5::DataType> m_fileDataTypes;
+	// length of input string
+	uint32_t m_N = 0;
+	// alphabet of input string
+	std::string m_alphabet;
+	// names and offsets of subsequences 
+	std::map<uint32_t, std::string>  m_nameOffset;
+	// index lookup for char in bwt
+	std::vector<uint8_t> m_charIndex;
+	// first column of bwt matrix (elements per character)
+	std::vector<uint32_t> m_bwtFirst;
+	// first row of each character in first column
+	std::vector<uint32_t> m_firstRow;
+	// last column of bwt matrix, only buffered during construction
+	std::string m_bwtLast;
+	// ranks of characters in last column, only buffered during construction
+	std::vector<std::vector<uint32_t>> m_tally;
+	// exception runs of packed last column, only buffered during construction
+	std::vector<bwtExceptionRun> m_bwtExceptions;
+	// ranks and symbols of last column for queries
+	occurrenceTable m_occurrenceTable;
+	packedOccurrenceTable m_packedOccurrenceTable;
+	// suffix array sample, only buffered during construction
+	std::vector<indexValuePair> m_suffixArraySample;
+	// rows of suffix array sample for rank based lookup
+	rankBitvector m_sampledRows;
+	// text positions of sampled rows in row order
+	const uint32_t* m_samplePositions = NULL;
+	uint32_t m_sampleCount = 0;
+	// sampled rows in text position order
+	const uint32_t* m_sampleRows = NULL;
+	uint32_t m_sampleRowCount = 0;
+	// heap storage of sample arrays if not mapped
+	std::vector<uint32_t> m_samplePositionData;
+	std::vector<uint32_t> m_sampleRowData;
+	// first and end row of all k-mers over ACGT in lexicographic order
+	const uint32_t* m_kmerIntervals = NULL;
+	std::vector<uint32_t> m_kmerIntervalData;
+	// symbol code of ACGT in k-mer table, 4 for other characters
+	std::vector<uint8_t> m_kmerSymbol;
+	// optional forward text for sequence lookup
+	packedText m_packedText;
+	// mapped native index file
+	mappedFile m_mappedIndex;
+	// size and modification time of hdf5 index, stored in native index
+	uint64_t m_sourceSize = 0;
+	int64_t m_sourceTime = 0;
+	// complete array for debugging
+	std::vector<uint32_t> m_suffixArray;
+};
+
+
+// -- exported functions - declarations ----------------------------------
+
 // -- exported global variables - declarations (should be empty)----------
\ No newline at end of file
@@ -1,61 +1,83 @@
-// \HEADER\---------------------------------------------------------------
-//
-//  CONTENTS      : Class fmIndex_settings
-//
-//  DESCRIPTION   :	Settings for fmIndex
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-//  All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-#pragma once
-// -- required headers ---------------------------------------------------
-#include <cstdint>
-#include <string>
-#include "settingsBase.h"
-
-// -- forward declarations -----------------------------------------------
-class fmIndex;
-
-// -- exported constants, types, classes ---------------------------------
-class fmIndex_settings : public settingsBase
-{
-friend class fmIndex;	// allow direct access to settings
-public:
-	// default constructor
-	fmIndex_settings();
-
-	// virtual destructor
-	virtual ~fmIndex_settings();
-
-	// setter
-	void set_m_threads(uint32_t value);
-	void set_m_tallyStepSize(uint32_t value);
-	void set_m_saSampleStepSize(uint32_t value);
-	void set_m_MaxSuffixMemoryBlock(uint32_t value);
-
-	// getter
-	uint32_t get_m_threads(void);
-	uint32_t get_m_tallyStepSize(void);
-	uint32_t get_m_saSampleStepSize(void);
-	uint32_t get_m_MaxSuffixMemoryBlock(void);
-
-protected:
-
-private:
-	// methods
-	// default copy constructor and assignment operator work
-
-	// member
-	uint32_t m_threads = 1;							// threads to use in construction phase
-	uint32_t m_tallyStepSize = 128;					// store every 128th sample of tally
-	uint32_t m_saSampleStepSize = 64;				// store every 64th sample of suffix array
-	uint32_t m_MaxSuffixMemoryBlock = 200000000;	// 200 MB for sorting suffixes
-};
-
-// -- exported functions - declarations ----------------------------------
-
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class fmIndex_settings
+//
+//  DESCRIPTION   :	Settings for fmIndex
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <string>
+#include "settingsBase.h"
+
+// -- forward declarations -----------------------------------------------
+class fmIndex;
+
+// -- exported constants, types, classes ---------------------------------
+enum SuffixArrayEngine
+{
+	e_saSort = 0,				// comparison sort in k-mer buckets
+	e_saInducedSort = 1			// linear time SA-IS
+};
+
+
+class fmIndex_settings : public settingsBase
+{
+friend class fmIndex;	// allow direct access to settings
+public:
+	// default constructor
+	fmIndex_settings();
+
+	// virtual destructor
+	virtual ~fmIndex_settings();
+
+	// setter
+	void set_m_threads(uint32_t value);
+	void set_m_tallyStepSize(uint32_t value);
+	void set_m_saSampleStepSize(uint32_t value);
+	void set_m_MaxSuffixMemoryBlock(uint32_t value);
+	void set_m_packedBwt(bool value);
+	void set_m_saEngine(SuffixArrayEngine value);
+	void set_m_nativeIndex(bool value);
+	void set_m_kmerTableLength(uint32_t value);
+	void set_m_packedText(bool value);
+
+	// getter
+	uint32_t get_m_threads(void);
+	uint32_t get_m_tallyStepSize(void);
+	uint32_t get_m_saSampleStepSize(void);
+	uint32_t get_m_MaxSuffixMemoryBlock(void);
+	bool get_m_packedBwt(void);
+	SuffixArrayEngine get_m_saEngine(void);
+	bool get_m_nativeIndex(void);
+	uint32_t get_m_kmerTableLength(void);
+	bool get_m_packedText(void);
+
+protected:
+
+private:
+	// methods
+	// default copy constructor and assignment operator work
+
+	// member
+	uint32_t m_threads = 1;							// threads to use in construction phase
+	uint32_t m_tallyStepSize = 128;					// store every 128th sample of tally
+	uint32_t m_saSampleStepSize = 64;				// store every 64th sample of suffix array
+	uint32_t m_MaxSuffixMemoryBlock = 200000000;	// 200 MB for sorting suffixes
+	bool m_packedBwt = false;						// store last column 2-bit packed
+	SuffixArrayEngine m_saEngine = e_saSort;		// suffix array construction
+	bool m_nativeIndex = false;						// write memory mapped index after build
+	uint32_t m_kmerTableLength = 0;					// k-mer length of interval table, 0 disables
+	bool m_packedText = false;						// store 2-bit packed forward text
+};
+
+// -- exported functions - declarations ----------------------------------
+
 // -- exported global variables - declarations (should be empty)----------
\ No newline at end of file
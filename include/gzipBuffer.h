@@ -0,0 +1,112 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class gzipBuffer
+//
+//  DESCRIPTION   :	Stream buffer decompressing gzip input, blocks of
+//					BGZF input are decompressed in parallel
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : zlib
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <queue>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <streambuf>
+#include <istream>
+#include <zlib.h>
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+class gzipBuffer : public std::streambuf
+{
+public:
+	// constructor, threads used for BGZF input only
+	gzipBuffer(std::istream& source, uint32_t threads);
+
+	// virtual destructor
+	virtual ~gzipBuffer();
+
+	// true if stream starts with gzip magic number, position is not changed
+	static bool isCompressed(std::istream& source);
+
+	// true if input consists of BGZF blocks
+	bool isBlocked(void) const;
+
+protected:
+	// refill get area with decompressed data
+	virtual int_type underflow();
+
+private:
+	// types
+	// consecutive BGZF blocks decompressed by one worker
+	typedef struct bgzfJob
+	{
+		std::vector<char> compressed;
+		std::vector<char> data;
+		bool done = false;
+		bool failed = false;
+	}bgzfJob;
+
+	// methods
+	// default constructor
+	gzipBuffer();
+
+	// Copy constructor must not be used
+	gzipBuffer(const gzipBuffer& object);
+
+	// Assignment operator must not be used
+	const gzipBuffer& operator=(const gzipBuffer& rhs);
+
+	// read from sniffed header bytes first, then from source
+	size_t readSource(char* buffer, size_t size);
+
+	// inflate next chunk of gzip stream
+	bool inflateStream(void);
+
+	// read complete BGZF blocks for next job, NULL at end of input
+	std::shared_ptr<bgzfJob> readBlocks(void);
+
+	// decompress blocks of job, false on corrupt data
+	static bool inflateBlocks(z_stream& stream, bgzfJob& job);
+
+	// worker thread decompressing queued jobs
+	void inflateWorker(void);
+
+	// member
+	std::istream& m_source;
+	std::vector<char> m_header;		// bytes read for format detection
+	size_t m_headerPosition = 0;
+	bool m_blocked = false;
+	bool m_sourceEnd = false;
+	// sequential gzip
+	z_stream m_stream;
+	bool m_streamInit = false;
+	std::vector<char> m_input;
+	std::vector<char> m_output;
+	// parallel BGZF
+	std::deque<std::shared_ptr<bgzfJob>> m_jobs;		// in input order
+	std::queue<std::shared_ptr<bgzfJob>> m_pending;		// waiting for worker
+	std::shared_ptr<bgzfJob> m_current;
+	std::vector<std::thread> m_workers;
+	size_t m_maxJobs = 0;
+	bool m_stop = false;
+	std::mutex m_mutex;
+	std::condition_variable m_jobQueued;
+	std::condition_variable m_jobDone;
+};
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
@@ -0,0 +1,94 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class kmerCounter
+//
+//  DESCRIPTION   :	Counting of k-mers in flat arrays indexed by
+//					integer encoded k-mers
+//
+//  RESTRICTIONS  : alphabet size to the power of k limited by memory
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+// range of consecutive k-mers in lexicographic order
+typedef struct kmerBucket
+{
+	std::string begin;			// first k-mer of bucket
+	std::string end;			// last k-mer of bucket
+	uint32_t length = 0;		// number of k-mers in bucket
+}kmerBucket;
+
+
+// k-mers are encoded as numbers in base of the alphabet size, thus the
+// order of codes equals the lexicographic order of the k-mers
+class kmerCounter
+{
+public:
+	// constructor counting characters of S
+	kmerCounter(std::string const & S, uint32_t threads);
+
+	// virtual destructor
+	virtual ~kmerCounter();
+
+	// get sorted alphabet of S
+	std::string getAlphabet(void);
+
+	// get number of characters for each letter in alphabet
+	std::vector<uint32_t> getAlphabetCount(void);
+
+	// count k-mers of length k, false if table exceeds memory limit
+	bool count(uint32_t k);
+
+	// length of currently counted k-mers
+	uint32_t getKmerLength(void);
+
+	// highest count of a single k-mer
+	uint32_t getMaxCount(void);
+
+	// merge consecutive k-mers into buckets smaller than maxBucketSize
+	std::vector<kmerBucket> getBuckets(uint32_t maxBucketSize);
+
+protected:
+
+private:
+	// methods
+	// Copy constructor must not be used
+	kmerCounter(const kmerCounter& object);
+
+	// Assignment operator must not be used
+	const kmerCounter& operator=(const kmerCounter& rhs);
+
+	// count k-mers starting in range of S into table
+	void countSegment(std::vector<uint32_t>& table, size_t begin, size_t end);
+
+	// add tables of all threads in range of codes to first table
+	void reduceSegment(std::vector<std::vector<uint32_t>>& tables, size_t begin, size_t end);
+
+	// decode k-mer from integer
+	std::string decode(uint64_t code);
+
+	// member
+	std::string const & m_S;
+	uint32_t m_threads = 1;
+	std::string m_alphabet;
+	std::vector<uint8_t> m_charCode;		// digit of character
+	std::vector<uint32_t> m_alphabetCount;	// number of each character
+	uint32_t m_k = 0;						// length of counted k-mers
+	std::vector<uint32_t> m_counts;			// count per k-mer code
+};
+
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
@@ -0,0 +1,64 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class mappedFile
+//
+//  DESCRIPTION   :	Read-only memory mapping of a file
+//
+//  RESTRICTIONS  : POSIX systems
+//
+//  REQUIRES      : mmap
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstddef>
+#include <string>
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+class mappedFile
+{
+public:
+	// default constructor
+	mappedFile();
+
+	// virtual destructor, unmaps file
+	virtual ~mappedFile();
+
+	// map complete file read-only, throws if not possible
+	void open(std::string filePath);
+
+	// unmap file
+	void close(void);
+
+	// true if file is mapped
+	bool isOpen(void) const;
+
+	// begin of mapped memory
+	const char* data(void) const;
+
+	// size of mapped file in Byte
+	size_t size(void) const;
+
+protected:
+
+private:
+	// methods
+	// Copy constructor must not be used
+	mappedFile(const mappedFile& object);
+
+	// Assignment operator must not be used
+	const mappedFile& operator=(const mappedFile& rhs);
+
+	// member
+	const char* m_data = NULL;
+	size_t m_size = 0;
+};
+
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
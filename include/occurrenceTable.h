@@ -0,0 +1,134 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class occurrenceTable
+//
+//  DESCRIPTION   :	Cache line interleaved occurrence counts of the
+//					last bwt column
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : popcnt instruction
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <nmmintrin.h>
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+// Each block starts on a cache line and holds the counts of all symbols
+// before the block followed by the bit-sliced symbols it covers. Rank
+// queries touch a single block and are answered with popcount.
+class occurrenceTable
+{
+public:
+	// default constructor
+	occurrenceTable();
+
+	// virtual destructor
+	virtual ~occurrenceTable();
+
+	// build from last column, charIndex maps characters to symbol codes
+	void build(std::string const & bwtLast, std::vector<uint8_t> const & charIndex, const uint8_t alphabetSize);
+
+	// use blocks in external memory, e.g. a mapped index file
+	void attach(const uint64_t* data, const size_t words, const uint32_t N, const uint8_t alphabetSize);
+
+	// release all memory
+	void clear(void);
+
+	// begin of blocks
+	const uint64_t* data(void) const;
+
+	// number of 64 bit words of all blocks
+	size_t words(void) const;
+
+	// number of rows in table
+	uint32_t size(void) const;
+
+	// symbols covered by a single block
+	uint32_t symbolsPerBlock(void) const;
+
+	// get count of symbol code up to and including row
+	inline
+	uint32_t getCount(const uint8_t code, const uint32_t row) const
+	{
+		if (code >= m_alphabetSize)
+			return 0;
+		const uint64_t* block = m_data + static_cast<size_t>(row >> m_blockShift) * m_blockWords;
+		uint32_t count = reinterpret_cast<const uint32_t*>(block)[code];
+		const uint32_t offset = row & m_blockMask;
+		const uint64_t* group = block + m_countWords;
+		for (uint32_t i = 0; i < (offset >> 6); ++i, group += m_planes)
+			count += static_cast<uint32_t>(_mm_popcnt_u64(matchMask(group, code)));
+		count += static_cast<uint32_t>(_mm_popcnt_u64(matchMask(group, code) & (~0ULL >> (63 - (offset & 63)))));
+		return count;
+	}
+
+	// hint cache lines of block counts and symbol group of row
+	inline
+	void prefetch(const uint32_t row) const
+	{
+		const uint64_t* block = m_data + static_cast<size_t>(row >> m_blockShift) * m_blockWords;
+		_mm_prefetch(reinterpret_cast<const char*>(block), _MM_HINT_T0);
+		_mm_prefetch(reinterpret_cast<const char*>(block + m_countWords + ((row & m_blockMask) >> 6) * m_planes), _MM_HINT_T0);
+	}
+
+	// get symbol code at row, sentinel is returned as alphabet size
+	inline
+	uint8_t getSymbol(const uint32_t row) const
+	{
+		const uint64_t* group = m_data + static_cast<size_t>(row >> m_blockShift) * m_blockWords +
+								m_countWords + ((row & m_blockMask) >> 6) * m_planes;
+		const uint32_t bit = row & 63;
+		uint8_t code = 0;
+		for (uint32_t i = 0; i < m_planes; ++i)
+			code |= static_cast<uint8_t>(((group[i] >> bit) & 1) << i);
+		return code;
+	}
+
+protected:
+
+private:
+	// methods
+	// Copy constructor must not be used
+	occurrenceTable(const occurrenceTable& object);
+
+	// Assignment operator must not be used
+	const occurrenceTable& operator=(const occurrenceTable& rhs);
+
+	// compute block layout, return number of blocks
+	size_t initLayout(const uint32_t N, const uint8_t alphabetSize);
+
+	// mask of positions in 64 symbol group matching code
+	inline
+	uint64_t matchMask(const uint64_t* planes, const uint8_t code) const
+	{
+		uint64_t mask = ~0ULL;
+		for (uint32_t i = 0; i < m_planes; ++i)
+			mask &= ~(planes[i] ^ (0ULL - ((code >> i) & 1)));
+		return mask;
+	}
+
+	// member
+	uint32_t m_N = 0;					// number of rows
+	uint8_t m_alphabetSize = 0;			// number of counted symbols
+	uint32_t m_planes = 0;				// bits per symbol code
+	uint32_t m_countWords = 0;			// 64 bit words of counts per block
+	uint32_t m_blockWords = 0;			// 64 bit words per block
+	uint32_t m_blockShift = 0;			// log2 of symbols per block
+	uint32_t m_blockMask = 0;			// symbols per block - 1
+	const uint64_t* m_data = NULL;		// cache line aligned begin of blocks
+	std::vector<uint64_t> m_storage;
+};
+
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
@@ -0,0 +1,176 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class packedOccurrenceTable
+//
+//  DESCRIPTION   :	Occurrence counts of 2-bit packed last bwt column
+//					with exception runs for sentinel and ambiguous bases
+//
+//  RESTRICTIONS  : less than 2^31 occurrences per base
+//
+//  REQUIRES      : popcnt instruction
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <nmmintrin.h>
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+// run of last column rows holding a character other than A, C, G or T
+typedef struct bwtExceptionRun
+{
+	uint32_t row = 0;				// first row of run
+	uint32_t length = 0;			// number of rows in run
+	char chr = '$';					// character of run
+}bwtExceptionRun;
+
+
+// Each 64 byte block holds the counts of A, C, G and T before the block
+// and 192 packed symbols. Exception rows are packed as A and flagged in
+// the highest bit of the A count of their block.
+class packedOccurrenceTable
+{
+public:
+	// default constructor
+	packedOccurrenceTable();
+
+	// virtual destructor
+	virtual ~packedOccurrenceTable();
+
+	// pack symbols of last column, extend exception runs starting at row
+	static void pack(std::string const & bwt, const size_t symbols, const uint32_t row,
+					 std::vector<uint8_t>& packed, std::vector<bwtExceptionRun>& exceptions);
+
+	// build from packed last column, codes are positions in sorted alphabet
+	void build(std::vector<uint8_t> const & packed, const uint32_t N,
+			   std::vector<bwtExceptionRun> const & exceptions, std::string const & alphabet);
+
+	// use blocks in external memory, e.g. a mapped index file
+	void attach(const uint64_t* data, const size_t words, const uint32_t N,
+				std::vector<bwtExceptionRun> const & exceptions, std::string const & alphabet);
+
+	// release all memory
+	void clear(void);
+
+	// begin of blocks
+	const uint64_t* data(void) const;
+
+	// number of 64 bit words of all blocks
+	size_t words(void) const;
+
+	// exception runs with characters
+	std::vector<bwtExceptionRun> getExceptions(void) const;
+
+	// number of rows in table
+	uint32_t size(void) const;
+
+	// number of exception runs
+	size_t exceptionRuns(void) const;
+
+	// get count of symbol code up to and including row
+	inline
+	uint32_t getCount(const uint8_t code, const uint32_t row) const
+	{
+		const uint8_t packedCode = m_packedCode[code];
+		if (packedCode > 3)
+			return getExceptionCount(code, row);
+		const uint64_t* block = m_data + static_cast<size_t>(row / BlockSymbols) * BlockWords;
+		const uint32_t blockCount = reinterpret_cast<const uint32_t*>(block)[packedCode];
+		uint32_t count = blockCount & CountMask;
+		const uint32_t offset = row % BlockSymbols;
+		const uint64_t* word = block + CountWords;
+		for (uint32_t i = 0; i < (offset >> 5); ++i, ++word)
+			count += static_cast<uint32_t>(_mm_popcnt_u64(matchMask(*word, packedCode)));
+		count += static_cast<uint32_t>(_mm_popcnt_u64(matchMask(*word, packedCode) & (~0ULL >> (62 - 2 * (offset & 31)))));
+		if (blockCount & ExceptionFlag)
+			count -= getExceptionOverlap(row - offset, row);
+		return count;
+	}
+
+	// hint cache line of block holding row
+	inline
+	void prefetch(const uint32_t row) const
+	{
+		_mm_prefetch(reinterpret_cast<const char*>(m_data + static_cast<size_t>(row / BlockSymbols) * BlockWords), _MM_HINT_T0);
+	}
+
+	// get symbol code at row, sentinel is returned as alphabet size
+	inline
+	uint8_t getSymbol(const uint32_t row) const
+	{
+		const uint64_t* block = m_data + static_cast<size_t>(row / BlockSymbols) * BlockWords;
+		const uint32_t offset = row % BlockSymbols;
+		const uint8_t packedCode = (block[CountWords + (offset >> 5)] >> (2 * (offset & 31))) & 3;
+		if (packedCode == 0 && (reinterpret_cast<const uint32_t*>(block)[0] & ExceptionFlag))
+			return getExceptionSymbol(row);
+		return m_symbolCode[packedCode];
+	}
+
+protected:
+
+private:
+	// types
+	// exception run with symbol code and count of code before the run
+	typedef struct exceptionRun
+	{
+		uint32_t row;
+		uint32_t length;
+		uint32_t rank;
+		uint8_t code;
+	}exceptionRun;
+
+	// methods
+	// Copy constructor must not be used
+	packedOccurrenceTable(const packedOccurrenceTable& object);
+
+	// Assignment operator must not be used
+	const packedOccurrenceTable& operator=(const packedOccurrenceTable& rhs);
+
+	// mask with lower bit of each 2-bit symbol set if matching code
+	inline
+	uint64_t matchMask(const uint64_t word, const uint8_t packedCode) const
+	{
+		const uint64_t diff = word ^ (packedCode * 0x5555555555555555ULL);
+		return ~(diff | (diff >> 1)) & 0x5555555555555555ULL;
+	}
+
+	// init symbol codes and exception runs
+	void initExceptions(const uint32_t N, std::vector<bwtExceptionRun> const & exceptions, std::string const & alphabet);
+
+	// count of exception symbol up to and including row
+	uint32_t getExceptionCount(const uint8_t code, const uint32_t row) const;
+
+	// number of exception rows in range [first, last]
+	uint32_t getExceptionOverlap(const uint32_t first, const uint32_t last) const;
+
+	// symbol code of exception row, A if row is no exception
+	uint8_t getExceptionSymbol(const uint32_t row) const;
+
+	// constants
+	static const uint32_t BlockWords = 8;				// one cache line
+	static const uint32_t CountWords = 2;				// four uint32 counts
+	static const uint32_t BlockSymbols = 192;			// 6 words of 32 symbols
+	static const uint32_t ExceptionFlag = 0x80000000;	// block contains exceptions
+	static const uint32_t CountMask = 0x7FFFFFFF;
+
+	// member
+	uint32_t m_N = 0;								// number of rows
+	std::string m_alphabet;							// characters of symbol codes
+	std::vector<uint8_t> m_packedCode;				// symbol code to 2-bit code, 4 if exception
+	std::vector<uint8_t> m_symbolCode;				// 2-bit code to symbol code
+	std::vector<exceptionRun> m_exceptions;			// all runs sorted by row
+	std::vector<std::vector<exceptionRun>> m_symbolExceptions;	// runs per symbol code
+	const uint64_t* m_data = NULL;					// cache line aligned begin of blocks
+	std::vector<uint64_t> m_storage;
+};
+
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
@@ -0,0 +1,83 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class packedText
+//
+//  DESCRIPTION   :	2-bit packed forward text of the index with exception
+//					runs for sentinel and ambiguous bases
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "packedOccurrenceTable.h"
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+// Text positions are packed four per byte in the layout of the packed last
+// column, exception runs use the position as row.
+class packedText
+{
+public:
+	// default constructor
+	packedText();
+
+	// virtual destructor
+	virtual ~packedText();
+
+	// build from packed text
+	void build(std::vector<uint8_t> const & packed, const uint32_t N, std::vector<bwtExceptionRun> const & exceptions);
+
+	// use packed text in external memory, e.g. a mapped index file
+	void attach(const uint8_t* data, const size_t bytes, const uint32_t N, std::vector<bwtExceptionRun> const & exceptions);
+
+	// release all memory
+	void clear(void);
+
+	// begin of packed text
+	const uint8_t* data(void) const;
+
+	// number of bytes of packed text
+	size_t bytes(void) const;
+
+	// exception runs with characters
+	std::vector<bwtExceptionRun> const & getExceptions(void) const;
+
+	// number of text positions, 0 if no text is loaded
+	uint32_t size(void) const;
+
+	// substring of text, O(length) plus binary search in exception runs
+	std::string getSequence(const uint32_t start, const uint32_t length) const;
+
+protected:
+
+private:
+	// methods
+	// Copy constructor must not be used
+	packedText(const packedText& object);
+
+	// Assignment operator must not be used
+	const packedText& operator=(const packedText& rhs);
+
+	// check and store exception runs
+	void initExceptions(const uint32_t N, std::vector<bwtExceptionRun> const & exceptions);
+
+	// member
+	uint32_t m_N = 0;								// number of text positions
+	std::vector<bwtExceptionRun> m_exceptions;		// runs sorted by position
+	const uint8_t* m_data = NULL;					// begin of packed text
+	std::vector<uint8_t> m_storage;
+};
+
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
@@ -1,62 +1,149 @@
-// \HEADER\---------------------------------------------------------------
-//
-//  CONTENTS      : Class positionFilter
-//
-//  DESCRIPTION   :	Decide if estimated position of read matches filter
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-//  All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-#pragma once
-// -- required headers ---------------------------------------------------
-#include <cstdint>
-#include <istream>
-#include <string>
-#include <vector>
-#include <map>
-
-// -- forward declarations -----------------------------------------------
-struct selector;
-
-// -- exported constants, types, classes ---------------------------------
-class positionFilter
-{
-public:
-	// constructor
-	positionFilter();
-
-	// virtual destructor
-	virtual ~positionFilter();
-
-	// load selectors from stream of csv lines (ref;start[;stop])
-	uint32_t addSelectors(std::string path2csv);
-	uint32_t addSelectors(std::istream& selectorLines);
-
-	// clear all selector definitions
-	void clearSelectors(void);
-	
-	// get number of active selectors
-	uint32_t getActiveSelectorCount(void);
-
-	// check if position matches filter
-	// return list of match descriptions
-	std::vector<std::string> match(std::string ref, uint32_t pos);
-
-	// check if position overlaps filter taking length into account
-	// return list of match descriptions
-	std::vector<std::string> match(std::string ref, uint32_t pos, uint32_t length);
-
-protected:
-
-private:
-	// methods
-
-	// member
-	// selectors as [reference] [vector <  selector > ]
-	std::map<std::string, std::vector<selector>> m_selectors;
-};
-
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class positionFilter
+//
+//  DESCRIPTION   :	Decide if estimated position of read matches filter
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : mmap
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "mappedFile.h"
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+// Selectors of all references are kept in one array sorted by reference and
+// start. The selectors of each reference form an implicit interval tree with
+// the largest stop of each subtree stored in its root, overlap queries take
+// O(log n + k) without copies. A compiled selector index holds the sorted
+// array and is memory mapped instead of parsed.
+class positionFilter
+{
+public:
+	// constructor
+	positionFilter();
+
+	// virtual destructor
+	virtual ~positionFilter();
+
+	// load selectors from compiled selector index, BED (.bed), GTF/GFF (.gtf, .gff, .gff3)
+	// or csv lines (ref;start[;stop]), GTF/GFF features of given type only if not empty
+	uint32_t addSelectors(std::string path2csv);
+	uint32_t addSelectors(std::string path, std::string feature);
+
+	// load selectors from stream of csv lines (ref;start[;stop])
+	uint32_t addSelectors(std::istream& selectorLines);
+
+	// load BED regions, name column or region as description
+	uint32_t addBed(std::istream& bedLines);
+
+	// load GTF or GFF features, gene name or id as description, all features if empty
+	uint32_t addGtf(std::istream& gtfLines, std::string const & feature);
+
+	// rename references to chapters of index, e.g. 1 to chr1 and MT to chrM,
+	// return number of selectors on references not found in chapters
+	uint32_t resolveReferences(std::vector<std::pair<std::string, uint32_t>> const & chapters);
+
+	// write compiled selector index
+	void saveIndex(std::string path) const;
+
+	// true if file is a compiled selector index
+	static bool isIndex(std::string path);
+
+	// clear all selector definitions
+	void clearSelectors(void);
+	
+	// get number of active selectors
+	uint32_t getActiveSelectorCount(void) const;
+
+	// id of reference name, -1 if no selector is defined on reference
+	int32_t getReferenceId(std::string const & ref) const;
+
+	// description of selector returned by match
+	std::string getDescription(uint32_t selector) const;
+
+	// check if position matches filter
+	// return list of match descriptions
+	std::vector<std::string> match(std::string ref, uint32_t pos) const;
+
+	// check if position overlaps filter taking length into account
+	// return list of match descriptions
+	std::vector<std::string> match(std::string ref, uint32_t pos, uint32_t length) const;
+
+	// replace selectors by those overlapping [pos, pos + length] on reference id
+	void match(int32_t referenceId, uint32_t pos, uint32_t length, std::vector<uint32_t>& selectors) const;
+
+protected:
+
+private:
+	// types
+	typedef struct selectorInterval
+	{
+		uint32_t start = 0;
+		uint32_t stop = 0xFFFFFFFF;		// inclusive
+		uint32_t maxStop = 0;			// largest stop in subtree
+		uint32_t selector = 0;			// index of description
+		uint32_t referenceId = 0;
+	}selectorInterval;
+
+	typedef struct referenceRange
+	{
+		uint32_t offset = 0;			// first interval of reference
+		uint32_t count = 0;
+		int32_t maxLevel = -1;			// level of tree root
+	}referenceRange;
+
+	// methods
+	// Copy constructor must not be used
+	positionFilter(const positionFilter& object);
+
+	// Assignment operator must not be used
+	const positionFilter& operator=(const positionFilter& rhs);
+
+	// map compiled selector index, merged if selectors exist
+	uint32_t loadIndex(std::string path);
+
+	// copy mapped intervals to memory before selectors are added
+	void detachIndex(void);
+
+	// add selector on reference, stop inclusive
+	void addInterval(std::string const & ref, uint32_t start, uint32_t stop, std::string const & description);
+
+	// sort intervals and build interval trees of all references
+	void buildIndex(void);
+
+	// id of reference name, added if not existing
+	uint32_t internReference(std::string const & ref);
+
+	// member
+	std::unordered_map<std::string, uint32_t> m_referenceIds;
+	std::vector<std::string> m_referenceNames;		// by reference id
+	std::vector<referenceRange> m_references;		// by reference id
+	std::unordered_map<std::string, uint32_t> m_selectorIds;	// by description
+	// sorted intervals and descriptions, in storage below or in mapped index
+	const selectorInterval* m_intervalData = NULL;
+	size_t m_intervalCount = 0;
+	const uint32_t* m_descriptionOffsets = NULL;	// selector count + 1 offsets
+	const char* m_descriptionText = NULL;
+	size_t m_selectorCount = 0;
+	std::vector<selectorInterval> m_intervals;
+	std::vector<uint32_t> m_descriptionOffsetStorage;
+	std::string m_descriptionTextStorage;
+	mappedFile m_mappedIndex;
+};
+
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
@@ -1,64 +1,125 @@
-// \HEADER\---------------------------------------------------------------
-//
-//  CONTENTS      : Class pseudoAligner
-//
-//  DESCRIPTION   :	Estimated position of sequence based on kmer matches
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-//  All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-#pragma once
-// -- required headers ---------------------------------------------------
-#include <string>
-#include "pseudoAligner_settings.h"
-#include "fileSAM.h"
-#include "fmIndex.h"
-
-// -- forward declarations -----------------------------------------------
-struct seedType;
-
-// -- exported constants, types, classes ---------------------------------
-class pseudoAligner
-{
-public:
-	// constructor
-	pseudoAligner(pseudoAligner_settings& settings, fmIndex& index);
-
-	// virtual destructor
-	virtual ~pseudoAligner();
-
-	// get most likely position of flawed string
-	samRecord estimatePosition(const std::string str);
-
-	// get alignment at distributed seeds
-	samRecord seedAlign(const std::string str);
-
-protected:
-
-private:
-	// methods
-	// default constructor must not be used
-	pseudoAligner();
-
-	// Copy constructor must not be used
-	pseudoAligner(const pseudoAligner& object);
-
-	// Assignment operator must not be used
-	const pseudoAligner& operator=(const pseudoAligner& rhs);
-
-	// get positions for seeds
-	std::vector<seedType> getSeedPositions(std::vector<std::string>& seeds, uint32_t seedDistance);
-
-	// member
-	pseudoAligner_settings m_settings;
-	fmIndex& m_index;
-};
-
-
-// -- exported functions - declarations ----------------------------------
-
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class pseudoAligner
+//
+//  DESCRIPTION   :	Estimated position of sequence based on kmer matches
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include "pseudoAligner_settings.h"
+#include "fileSAM.h"
+#include "fmIndex.h"
+#include "ISeedEngine.h"
+#include "seedChain.h"
+
+// -- forward declarations -----------------------------------------------
+class alignmentSession;
+
+// -- exported constants, types, classes ---------------------------------
+class pseudoAligner
+{
+friend class alignmentSession;	// session shares index queries and strand decision
+public:
+	// constructor
+	pseudoAligner(pseudoAligner_settings& settings, fmIndex& index);
+
+	// virtual destructor
+	virtual ~pseudoAligner();
+
+	// get most likely position of flawed string
+	samRecord estimatePosition(const std::string str);
+
+	// get alignment at distributed seeds
+	samRecord seedAlign(const std::string str);
+
+protected:
+
+private:
+	// methods
+	// default constructor must not be used
+	pseudoAligner();
+
+	// Copy constructor must not be used
+	pseudoAligner(const pseudoAligner& object);
+
+	// Assignment operator must not be used
+	const pseudoAligner& operator=(const pseudoAligner& rhs);
+
+	// get positions for seeds at given rows of read
+	std::vector<seedType> getSeedPositions(std::vector<std::string>& seeds, std::vector<uint32_t> const & rows);
+
+	// start of best chain on strand with higher chain score
+	samRecord strandEstimate(std::vector<seedChain> const & fwdChains, std::vector<seedChain> const & bwdChains);
+
+	// member
+	pseudoAligner_settings m_settings;
+	fmIndex& m_index;
+	uint32_t m_minHitLength;		// lcs length unlikely to occur by chance
+	std::unique_ptr<ISeedEngine> m_seedEngine;
+};
+
+
+
+// incremental position estimate of a read received in chunks, lcs windows
+// are queried once as soon as they are complete
+class alignmentSession
+{
+public:
+	// constructor, decision is final once mapping quality reaches threshold
+	alignmentSession(pseudoAligner& aligner, uint32_t qualityThreshold);
+
+	// virtual destructor
+	virtual ~alignmentSession();
+
+	// add next chunk of sequence, true if decision is available
+	bool append(std::string const & chunk);
+
+	// true if quality threshold is reached or scan prefix is consumed
+	bool decided(void) const;
+
+	// current estimate, unmapped while no matches are found
+	samRecord result(void) const;
+
+	// number of bases received
+	size_t size(void) const;
+
+protected:
+
+private:
+	// methods
+	// default constructor must not be used
+	alignmentSession();
+
+	// Copy constructor must not be used
+	alignmentSession(const alignmentSession& object);
+
+	// Assignment operator must not be used
+	const alignmentSession& operator=(const alignmentSession& rhs);
+
+	// member
+	pseudoAligner& m_aligner;
+	uint32_t m_qualityThreshold;
+	std::string m_sequence;			// received bases within scan prefix
+	size_t m_size = 0;
+	size_t m_windowStart = 0;		// first window not queried yet
+	std::vector<seedType> m_forwardMatches;
+	std::vector<seedType> m_reverseMatches;
+	samRecord m_result;
+	bool m_decided = false;
+};
+
+
+// -- exported functions - declarations ----------------------------------
+
 // -- exported global variables - declarations (should be empty)----------
\ No newline at end of file
@@ -1,56 +1,78 @@
-// \HEADER\---------------------------------------------------------------
-//
-//  CONTENTS      : Class pseudoAligner_settings
-//
-//  DESCRIPTION   :	Settings for pseudo aligner
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-//  All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-#pragma once
-// -- required headers ---------------------------------------------------
-#include <cstdint>
-#include <string>
-#include "settingsBase.h"
-
-// -- forward declarations -----------------------------------------------
-class pseudoAligner;
-
-// -- exported constants, types, classes ---------------------------------
-class pseudoAligner_settings : public settingsBase
-{
-friend class pseudoAligner;	// allow direct access to settings
-public:
-	// constructor
-	pseudoAligner_settings();
-
-	// virtual destructor
-	virtual ~pseudoAligner_settings();
-
-	// setter
-	void set_m_scanPrefix(uint32_t value);
-	void set_m_seedLength(uint32_t value);
-
-	// getter
-	uint32_t get_m_scanPrefix(void);
-	uint32_t get_m_seedLength(void);
-
-protected:
-
-private:
-	// methods
-	// default copy constructor and assignment operator work
-
-	// member
-	uint32_t m_scanPrefix = 1000;		// prefix of sequence to use for alignment
-	uint32_t m_seedLength = 15;			// length of seeds for distributed alignment
-	uint32_t m_seedDistance = 100;		// distance of seeds in read sequence
-};
-
-// -- exported functions - declarations ----------------------------------
-
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class pseudoAligner_settings
+//
+//  DESCRIPTION   :	Settings for pseudo aligner
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <string>
+#include "settingsBase.h"
+
+// -- forward declarations -----------------------------------------------
+class pseudoAligner;
+
+// -- exported constants, types, classes ---------------------------------
+enum SeedEngine
+{
+	e_seedDistance = 0,			// seeds at fixed distance
+	e_seedMinimizer = 1			// (w,k)-minimizers
+};
+
+
+class pseudoAligner_settings : public settingsBase
+{
+friend class pseudoAligner;	// allow direct access to settings
+public:
+	// constructor
+	pseudoAligner_settings();
+
+	// virtual destructor
+	virtual ~pseudoAligner_settings();
+
+	// setter
+	void set_m_scanPrefix(uint32_t value);
+	void set_m_seedLength(uint32_t value);
+	void set_m_earlyStopQuality(uint32_t value);
+	void set_m_seedEngine(SeedEngine value);
+	void set_m_minimizerWindow(uint32_t value);
+	void set_m_maxChainGap(uint32_t value);
+	void set_m_refineAlignment(bool value);
+
+	// getter
+	uint32_t get_m_scanPrefix(void);
+	uint32_t get_m_seedLength(void);
+	uint32_t get_m_earlyStopQuality(void);
+	SeedEngine get_m_seedEngine(void);
+	uint32_t get_m_minimizerWindow(void);
+	uint32_t get_m_maxChainGap(void);
+	bool get_m_refineAlignment(void);
+
+protected:
+
+private:
+	// methods
+	// default copy constructor and assignment operator work
+
+	// member
+	uint32_t m_scanPrefix = 1000;		// prefix of sequence to use for alignment
+	uint32_t m_seedLength = 15;			// length of seeds for distributed alignment
+	uint32_t m_seedDistance = 100;		// distance of seeds in read sequence
+	SeedEngine m_seedEngine = e_seedDistance;	// selection of seeds in read
+	uint32_t m_minimizerWindow = 100;	// consecutive k-mers per minimizer
+	uint32_t m_maxChainGap = 5000;		// largest gap between chained seeds
+	bool m_refineAlignment = false;		// banded alignment between seeds
+	uint32_t m_earlyStopQuality = 0;	// stop scan at this mapping quality, 0 scans whole prefix
+};
+
+// -- exported functions - declarations ----------------------------------
+
 // -- exported global variables - declarations (should be empty)----------
\ No newline at end of file
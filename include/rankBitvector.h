@@ -0,0 +1,97 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class rankBitvector
+//
+//  DESCRIPTION   :	Bitvector with constant time rank queries
+//
+//  RESTRICTIONS  : less than 2^32 bits
+//
+//  REQUIRES      : popcnt instruction
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <vector>
+#include <nmmintrin.h>
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+// Each 64 byte block holds the number of set bits before the block
+// followed by 448 bits, a rank query touches a single cache line.
+class rankBitvector
+{
+public:
+	// default constructor
+	rankBitvector();
+
+	// virtual destructor
+	virtual ~rankBitvector();
+
+	// build from sorted positions of set bits
+	void build(std::vector<uint32_t> const & positions, const uint32_t N);
+
+	// use blocks in external memory, e.g. a mapped index file
+	void attach(const uint64_t* data, const size_t words, const uint32_t N);
+
+	// release all memory
+	void clear(void);
+
+	// begin of blocks
+	const uint64_t* data(void) const;
+
+	// number of 64 bit words of all blocks
+	size_t words(void) const;
+
+	// number of bits
+	uint32_t size(void) const;
+
+	// test bit and return number of set bits before position
+	inline
+	bool getRank(const uint32_t position, uint32_t& rank) const
+	{
+		const uint64_t* block = m_data + static_cast<size_t>(position / BlockBits) * BlockWords;
+		const uint32_t offset = position % BlockBits;
+		const uint64_t* word = block + 1;
+		uint32_t count = static_cast<uint32_t>(block[0]);
+		for (uint32_t i = 0; i < (offset >> 6); ++i, ++word)
+			count += static_cast<uint32_t>(_mm_popcnt_u64(*word));
+		const uint32_t bit = offset & 63;
+		rank = count + static_cast<uint32_t>(_mm_popcnt_u64(*word & ((1ULL << bit) - 1)));
+		return (*word >> bit) & 1;
+	}
+
+	// hint cache line of block holding position
+	inline
+	void prefetch(const uint32_t position) const
+	{
+		_mm_prefetch(reinterpret_cast<const char*>(m_data + static_cast<size_t>(position / BlockBits) * BlockWords), _MM_HINT_T0);
+	}
+
+protected:
+
+private:
+	// methods
+	// Copy constructor must not be used
+	rankBitvector(const rankBitvector& object);
+
+	// Assignment operator must not be used
+	const rankBitvector& operator=(const rankBitvector& rhs);
+
+	// constants
+	static const uint32_t BlockWords = 8;		// one cache line
+	static const uint32_t BlockBits = 448;		// 7 words of bits after count
+
+	// member
+	uint32_t m_N = 0;							// number of bits
+	const uint64_t* m_data = NULL;				// cache line aligned begin of blocks
+	std::vector<uint64_t> m_storage;
+};
+
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
@@ -0,0 +1,43 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : co-linear chaining of seeds
+//
+//  DESCRIPTION   :	Chains of seeds increasing in read and reference
+//					position by max-gap bounded dynamic programming
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <vector>
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+struct seedType
+{
+	uint32_t row = 0;				// offset in read
+	uint32_t col = 0;				// offset in reference
+	uint32_t length = 0;			// length of exact match
+};
+
+typedef struct seedChain
+{
+	std::vector<seedType> seeds;	// increasing in read and reference
+	double score = 0;				// matched bases minus gap cost
+}seedChain;
+
+// -- exported functions - declarations ----------------------------------
+// best chain and alternative chains not sharing seeds, decreasing score
+std::vector<seedChain> chainSeeds(std::vector<seedType> const & seeds, uint32_t maxGap, size_t maxChains);
+
+// mapping quality of best chain given the best alternative score
+uint32_t chainMappingQuality(seedChain const & best, double alternativeScore);
+
+// -- exported global variables - declarations (should be empty)----------
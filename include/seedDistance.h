@@ -0,0 +1,53 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class seedDistance
+//
+//  DESCRIPTION   :	Seeds of fixed length at fixed distance in read
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ISeedEngine.h"
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+class seedDistance : public ISeedEngine
+{
+public:
+	// constructor
+	seedDistance(uint32_t seedLength, uint32_t seedDistance);
+
+	// virtual destructor
+	virtual ~seedDistance();
+
+	// seeds of read in order of offset, homopolymers are skipped
+	std::vector<readSeed> getSeeds(std::string const & sequence);
+
+protected:
+
+private:
+	// methods
+	// Copy constructor must not be used
+	seedDistance(const seedDistance& object);
+
+	// Assignment operator must not be used
+	const seedDistance& operator=(const seedDistance& rhs);
+
+	// member
+	uint32_t m_seedLength;
+	uint32_t m_seedDistance;
+};
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
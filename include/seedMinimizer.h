@@ -0,0 +1,57 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class seedMinimizer
+//
+//  DESCRIPTION   :	(w,k)-minimizers of read as seeds, k-mer of smallest
+//					hash in each window of w consecutive k-mers
+//
+//  RESTRICTIONS  : k <= 32, k-mers containing other bases than ACGT are
+//					skipped
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ISeedEngine.h"
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+class seedMinimizer : public ISeedEngine
+{
+public:
+	// constructor
+	seedMinimizer(uint32_t k, uint32_t w);
+
+	// virtual destructor
+	virtual ~seedMinimizer();
+
+	// seeds of read in order of offset, homopolymers are skipped
+	std::vector<readSeed> getSeeds(std::string const & sequence);
+
+protected:
+
+private:
+	// methods
+	// Copy constructor must not be used
+	seedMinimizer(const seedMinimizer& object);
+
+	// Assignment operator must not be used
+	const seedMinimizer& operator=(const seedMinimizer& rhs);
+
+	// member
+	uint32_t m_k;
+	uint32_t m_w;
+	uint64_t m_mask;				// 2 bits per base of k-mer
+	uint8_t m_baseCode[256];		// 2 bit code of ACGT, 4 otherwise
+};
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
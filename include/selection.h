@@ -1,78 +1,105 @@
-// \HEADER\---------------------------------------------------------------
-//
-//  CONTENTS      : Class selectION
-//
-//  DESCRIPTION   :	Use pseudo-alignment to filter reads from fastq files
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-//  All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-#pragma once
-// -- required headers ---------------------------------------------------
-#include <string>
-#include <mutex>
-#include "selection_settings.h"
-#include "fmIndex.h"
-#include "pseudoAligner.h"
-#include "fileSAM.h"
-#include "ISequenceFile.h"
-#include "positionFilter.h"
-
-// -- forward declarations -----------------------------------------------
-
-// -- exported constants, types, classes ---------------------------------
-class selectION
-{
-public:
-	// construct using existing index on disk
-	selectION(selection_settings& settings, std::string dbPrefix);
-
-	// virtual destructor
-	virtual ~selectION();
-
-	// build from fasta or fastq
-	static void buildFromFastx(selection_settings& settings, std::string fileName);
-	static void buildFromFastx(selection_settings& settings, std::string fileName, std::string dbPrefix);
-
-	// scan sequence file for matches, output to one file per selector
-	void select(ISequenceFile& seqFile, positionFilter& filter, std::string outputPath);
-
-protected:
-
-private:
-	// methods
-	// default constructor
-	selectION();
-
-	// Copy constructor must not be used
-	selectION(const selectION& object);
-
-	// Assignment operator must not be used
-	const selectION& operator=(const selectION& rhs);
-
-	// worker function reading records from disk, aligning and writing back
-	void selectionWorker(ISequenceFile& seqs, positionFilter& filter);
-
-	// worker function writing selected records to disk or stream
-	void writeWorker(std::string outputPath, std::string fileExtension);
-
-	// member
-	selection_settings m_settings;
-	std::mutex m_mutex;
-	std::condition_variable m_writeCondition;
-	bool m_writeActive;
-	fmIndex* m_index = NULL;
-	pseudoAligner* m_aligner = NULL;
-	std::map<std::string, std::vector<std::shared_ptr<sequenceBase>>> m_selected;
-	bool m_samOutput = false;
-	std::vector<samRecord> m_samRecords;
-};
-
-
-// -- exported functions - declarations ----------------------------------
-
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class selectION
+//
+//  DESCRIPTION   :	Use pseudo-alignment to filter reads from fastq files
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <string>
+#include <memory>
+#include <mutex>
+#include <exception>
+#include "selection_settings.h"
+#include "fmIndex.h"
+#include "pseudoAligner.h"
+#include "fileSAM.h"
+#include "IAlignmentFile.h"
+#include "ISequenceFile.h"
+#include "positionFilter.h"
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+class selectION
+{
+public:
+	// construct using existing index on disk
+	selectION(selection_settings& settings, std::string dbPrefix);
+
+	// virtual destructor
+	virtual ~selectION();
+
+	// build from fasta or fastq
+	static void buildFromFastx(selection_settings& settings, std::string fileName);
+	static void buildFromFastx(selection_settings& settings, std::string fileName, std::string dbPrefix);
+
+	// convert hdf5 index to memory mapped native index
+	static void convertIndex(selection_settings& settings, std::string dbPrefix);
+
+	// compile regions to selector index with reference names of index
+	static void compileSelectors(selection_settings& settings, std::string dbPrefix, std::string regionsFile, std::string feature, std::string selectorFile);
+
+	// rename references of filter to chapters of index, return unresolved selectors
+	uint32_t resolveSelectors(positionFilter& filter);
+
+	// scan sequence file for matches, output to one file per selector, false on error
+	bool select(ISequenceFile& seqFile, positionFilter& filter, std::string outputPath);
+
+	// estimate position of single sequence, safe to call from multiple threads
+	samRecord estimatePosition(std::string const & sequence);
+
+	// start incremental estimate of read received in chunks, decides at quality threshold
+	std::shared_ptr<alignmentSession> startSession(void);
+
+protected:
+
+private:
+	// methods
+	// default constructor
+	selectION();
+
+	// Copy constructor must not be used
+	selectION(const selectION& object);
+
+	// Assignment operator must not be used
+	const selectION& operator=(const selectION& rhs);
+
+	// native index if present and converted from current hdf5 index, hdf5 index otherwise
+	static std::string indexFile(selection_settings& settings, std::string dbPrefix);
+
+	// create alignment output file and write header, false on error
+	bool openSamFile(void);
+
+	// worker function reading records from disk, aligning and writing back
+	void selectionWorker(ISequenceFile& seqs, positionFilter& filter);
+
+	// worker function writing selected records to disk or stream
+	void writeWorker(std::string outputPath, std::string fileExtension);
+
+	// member
+	selection_settings m_settings;
+	std::mutex m_mutex;
+	std::condition_variable m_writeCondition;
+	bool m_writeActive;
+	fmIndex* m_index = NULL;
+	pseudoAligner* m_aligner = NULL;
+	std::map<std::string, std::vector<std::shared_ptr<sequenceBase>>> m_selected;
+	bool m_samOutput = false;
+	std::unique_ptr<IAlignmentFile> m_samFile;
+	std::string m_samData;				// records encoded by workers
+	size_t m_samCount = 0;				// number of records in m_samData
+	std::exception_ptr m_scanError;		// first error of workers
+};
+
+
+// -- exported functions - declarations ----------------------------------
+
 // -- exported global variables - declarations (should be empty)----------
\ No newline at end of file
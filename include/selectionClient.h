@@ -0,0 +1,68 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class selectionClient
+//
+//  DESCRIPTION   :	Connection to selectionServer sending batched
+//					position queries
+//
+//  RESTRICTIONS  : POSIX sockets
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <string>
+#include <vector>
+#include "selectionServer.h"
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+class selectionClient
+{
+public:
+	// constructor, connects to server socket
+	selectionClient(std::string socketPath);
+
+	// virtual destructor
+	virtual ~selectionClient();
+
+	// estimate positions of reads or chunks of reads, results in order of queries
+	std::vector<serveResult> query(std::vector<serveQuery> const & queries);
+
+	// release sessions of reads sent in chunks
+	void endSessions(std::vector<std::string> const & ids);
+
+	// send reads in chunks until decided or complete, last result of each read
+	std::vector<serveResult> stream(std::vector<serveQuery> const & reads, uint32_t chunkSize);
+
+	// latency histogram of server as protocol lines
+	std::string getStatistics(void);
+
+protected:
+
+private:
+	// methods
+	// default constructor
+	selectionClient();
+
+	// Copy constructor must not be used
+	selectionClient(const selectionClient& object);
+
+	// Assignment operator must not be used
+	const selectionClient& operator=(const selectionClient& rhs);
+
+	// receive lines up to empty line
+	std::vector<std::string> readResponse(void);
+
+	// member
+	int m_socket = -1;
+	std::string m_buffer;
+};
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
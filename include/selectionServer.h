@@ -0,0 +1,150 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class selectionServer
+//
+//  DESCRIPTION   :	Resident index answering batched position queries
+//					on a Unix domain socket
+//
+//  RESTRICTIONS  : POSIX sockets
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "selection.h"
+#include "positionFilter.h"
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+// Protocol: a request consists of lines "<id>\t<sequence>" terminated by
+// an empty line, the response holds one result line per read in request
+// order and an empty line. The line "#stats" returns the latency histogram.
+// Reads streamed in chunks are sent as "+<id>\t<bases>", the bases are
+// appended to the session of the read kept by the connection. Their result
+// lines start with "+<id>" once the decision is final and "?<id>" while more
+// bases are needed. The line "-<id>" ends the session without response.
+typedef struct serveQuery
+{
+	std::string id;
+	std::string sequence;
+	bool chunk = false;				// sequence continues earlier chunks of read
+}serveQuery;
+
+typedef struct serveResult
+{
+	std::string id;
+	std::string reference = "*";
+	uint32_t position = 0;
+	bool reverse = false;
+	uint32_t mapq = 0;
+	std::vector<std::string> selectors;
+	bool chunk = false;				// result of read streamed in chunks
+	bool decided = true;			// false while session needs more bases
+}serveResult;
+
+class selectionServer
+{
+public:
+	// constructor
+	selectionServer(selection_settings& settings, selectION& selection, positionFilter& filter);
+
+	// virtual destructor
+	virtual ~selectionServer();
+
+	// accept clients on socket until interrupted by SIGINT or SIGTERM
+	void run(std::string socketPath);
+
+	// estimate positions of batch, uses all worker threads
+	std::vector<serveResult> query(std::vector<serveQuery> const & queries);
+
+	// latency histogram of requests as protocol lines
+	std::string getStatistics(void);
+
+protected:
+
+private:
+	// types
+	// batch shared by worker threads, reads are claimed by index
+	typedef struct serveBatch
+	{
+		std::vector<serveQuery> const * queries;
+		std::vector<std::shared_ptr<alignmentSession>> const * sessions;	// of chunks, by query
+		std::vector<serveResult>* results;
+		size_t size = 0;
+		std::atomic<size_t> next;
+		size_t finished = 0;
+	}serveBatch;
+
+	// methods
+	// default constructor
+	selectionServer();
+
+	// Copy constructor must not be used
+	selectionServer(const selectionServer& object);
+
+	// Assignment operator must not be used
+	const selectionServer& operator=(const selectionServer& rhs);
+
+	// estimate positions of batch, chunks are appended to their sessions
+	std::vector<serveResult> query(std::vector<serveQuery> const & queries, std::vector<std::shared_ptr<alignmentSession>> const & sessions);
+
+	// estimate position and selector matches of single read or next chunk
+	serveResult classify(serveQuery const & query, std::shared_ptr<alignmentSession> const & session);
+
+	// classify unclaimed reads of batch
+	void processBatch(serveBatch& batch);
+
+	// worker thread processing queued batches
+	void queryWorker(void);
+
+	// read requests of one client until disconnect
+	void clientWorker(int clientSocket);
+
+	// join client threads that have finished since last call
+	void joinFinishedClients(std::vector<std::thread>& clients);
+
+	// add request duration to histogram
+	void recordLatency(uint64_t microseconds);
+
+	// member
+	selection_settings& m_settings;
+	selectION& m_selection;
+	positionFilter& m_filter;
+	std::vector<std::thread> m_workers;
+	std::deque<std::shared_ptr<serveBatch>> m_batches;
+	bool m_stop = false;
+	std::mutex m_mutex;
+	std::condition_variable m_batchQueued;
+	std::condition_variable m_batchDone;
+	// clients ended since last join, guarded by m_clientMutex
+	std::vector<std::thread::id> m_finishedClients;
+	std::mutex m_clientMutex;
+	// request latency in power of two microsecond buckets
+	std::vector<std::atomic<uint64_t>> m_latency;
+	std::atomic<uint64_t> m_requests;
+	std::atomic<uint64_t> m_reads;
+};
+
+// -- exported functions - declarations ----------------------------------
+// result to protocol line without line break
+std::string serveResult2string(serveResult const & result);
+
+// protocol line to result
+serveResult string2serveResult(std::string const & line);
+
+// send complete data on socket, false if peer disconnected
+bool writeSocket(int socket, std::string const & data);
+
+// -- exported global variables - declarations (should be empty)----------
@@ -0,0 +1,105 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class selectorWriter
+//
+//  DESCRIPTION   :	Buffered output files of selectors, files stay open
+//					for the whole scan
+//
+//  RESTRICTIONS  : not thread safe, used by the writer thread only
+//
+//  REQUIRES      : POSIX file descriptors
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <map>
+#include <list>
+#include <ostream>
+#include <streambuf>
+#include "sequenceBase.h"
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+class selectorWriter
+{
+public:
+	// constructor, files are created in outputPath on first write
+	selectorWriter(std::string outputPath, std::string fileExtension);
+
+	// virtual destructor, writes remaining records
+	virtual ~selectorWriter();
+
+	// append record to buffer of selector, full buffers are written to disk
+	void append(std::string const & selector, const sequenceBase* record);
+
+	// write buffers of all selectors to disk
+	void flush(void);
+
+protected:
+
+private:
+	// types
+	// open file and pending output of a selector
+	typedef struct selectorFile
+	{
+		int descriptor = -1;		// open file, -1 if closed
+		std::string buffer;			// formatted records not yet written
+		std::list<selectorFile*>::iterator recent;	// position in open files if open
+	}selectorFile;
+
+	// stream buffer appending to the buffer of the current selector
+	class appendBuffer : public std::streambuf
+	{
+	public:
+		void setTarget(std::string* target) { m_target = target; }
+
+	protected:
+		int_type overflow(int_type ch)
+		{
+			if (ch != traits_type::eof())
+				m_target->push_back(static_cast<char>(ch));
+			return ch;
+		}
+
+		std::streamsize xsputn(const char* s, std::streamsize n)
+		{
+			m_target->append(s, static_cast<size_t>(n));
+			return n;
+		}
+
+	private:
+		std::string* m_target = NULL;
+	};
+
+	// methods
+	// Copy constructor must not be used
+	selectorWriter(const selectorWriter& object);
+
+	// Assignment operator must not be used
+	const selectorWriter& operator=(const selectorWriter& rhs);
+
+	// write buffer of selector, opens file if required
+	void write(std::string const & selector, selectorFile& file);
+
+	// close file written least recently to stay below open file limit
+	void closeLeastRecent(void);
+
+	// member
+	std::string m_outputPath;
+	std::string m_fileExtension;
+	std::map<std::string, selectorFile> m_files;
+	appendBuffer m_appendBuffer;
+	std::ostream m_stream;
+	std::list<selectorFile*> m_openFiles;	// most recently written first
+	size_t m_buffered = 0;			// bytes in buffers of all selectors
+};
+
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
@@ -1,56 +1,80 @@
-// \HEADER\---------------------------------------------------------------
-//
-//  CONTENTS      : Class sequenceRecord
-//
-//  DESCRIPTION   :	Container base class for sequence records
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-//  All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-#pragma once
-// -- required headers ---------------------------------------------------
-#include <string>
-#include <ostream>
-
-// -- forward declarations -----------------------------------------------
-
-// -- exported constants, types, classes ---------------------------------
-class sequenceBase
-{
-public:
-	// constructor
-	sequenceBase(std::string name, std::string sequence);
-
-	// virtual destructor
-	virtual ~sequenceBase();
-
-	// get methods
-	size_t size();
-	std::string getName(void)const;
-	std::string getSequence(void) const;
-
-protected:
-	// default constructor
-	sequenceBase();
-
-	// write record to stream 
-	virtual void write2Stream(std::ostream& stream) const;
-	friend std::ostream& operator<< (std::ostream& outStream, const sequenceBase* seq);
-
-	// member
-	std::string m_name;
-	std::string m_sequence;
-
-private:
-};
-
-
-// -- exported functions - declarations ----------------------------------
-std::ostream& operator<< (std::ostream& outStream, const sequenceBase* seq);
-
-
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class sequenceRecord
+//
+//  DESCRIPTION   :	Container base class for sequence records
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <string>
+#include <vector>
+#include <memory>
+#include <ostream>
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+// character buffer shared by records parsed from the same block
+typedef std::shared_ptr<const std::vector<char>> sequenceBuffer;
+
+// location of a record field within the buffer
+typedef struct sequenceField
+{
+	size_t offset = 0;
+	size_t length = 0;
+}sequenceField;
+
+class sequenceBase
+{
+public:
+	// constructor
+	sequenceBase(std::string name, std::string sequence);
+	sequenceBase(sequenceBuffer buffer, sequenceField name, sequenceField sequence);
+
+	// virtual destructor
+	virtual ~sequenceBase();
+
+	// get methods
+	size_t size();
+	std::string getName(void)const;
+	std::string getSequence(void) const;
+	const char* getSequenceData(void) const;
+
+protected:
+	// default constructor
+	sequenceBase();
+
+	// field as string, empty if not set
+	std::string getField(sequenceField const & field) const;
+
+	// write field without copy to stream
+	void writeField(std::ostream& stream, sequenceField const & field) const;
+
+	// append value to buffer, return its location
+	static sequenceField appendField(std::vector<char>& buffer, std::string const & value);
+
+	// write record to stream 
+	virtual void write2Stream(std::ostream& stream) const;
+	friend std::ostream& operator<< (std::ostream& outStream, const sequenceBase* seq);
+
+	// member
+	sequenceBuffer m_buffer;
+	sequenceField m_name;
+	sequenceField m_sequence;
+
+private:
+};
+
+
+// -- exported functions - declarations ----------------------------------
+std::ostream& operator<< (std::ostream& outStream, const sequenceBase* seq);
+
+
 // -- exported global variables - declarations (should be empty)----------
\ No newline at end of file
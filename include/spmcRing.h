@@ -0,0 +1,126 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : Class spmcRing
+//
+//  DESCRIPTION   :	Bounded lock-free ring buffer with a single producer
+//					and multiple consumers
+//
+//  RESTRICTIONS  : tryPush must only be called by one thread
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+// Each slot carries a sequence number telling whether it is free for the
+// producer or filled for the consumers, consumers claim slots by advancing
+// the shared head with compare and swap.
+template<typename T>
+class spmcRing
+{
+public:
+	// constructor, capacity is rounded up to a power of two
+	spmcRing(size_t capacity)
+	{
+		size_t size = 1;
+		while (size < capacity)
+			size <<= 1;
+		m_slots.reset(new slot[size]);
+		m_mask = size - 1;
+		for (size_t i = 0; i < size; i++)
+			m_slots[i].sequence.store(i, std::memory_order_relaxed);
+		m_head.store(0, std::memory_order_relaxed);
+		m_closed.store(false, std::memory_order_relaxed);
+	}
+
+	// virtual destructor
+	virtual ~spmcRing(){};
+
+	// append item, false if ring is full
+	bool tryPush(T&& item)
+	{
+		slot& s = m_slots[m_tail & m_mask];
+		if (s.sequence.load(std::memory_order_acquire) != m_tail)
+			return false;
+		s.item = std::move(item);
+		s.sequence.store(m_tail + 1, std::memory_order_release);
+		m_tail++;
+		return true;
+	}
+
+	// take oldest item, false if ring is empty
+	bool tryPop(T& item)
+	{
+		size_t position = m_head.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			slot& s = m_slots[position & m_mask];
+			const size_t sequence = s.sequence.load(std::memory_order_acquire);
+			const int64_t difference = static_cast<int64_t>(sequence - (position + 1));
+			if (difference == 0)
+			{
+				if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					item = std::move(s.item);
+					s.sequence.store(position + m_mask + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (difference < 0)
+				return false;
+			else
+				position = m_head.load(std::memory_order_relaxed);
+		}
+	}
+
+	// producer will not push further items
+	void close(void)
+	{
+		m_closed.store(true, std::memory_order_release);
+	}
+
+	// true if producer finished, remaining items may still be popped
+	bool closed(void) const
+	{
+		return m_closed.load(std::memory_order_acquire);
+	}
+
+protected:
+
+private:
+	// types
+	typedef struct slot
+	{
+		std::atomic<size_t> sequence;
+		T item;
+	}slot;
+
+	// methods
+	// Copy constructor must not be used
+	spmcRing(const spmcRing& object);
+
+	// Assignment operator must not be used
+	const spmcRing& operator=(const spmcRing& rhs);
+
+	// member
+	std::unique_ptr<slot[]> m_slots;
+	size_t m_mask = 0;
+	alignas(64) std::atomic<size_t> m_head;		// next slot of consumers
+	alignas(64) size_t m_tail = 0;				// next slot of producer
+	std::atomic<bool> m_closed;
+};
+
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
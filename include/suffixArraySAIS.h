@@ -0,0 +1,68 @@
+// \HEADER\---------------------------------------------------------------
+//
+//  CONTENTS      : suffix array construction by induced sorting
+//
+//  DESCRIPTION   :	linear time SA-IS construction of the suffix array,
+//					streamed in segments like suffixArray
+//
+//  RESTRICTIONS  : input terminated by unique '$'
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+//  All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+#pragma once
+// -- required headers ---------------------------------------------------
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "ISuffixArray.h"
+
+// -- forward declarations -----------------------------------------------
+
+// -- exported constants, types, classes ---------------------------------
+// The complete suffix array is built on the first call of prepareForStream
+// and kept in memory until the stream is consumed.
+class suffixArraySAIS : public ISuffixArray
+{
+public:
+	// constructor
+	suffixArraySAIS(std::string& S, uint32_t t);
+
+	// virtual destructor
+	virtual ~suffixArraySAIS();
+
+	// get alphabet
+	std::string getAlphabet(void);
+
+	// get number of characters for each letter in alphabet
+	std::vector<uint32_t> getAlphabetCount(void);
+
+	// prepare for streaming suffix array
+	uint32_t prepareForStream(uint32_t maxBlockSize);
+
+	// get next Segment from suffix array stream
+	std::vector<uint32_t> getNextSegment(void);
+
+protected:
+
+private:
+	// methods
+	// Copy constructor must not be used
+	suffixArraySAIS(const suffixArraySAIS& object);
+
+	// Assignment operator must not be used
+	const suffixArraySAIS& operator=(const suffixArraySAIS& rhs);
+
+	// member
+	std::string& m_S;
+	std::string m_alphabet = "";
+	std::vector<uint32_t> m_alphabetCount;
+	std::vector<uint32_t> m_SA;
+	size_t m_streamPosition = 0;
+	uint32_t m_segmentSize = 0;
+};
+// -- exported functions - declarations ----------------------------------
+
+// -- exported global variables - declarations (should be empty)----------
@@ -0,0 +1,252 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : banded global alignment
+//
+//  DESCRIPTION   :	Global alignment of short sequences within a band
+//					around the main diagonal, vectorized over anti-diagonals
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <algorithm>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//-- private headers -----------------------------------------------------
+#include "bandedAlignment.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+// Cells of one anti-diagonal depend only on the two previous anti-diagonals
+// and are computed eight at a time in 16 bit lanes. Scores are stored by
+// query position, the reference is stored reversed so that the bases of an
+// anti-diagonal are contiguous in both sequences.
+const int16_t MatchScore = 2;
+const int16_t MismatchScore = -4;
+const int16_t GapScore = -4;
+const int16_t NoScore = -30000;						// below score of any alignment
+const int64_t Lanes = 8;							// 16 bit scores per vector
+const size_t MaxAlignmentLength = 2048;				// keeps scores within 16 bit
+const uint8_t QueryPadding = 4;						// never equal to reference code
+const uint8_t ReferencePadding = 5;
+
+//-- private types -------------------------------------------------------
+enum traceback : uint8_t
+{
+	e_diagonal = 0,
+	e_insertion = 1,
+	e_deletion = 2
+};
+
+//-- private functions --------- declarations ----------------------------
+// 2 bit code of base, other characters never match
+uint8_t baseCode(char base, uint8_t other);
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// append operation to cigar, merged with last operation of same type
+void
+appendCigar
+(
+	std::vector<cigarOperation>& cigar,
+	char operation,
+	uint32_t length
+)
+{
+	if (length == 0)
+		return;
+	if (!cigar.empty() && cigar.back().operation == operation)
+	{
+		cigar.back().length += length;
+		return;
+	}
+	cigarOperation op;
+	op.operation = operation;
+	op.length = length;
+	cigar.push_back(op);
+}
+
+
+
+
+// SAM representation of cigar
+std::string
+cigarString
+(
+	std::vector<cigarOperation> const & cigar
+)
+{
+	std::string result;
+	for (auto it = cigar.begin(); it != cigar.end(); ++it)
+	{
+		result += std::to_string((*it).length);
+		result += (*it).operation;
+	}
+	return result;
+}
+
+
+
+
+// global alignment of query to reference appended to cigar, band is widened by length difference
+void
+bandedGlobalAlignment
+(
+	std::string const & query,
+	std::string const & reference,
+	uint32_t bandWidth,
+	std::vector<cigarOperation>& cigar
+)
+{
+	const int64_t n = static_cast<int64_t>(query.size());
+	const int64_t m = static_cast<int64_t>(reference.size());
+	if (n == 0 || m == 0 || query.size() > MaxAlignmentLength || reference.size() > MaxAlignmentLength)
+	{
+		// match along shorter sequence, remainder as insertion or deletion
+		appendCigar(cigar, 'M', static_cast<uint32_t>(std::min(n, m)));
+		appendCigar(cigar, n > m ? 'I' : 'D', static_cast<uint32_t>(n > m ? n - m : m - n));
+		return;
+	}
+	// band of diagonals j - i connecting start and end of alignment
+	const int64_t band = std::max<int64_t>(bandWidth, 1);
+	const int64_t kMin = std::min<int64_t>(0, m - n) - band;
+	const int64_t kMax = std::max<int64_t>(0, m - n) + band;
+	const int64_t width = (kMax - kMin) / 2 + 1 + Lanes;
+	// query base i - 1 at position i, reference base j - 1 at position m - j
+	std::vector<uint8_t> queryCodes(n + 1 + Lanes, QueryPadding);
+	std::vector<uint8_t> referenceCodes(m + 1 + Lanes, ReferencePadding);
+	for (int64_t i = 0; i < n; i++)
+		queryCodes[i + 1] = baseCode(query[i], QueryPadding);
+	for (int64_t j = 0; j < m; j++)
+		referenceCodes[m - 1 - j] = baseCode(reference[j], ReferencePadding);
+	// scores of cell (i, r - i) at position i + 1 for the last three anti-diagonals
+	std::vector<int16_t> scores[3];
+	for (size_t k = 0; k < 3; k++)
+		scores[k].assign(n + 2 + Lanes, NoScore);
+	std::vector<uint8_t> directions((n + m + 1) * width);
+	std::vector<int64_t> firstRow(n + m + 1);
+#if defined(__SSE2__)
+	const __m128i match = _mm_set1_epi16(MatchScore);
+	const __m128i mismatch = _mm_set1_epi16(MismatchScore);
+	const __m128i gap = _mm_set1_epi16(GapScore);
+	const __m128i insertion = _mm_set1_epi16(e_insertion);
+	const __m128i deletion = _mm_set1_epi16(e_deletion);
+#endif
+	for (int64_t r = 0; r <= n + m; r++)
+	{
+		const int64_t lo = std::max<int64_t>(std::max<int64_t>(r - m, 0), r > kMax ? (r - kMax + 1) / 2 : 0);
+		const int64_t hi = std::min<int64_t>(std::min(n, r), (r - kMin) / 2);
+		int16_t* current = scores[r % 3].data();
+		int16_t const * previous = scores[(r + 2) % 3].data();
+		int16_t const * diagonal = scores[(r + 1) % 3].data();
+		uint8_t const * queryBase = queryCodes.data() + lo;
+		uint8_t const * referenceBase = referenceCodes.data() + m - r + lo;
+		uint8_t* direction = directions.data() + r * width - lo;
+		firstRow[r] = lo;
+#if defined(__SSE2__)
+		for (int64_t i = lo; i <= hi; i += Lanes)
+		{
+			const __m128i q = _mm_loadl_epi64(reinterpret_cast<__m128i const *>(queryBase + i - lo));
+			const __m128i t = _mm_loadl_epi64(reinterpret_cast<__m128i const *>(referenceBase + i - lo));
+			__m128i equal = _mm_cmpeq_epi8(q, t);
+			equal = _mm_unpacklo_epi8(equal, equal);
+			const __m128i substitution = _mm_or_si128(_mm_and_si128(equal, match), _mm_andnot_si128(equal, mismatch));
+			const __m128i d = _mm_adds_epi16(_mm_loadu_si128(reinterpret_cast<__m128i const *>(diagonal + i)), substitution);
+			const __m128i u = _mm_adds_epi16(_mm_loadu_si128(reinterpret_cast<__m128i const *>(previous + i)), gap);
+			const __m128i l = _mm_adds_epi16(_mm_loadu_si128(reinterpret_cast<__m128i const *>(previous + i + 1)), gap);
+			const __m128i h = _mm_max_epi16(d, _mm_max_epi16(u, l));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(current + i + 1), h);
+			// diagonal before insertion before deletion
+			const __m128i isDiagonal = _mm_cmpeq_epi16(h, d);
+			const __m128i isInsertion = _mm_cmpeq_epi16(h, u);
+			const __m128i trace = _mm_andnot_si128(isDiagonal, _mm_or_si128(_mm_and_si128(isInsertion, insertion), _mm_andnot_si128(isInsertion, deletion)));
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(direction + i), _mm_packus_epi16(trace, trace));
+		}
+#else
+		for (int64_t i = lo; i <= hi; i++)
+		{
+			const int16_t substitution = queryBase[i - lo] == referenceBase[i - lo] ? MatchScore : MismatchScore;
+			const int32_t d = std::max<int32_t>(diagonal[i] + substitution, NoScore);
+			const int32_t u = std::max<int32_t>(previous[i] + GapScore, NoScore);
+			const int32_t l = std::max<int32_t>(previous[i + 1] + GapScore, NoScore);
+			const int32_t h = std::max(d, std::max(u, l));
+			current[i + 1] = static_cast<int16_t>(h);
+			direction[i] = h == d ? e_diagonal : (h == u ? e_insertion : e_deletion);
+		}
+#endif
+		// first row and column of the matrix
+		if (lo == 0)
+		{
+			current[1] = static_cast<int16_t>(r * GapScore);
+			direction[0] = e_deletion;
+		}
+		if (hi == r)
+		{
+			current[r + 1] = static_cast<int16_t>(r * GapScore);
+			direction[r] = e_insertion;
+		}
+		// cells next to the band are read by the following anti-diagonals
+		current[lo] = NoScore;
+		current[hi + 2] = NoScore;
+	}
+	// trace back from end of both sequences
+	std::vector<char> operations;
+	operations.reserve(n + m);
+	int64_t i = n, j = m;
+	while (i > 0 || j > 0)
+	{
+		const int64_t r = i + j;
+		const uint8_t trace = directions[r * width + i - firstRow[r]];
+		if (trace == e_diagonal)
+		{
+			operations.push_back('M');
+			i--;
+			j--;
+		}
+		else if (trace == e_insertion)
+		{
+			operations.push_back('I');
+			i--;
+		}
+		else
+		{
+			operations.push_back('D');
+			j--;
+		}
+	}
+	for (auto it = operations.rbegin(); it != operations.rend(); ++it)
+		appendCigar(cigar, *it, 1);
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// 2 bit code of base, other characters never match
+uint8_t
+baseCode
+(
+	char base,
+	uint8_t other
+)
+{
+	switch (base)
+	{
+	case 'A': case 'a': return 0;
+	case 'C': case 'c': return 1;
+	case 'G': case 'g': return 2;
+	case 'T': case 't': return 3;
+	default: return other;
+	}
+}
@@ -0,0 +1,260 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class fastxParser
+//
+//  DESCRIPTION   :	Block buffered Fasta/ Fastq parser, records refer to
+//					fields within the shared input block
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <cstring>
+#include <algorithm>
+
+//-- private headers -----------------------------------------------------
+#include "fastxParser.h"
+#include "sequenceFasta.h"
+#include "sequenceFastq.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const size_t BlockSize = 4 * 1024 * 1024;		// bytes read from stream at once
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+sequenceField lineField(const char* data, const char* line, const char* lineEnd, size_t skip);
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor
+fastxParser::fastxParser
+(
+	std::istream& stream,
+	char recordStartIndicator
+) :m_stream(stream), m_recordStartIndicator(recordStartIndicator)
+{
+	m_block = std::make_shared<std::vector<char>>();
+}
+
+
+
+
+// virtual destructor
+fastxParser::~fastxParser()
+{
+
+}
+
+
+
+
+// return next record, NULL at end of stream
+std::shared_ptr<sequenceBase>
+fastxParser::getRecord
+(
+	void
+)
+{
+	for (;;)
+	{
+		if (m_blockPosition < m_blockFill)
+		{
+			std::shared_ptr<sequenceBase> record;
+			if (m_recordStartIndicator == '>')
+				record = parseFasta();
+			else
+				record = parseFastq();
+			if (record != NULL)
+				return record;
+		}
+		// complete block parsed at end of stream
+		if (m_streamEnd)
+			return std::shared_ptr<sequenceBase>();
+		readBlock();
+	}
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// move unparsed data to new block and append from stream
+void
+fastxParser::readBlock
+(
+	void
+)
+{
+	// records handed out keep the previous block alive, it is never modified again
+	const size_t remaining = m_blockFill - m_blockPosition;
+	size_t capacity = BlockSize;
+	// grow block for records longer than half of it
+	while (remaining > capacity / 2)
+		capacity *= 2;
+	auto block = std::make_shared<std::vector<char>>(capacity);
+	if (remaining > 0)
+		std::memcpy(block->data(), m_block->data() + m_blockPosition, remaining);
+	m_stream.read(block->data() + remaining, capacity - remaining);
+	const size_t bytesRead = static_cast<size_t>(m_stream.gcount());
+	m_streamEnd = !m_stream.good();
+	m_block = block;
+	m_blockFill = remaining + bytesRead;
+	m_blockPosition = 0;
+}
+
+
+
+
+// end of line starting at position, NULL if incomplete
+const char*
+fastxParser::findLineEnd
+(
+	const char* line
+)const
+{
+	const char* end = m_block->data() + m_blockFill;
+	const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', end - line));
+	if (lineEnd == NULL && m_streamEnd)
+		return end;
+	return lineEnd;
+}
+
+
+
+
+// parse fastq record at current position, NULL if incomplete
+std::shared_ptr<sequenceBase>
+fastxParser::parseFastq
+(
+	void
+)
+{
+	const char* data = m_block->data();
+	const char* end = data + m_blockFill;
+	const char* line = data + m_blockPosition;
+	// skip lines beginning with invalid characters
+	while (line < end && *line != m_recordStartIndicator)
+	{
+		const char* lineEnd = findLineEnd(line);
+		if (lineEnd == NULL)
+			break;
+		line = lineEnd < end ? lineEnd + 1 : end;
+	}
+	m_blockPosition = line - data;
+	if (line >= end || *line != m_recordStartIndicator)
+		return std::shared_ptr<sequenceBase>();
+	// name, sequence, description and quality on four lines
+	sequenceField fields[4];
+	for (size_t i = 0; i < 4; i++)
+	{
+		const char* lineEnd = findLineEnd(line);
+		if (lineEnd == NULL)
+			return std::shared_ptr<sequenceBase>();
+		fields[i] = lineField(data, line, lineEnd, i == 0 || i == 2 ? 1 : 0);
+		line = lineEnd < end ? lineEnd + 1 : end;
+	}
+	m_blockPosition = line - data;
+	return std::make_shared<sequenceFastq>(m_block, fields[0], fields[1], fields[2], fields[3]);
+}
+
+
+
+
+// parse fasta record at current position, NULL if incomplete
+std::shared_ptr<sequenceBase>
+fastxParser::parseFasta
+(
+	void
+)
+{
+	char* data = m_block->data();
+	const char* end = data + m_blockFill;
+	const char* line = data + m_blockPosition;
+	// skip lines beginning with invalid characters
+	while (line < end && *line != m_recordStartIndicator)
+	{
+		const char* lineEnd = findLineEnd(line);
+		if (lineEnd == NULL)
+			break;
+		line = lineEnd < end ? lineEnd + 1 : end;
+	}
+	m_blockPosition = line - data;
+	if (line >= end || *line != m_recordStartIndicator)
+		return std::shared_ptr<sequenceBase>();
+	// header and comment lines
+	const char* lineEnd = findLineEnd(line);
+	if (lineEnd == NULL)
+		return std::shared_ptr<sequenceBase>();
+	const sequenceField name = lineField(data, line, lineEnd, 1);
+	line = lineEnd < end ? lineEnd + 1 : end;
+	std::vector<sequenceField> comments;
+	while (line < end && *line == ';')
+	{
+		lineEnd = findLineEnd(line);
+		if (lineEnd == NULL)
+			return std::shared_ptr<sequenceBase>();
+		comments.push_back(lineField(data, line, lineEnd, 1));
+		line = lineEnd < end ? lineEnd + 1 : end;
+	}
+	// sequence lines up to next record, complete only if it is found
+	const char* sequenceStart = line;
+	while (line < end && *line != m_recordStartIndicator)
+	{
+		lineEnd = findLineEnd(line);
+		if (lineEnd == NULL)
+			return std::shared_ptr<sequenceBase>();
+		line = lineEnd < end ? lineEnd + 1 : end;
+	}
+	if (line >= end && !m_streamEnd)
+		return std::shared_ptr<sequenceBase>();
+	const char* recordEnd = line;
+	// join sequence lines in place, data of this record is not shared yet
+	char* target = data + (sequenceStart - data);
+	sequenceField sequence;
+	sequence.offset = target - data;
+	for (line = sequenceStart; line < recordEnd; )
+	{
+		lineEnd = findLineEnd(line);
+		const sequenceField field = lineField(data, line, lineEnd, 0);
+		std::memmove(target, data + field.offset, field.length);
+		target += field.length;
+		line = lineEnd < end ? lineEnd + 1 : end;
+	}
+	sequence.length = (target - data) - sequence.offset;
+	m_blockPosition = recordEnd - data;
+	return std::make_shared<sequenceFasta>(m_block, name, sequence, comments);
+}
+
+
+
+
+// location of line without leading characters and line break
+sequenceField
+lineField
+(
+	const char* data,
+	const char* line,
+	const char* lineEnd,
+	size_t skip
+)
+{
+	sequenceField field;
+	size_t length = lineEnd - line;
+	if (length > 0 && line[length - 1] == '\r')
+		length--;
+	skip = std::min(skip, length);
+	field.offset = (line - data) + skip;
+	field.length = length - skip;
+	return field;
+}
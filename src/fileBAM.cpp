@@ -0,0 +1,510 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class fileBAM
+//
+//  DESCRIPTION   :	Writer of binary BAM files, BGZF blocks are compressed
+//					in parallel
+//
+//  RESTRICTIONS  : records are appended by one thread
+//
+//  REQUIRES      : zlib
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <cstring>
+#include <cctype>
+#include <algorithm>
+#include <stdexcept>
+
+//-- private headers -----------------------------------------------------
+#include "fileBAM.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const size_t BgzfHeaderSize = 18;				// gzip header with BC extra subfield
+const size_t BgzfFooterSize = 8;				// CRC32 and ISIZE
+const size_t BgzfMaxBlockSize = 65536;			// limit of BSIZE field
+const size_t BlockDataSize = 0xff00;			// uncompressed bytes per BGZF block
+const size_t JobBytes = 4 * BlockDataSize;		// uncompressed bytes per job
+const size_t JobsPerThread = 4;					// BGZF jobs in flight per worker
+const uint32_t MaxCigarOperations = 0xffff;		// longer CIGAR moved to CG tag
+const size_t MaxReadNameLength = 254;			// without terminating zero
+const char CigarOperations[] = "MIDNSHP=X";		// BAM operation codes by index
+const char SequenceCodes[] = "=ACMGRSVTWYHKDBN";	// 4-bit base codes by index
+// empty block marking the end of a BGZF file
+const unsigned char BgzfEof[] = { 0x1f, 0x8b, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00,
+								  0x00, 0xff, 0x06, 0x00, 0x42, 0x43, 0x02, 0x00,
+								  0x1b, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+								  0x00, 0x00, 0x00, 0x00 };
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+void appendLittleEndian(std::string& data, uint32_t value, size_t bytes);
+void writeLittleEndian(char* data, uint32_t value, size_t bytes);
+uint8_t sequenceCode(char base);
+uint32_t parseCigar(std::string const & cigar, std::string* operations, uint32_t& queryLength, uint32_t& referenceLength);
+int32_t reg2bin(int32_t begin, int32_t end);
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor, existing file is replaced
+fileBAM::fileBAM
+(
+	std::string filePath,
+	uint32_t threads
+) :fileBase(filePath)
+{
+	m_output.open(normPath(), std::ofstream::binary | std::ofstream::trunc);
+	if (!m_output.is_open())
+		throw std::runtime_error("Could not open " + normPath() + " for writing");
+	const uint32_t workers = std::max(threads, 1u);
+	m_maxJobs = JobsPerThread * workers;
+	for (uint32_t i = 0; i < workers; i++)
+		m_workers.push_back(std::thread(&fileBAM::deflateWorker, this));
+}
+
+
+
+
+// virtual destructor, closes file if not done before
+fileBAM::~fileBAM()
+{
+	try
+	{
+		close();
+	}
+	catch (std::exception&)
+	{
+		// errors are reported by explicit close
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_jobQueued.notify_all();
+	for (auto it = m_workers.begin(); it != m_workers.end(); ++it)
+		(*it).join();
+}
+
+
+
+
+// write BAM header with reference sequences
+void
+fileBAM::writeHeader
+(
+	samHeader header
+)
+{
+	const std::string text = fileSAM::header2string(header);
+	m_data.append("BAM\1", 4);
+	appendLittleEndian(m_data, static_cast<uint32_t>(text.size()), 4);
+	m_data.append(text);
+	appendLittleEndian(m_data, static_cast<uint32_t>(header.sequences.size()), 4);
+	m_referenceIds.clear();
+	for (auto it = header.sequences.begin(); it != header.sequences.end(); ++it)
+	{
+		m_referenceIds[(*it).first] = static_cast<int32_t>(it - header.sequences.begin());
+		appendLittleEndian(m_data, static_cast<uint32_t>((*it).first.size() + 1), 4);
+		m_data.append((*it).first.c_str(), (*it).first.size() + 1);
+		appendLittleEndian(m_data, (*it).second, 4);
+	}
+	queueData(false);
+}
+
+
+
+
+// append records to file
+void
+fileBAM::append
+(
+	std::vector<samRecord>& records
+)
+{
+	if (m_closed)
+		throw std::runtime_error("Append to closed BAM file");
+	for (auto it = records.begin(); it != records.end(); ++it)
+		encode(*it, m_data);
+	queueData(false);
+	writeJobs(false);
+}
+
+
+
+
+// compress and write remaining records, append end of file marker
+void
+fileBAM::close
+(
+	void
+)
+{
+	if (m_closed)
+		return;
+	m_closed = true;
+	queueData(true);
+	writeJobs(true);
+	m_output.write(reinterpret_cast<const char*>(BgzfEof), sizeof(BgzfEof));
+	m_output.close();
+	if (m_output.fail())
+		throw std::runtime_error("Failed to write " + normPath());
+}
+
+
+
+
+// append binary record to buffer, safe to call from multiple threads
+void
+fileBAM::encode
+(
+	samRecord const & record,
+	std::string& buffer
+) const
+{
+	uint32_t queryLength = 0;
+	uint32_t referenceLength = 0;
+	const uint32_t cigarOperations = parseCigar(record.CIGAR, NULL, queryLength, referenceLength);
+	const int32_t refID = referenceId(record.RNAME);
+	const int32_t pos = static_cast<int32_t>(record.POS) - 1;
+	const int32_t nextRefID = record.RNEXT == "=" ? refID : referenceId(record.RNEXT);
+	const int32_t nextPos = static_cast<int32_t>(record.PNEXT) - 1;
+	const size_t nameLength = std::min(record.QNAME.size(), MaxReadNameLength);
+	const uint32_t sequenceLength = record.SEQ == "*" ? 0 : static_cast<uint32_t>(record.SEQ.size());
+	const bool longCigar = cigarOperations > MaxCigarOperations;
+	const int32_t bin = reg2bin(pos, pos + static_cast<int32_t>(std::max(referenceLength, 1u)));
+	// block size is written once the record is complete
+	const size_t start = buffer.size();
+	appendLittleEndian(buffer, 0, 4);
+	appendLittleEndian(buffer, static_cast<uint32_t>(refID), 4);
+	appendLittleEndian(buffer, static_cast<uint32_t>(pos), 4);
+	appendLittleEndian(buffer, static_cast<uint32_t>(nameLength + 1), 1);
+	appendLittleEndian(buffer, std::min(record.MAPQ, 255u), 1);
+	appendLittleEndian(buffer, static_cast<uint32_t>(bin), 2);
+	appendLittleEndian(buffer, longCigar ? 2 : cigarOperations, 2);
+	appendLittleEndian(buffer, record.FLAG, 2);
+	appendLittleEndian(buffer, sequenceLength, 4);
+	appendLittleEndian(buffer, static_cast<uint32_t>(nextRefID), 4);
+	appendLittleEndian(buffer, static_cast<uint32_t>(nextPos), 4);
+	appendLittleEndian(buffer, static_cast<uint32_t>(record.TLEN), 4);
+	buffer.append(record.QNAME.c_str(), nameLength);
+	buffer.push_back('\0');
+	// CIGAR beyond 16-bit operation count is stored as kSmN with CG tag
+	if (longCigar)
+	{
+		appendLittleEndian(buffer, queryLength << 4 | 4, 4);
+		appendLittleEndian(buffer, referenceLength << 4 | 3, 4);
+	}
+	else
+		parseCigar(record.CIGAR, &buffer, queryLength, referenceLength);
+	// two bases per byte, high nibble first
+	for (uint32_t i = 0; i < sequenceLength; i += 2)
+	{
+		uint8_t code = static_cast<uint8_t>(sequenceCode(record.SEQ[i]) << 4);
+		if (i + 1 < sequenceLength)
+			code |= sequenceCode(record.SEQ[i + 1]);
+		buffer.push_back(static_cast<char>(code));
+	}
+	if (record.QUAL == "*" || record.QUAL.size() != sequenceLength)
+		buffer.append(sequenceLength, static_cast<char>(0xff));
+	else
+	{
+		for (auto it = record.QUAL.begin(); it != record.QUAL.end(); ++it)
+			buffer.push_back(static_cast<char>(*it - 33));
+	}
+	if (longCigar)
+	{
+		buffer.append("CGBI", 4);
+		appendLittleEndian(buffer, cigarOperations, 4);
+		parseCigar(record.CIGAR, &buffer, queryLength, referenceLength);
+	}
+	writeLittleEndian(&buffer[start], static_cast<uint32_t>(buffer.size() - start - 4), 4);
+}
+
+
+
+
+// append records encoded by encode to file
+void
+fileBAM::appendEncoded
+(
+	std::string const & data
+)
+{
+	if (m_closed)
+		throw std::runtime_error("Append to closed BAM file");
+	m_data.append(data);
+	queueData(false);
+	writeJobs(false);
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// reference id of sequence name, -1 if not in header
+int32_t
+fileBAM::referenceId
+(
+	std::string const & name
+) const
+{
+	auto it = m_referenceIds.find(name);
+	return it != m_referenceIds.end() ? (*it).second : -1;
+}
+
+
+
+
+// pass uncompressed data to workers, partial jobs only if requested
+void
+fileBAM::queueData
+(
+	bool all
+)
+{
+	if (m_data.size() < JobBytes && !(all && m_data.size() > 0))
+		return;
+	// keep number of jobs in flight bounded
+	while (m_jobs.size() >= m_maxJobs)
+	{
+		const size_t jobs = m_jobs.size();
+		writeJobs(false);
+		if (m_jobs.size() == jobs)
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_jobDone.wait(lock, [this]{ return m_jobs.front()->done; });
+		}
+	}
+	auto job = std::make_shared<bgzfJob>();
+	job->data.swap(m_data);
+	m_data.reserve(JobBytes + BlockDataSize);
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pending.push(job);
+	}
+	m_jobQueued.notify_one();
+	m_jobs.push_back(job);
+}
+
+
+
+
+// write compressed jobs in order, waits for pending jobs if requested
+void
+fileBAM::writeJobs
+(
+	bool all
+)
+{
+	while (!m_jobs.empty())
+	{
+		auto job = m_jobs.front();
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			if (!job->done && !all)
+				break;
+			m_jobDone.wait(lock, [&job]{ return job->done; });
+		}
+		if (job->failed)
+			throw std::runtime_error("Failed to compress BGZF block");
+		m_output.write(job->compressed.data(), job->compressed.size());
+		if (m_output.fail())
+			throw std::runtime_error("Failed to write " + normPath());
+		m_jobs.pop_front();
+	}
+}
+
+
+
+
+// compress data of job into BGZF blocks, false on zlib error
+bool
+fileBAM::deflateBlocks
+(
+	z_stream& stream,
+	bgzfJob& job
+)
+{
+	auto& compressed = job.compressed;
+	compressed.clear();
+	for (size_t position = 0; position < job.data.size(); position += BlockDataSize)
+	{
+		const size_t size = std::min(BlockDataSize, job.data.size() - position);
+		Bytef* data = reinterpret_cast<Bytef*>(&job.data[position]);
+		const size_t block = compressed.size();
+		compressed.resize(block + BgzfMaxBlockSize);
+		char* header = compressed.data() + block;
+		deflateReset(&stream);
+		stream.next_in = data;
+		stream.avail_in = static_cast<uInt>(size);
+		stream.next_out = reinterpret_cast<Bytef*>(header + BgzfHeaderSize);
+		stream.avail_out = static_cast<uInt>(BgzfMaxBlockSize - BgzfHeaderSize - BgzfFooterSize);
+		if (deflate(&stream, Z_FINISH) != Z_STREAM_END)
+			return false;
+		const size_t blockSize = BgzfHeaderSize + stream.total_out + BgzfFooterSize;
+		// gzip member header with BC subfield holding block size minus one
+		const unsigned char magic[] = { 0x1f, 0x8b, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00,
+										0x00, 0xff, 0x06, 0x00, 0x42, 0x43, 0x02, 0x00 };
+		std::memcpy(header, magic, sizeof(magic));
+		writeLittleEndian(header + 16, static_cast<uint32_t>(blockSize - 1), 2);
+		writeLittleEndian(header + blockSize - 8, static_cast<uint32_t>(crc32(0, data, static_cast<uInt>(size))), 4);
+		writeLittleEndian(header + blockSize - 4, static_cast<uint32_t>(size), 4);
+		compressed.resize(block + blockSize);
+	}
+	return true;
+}
+
+
+
+
+// worker thread compressing queued jobs
+void
+fileBAM::deflateWorker
+(
+	void
+)
+{
+	z_stream stream;
+	std::memset(&stream, 0, sizeof(stream));
+	// raw deflate data, headers are written in deflateBlocks
+	const bool ready = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+	for (;;)
+	{
+		std::shared_ptr<bgzfJob> job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_jobQueued.wait(lock, [this]{ return m_stop || !m_pending.empty(); });
+			if (m_stop)
+				break;
+			job = m_pending.front();
+			m_pending.pop();
+		}
+		const bool success = ready && deflateBlocks(stream, *job);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			job->failed = !success;
+			job->done = true;
+		}
+		m_jobDone.notify_all();
+	}
+	if (ready)
+		deflateEnd(&stream);
+}
+
+
+
+
+// append little endian unsigned integer of 1, 2 or 4 bytes
+void
+appendLittleEndian
+(
+	std::string& data,
+	uint32_t value,
+	size_t bytes
+)
+{
+	for (size_t i = 0; i < bytes; i++)
+		data.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+}
+
+
+
+
+// overwrite little endian unsigned integer of 2 or 4 bytes
+void
+writeLittleEndian
+(
+	char* data,
+	uint32_t value,
+	size_t bytes
+)
+{
+	for (size_t i = 0; i < bytes; i++)
+		data[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+
+
+
+// 4-bit code of base, N for unknown characters
+uint8_t
+sequenceCode
+(
+	char base
+)
+{
+	const char* code = std::strchr(SequenceCodes, std::toupper(static_cast<unsigned char>(base)));
+	return code != NULL && base != '\0' ? static_cast<uint8_t>(code - SequenceCodes) : 15;
+}
+
+
+
+
+// smallest bin of the BAM index containing [begin, end)
+int32_t
+reg2bin
+(
+	int32_t begin,
+	int32_t end
+)
+{
+	--end;
+	if (begin >> 14 == end >> 14) return ((1 << 15) - 1) / 7 + (begin >> 14);
+	if (begin >> 17 == end >> 17) return ((1 << 12) - 1) / 7 + (begin >> 17);
+	if (begin >> 20 == end >> 20) return ((1 << 9) - 1) / 7 + (begin >> 20);
+	if (begin >> 23 == end >> 23) return ((1 << 6) - 1) / 7 + (begin >> 23);
+	if (begin >> 26 == end >> 26) return ((1 << 3) - 1) / 7 + (begin >> 26);
+	return 0;
+}
+
+
+
+
+// number of CIGAR operations, appended as length << 4 | code if operations is set
+uint32_t
+parseCigar
+(
+	std::string const & cigar,
+	std::string* operations,
+	uint32_t& queryLength,
+	uint32_t& referenceLength
+)
+{
+	uint32_t count = 0;
+	queryLength = 0;
+	referenceLength = 0;
+	if (cigar == "*")
+		return 0;
+	uint32_t length = 0;
+	for (auto it = cigar.begin(); it != cigar.end(); ++it)
+	{
+		if (*it >= '0' && *it <= '9')
+		{
+			length = length * 10 + static_cast<uint32_t>(*it - '0');
+			continue;
+		}
+		const char* code = std::strchr(CigarOperations, *it);
+		if (code == NULL || *it == '\0')
+			throw std::invalid_argument("Invalid CIGAR " + cigar);
+		const uint32_t operation = static_cast<uint32_t>(code - CigarOperations);
+		if (operations != NULL)
+			appendLittleEndian(*operations, length << 4 | operation, 4);
+		// M, I, S, =, X consume query, M, D, N, =, X consume reference
+		if (operation == 0 || operation == 1 || operation == 4 || operation >= 7)
+			queryLength += length;
+		if (operation == 0 || operation == 2 || operation == 3 || operation >= 7)
+			referenceLength += length;
+		length = 0;
+		count++;
+	}
+	return count;
+}
@@ -1,255 +1,283 @@
-// \MODULE\---------------------------------------------------------------
-//
-//  CONTENTS      : Class sequenceRecordSource
-//
-//  DESCRIPTION   :	Container class for sequence records
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-// All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-
-//-- standard headers ----------------------------------------------------
-#include <iostream>
-#include <thread>
-#include <chrono>
-
-//-- private headers -----------------------------------------------------
-#include "fileFastx.h"
-#include "sequenceFasta.h"
-#include "sequenceFastq.h"
-
-//-- source control system ID (if needed)---------------------------------
-
-//-- exported global variables - definitions (should be empty) -----------
-
-//-- private constants ---------------------------------------------------
-const size_t MaxBufferSize = 10000000;
-const size_t MinBufferSize = 100000;
-
-//-- private types -------------------------------------------------------
-
-//-- private functions --------- declarations ----------------------------
-std::ifstream::pos_type filesize(std::string filename);
-
-//-- private global variables -- definitions (should be empty) -----------
-
-//-- exported functions -------- definitions -----------------------------
-// constructor
-fileFastx::fileFastx
-(
-	std::string filePath
-) :fileBase(filePath), m_fileStream(std::ifstream(normPath()))
-{
-	if (m_fileStream.good())
-	{
-		const auto ext = extension();
-		char recordStartIndicator = ' ';
-		if (ext == ".fasta" || ext == ".fa")
-		{
-			m_fileExtension = ".fa";
-			recordStartIndicator = '>';
-		}			
-		else if (ext == ".fastq" || ext == ".fq")
-		{
-			m_fileExtension = ".fq";
-			recordStartIndicator = '@';
-		}
-		else
-			m_fileExtension = "";
-		// skip invalid lines
-		std::string buffer;
-		while (m_fileStream.good() && m_fileStream.peek() != recordStartIndicator)
-			std::getline(m_fileStream, buffer);
-		if (!m_fileStream.good())
-			return;
-		// read first sequence in constructor and start reader thread
-		if (m_fileExtension == ".fa")
-		{
-			m_records.push(std::shared_ptr<sequenceBase>(new sequenceFasta(m_fileStream)));
-		}
-		else if (m_fileExtension == ".fq")
-		{
-			m_records.push(std::shared_ptr<sequenceBase>(new sequenceFastq(m_fileStream)));
-		}
-		m_bufferSize += m_records.front()->size();
-		// check for additional valid records
-		while (m_fileStream.good() && m_fileStream.peek() != recordStartIndicator)
-			std::getline(m_fileStream, buffer);
-		if (!m_fileStream.good())
-			return;
-		else
-		{
-			m_readActive = true;
-			m_reader = std::thread(&fileFastx::fileReader, this);
-		}
-	}
-	else
-		throw std::invalid_argument("Can't read " + filePath);
-}
-
-
-
-
-// virtual destructor
-fileFastx::~fileFastx()
-{
-	m_readActive = false;
-	m_readCondition.notify_one();
-	if (m_reader.joinable())
-		m_reader.join();
-	
-}
-
-
-
-
-// return true if no more sequences available
-bool 
-fileFastx::empty()
-{
-	std::unique_lock<std::mutex> lock(m_readMutex);
-	if (m_records.empty())
-		if (m_readActive)
-			return false;
-		else
-			return true;
-	else
-		return false;
-}
-
-
-
-
-// return next sequence in file, NULL if not available
-std::shared_ptr<sequenceBase> 
-fileFastx::getRecord()
-{
-	if (this->empty())
-		return std::shared_ptr<sequenceBase>();
-	else
-	{
-		while (m_records.empty())
-		{
-			// block until next record available
-			m_readCondition.notify_one();
-			std::unique_lock<std::mutex> lock(m_readMutex);
-			m_readCondition.wait(lock);
-		}
-		std::shared_ptr<sequenceBase> record;
-		{
-			std::unique_lock<std::mutex> lock(m_readMutex);
-			record = m_records.front();
-			m_records.pop();
-			m_bufferSize -= (*record).size();
-		}
-		if (m_bufferSize <= MinBufferSize)
-			m_readCondition.notify_one();
-		return record;
-	}
-}
-
-
-
-
-// return extension for output file writer
-std::string 
-fileFastx::extension() 
-const
-{
-	return fileBase::extension();
-}
-
-
-
-
-// return read progress in range 0 - 1.0
-float 
-fileFastx::progress() 
-{
-	float p = 0;
-	try
-	{
-		p = static_cast<float>(m_fileStream.tellg()) / fileBase::size();
-	}
-	catch (...)
-	{
-
-	}
-	return p;
-}
-
-
-
-
-// predicate required storage for all sequences
-size_t 
-fileFastx::predicateMemoryRequirement
-(
-	void
-)
-{
-	if (m_fileExtension == ".fq")
-		return filesize(normPath()) / 2;
-	else
-		return filesize(normPath());
-}
-
-
-
-
-//-- private functions --------- definitions -----------------------------
-// file reader function
-void 
-fileFastx::fileReader
-(
-
-)
-{
-	char recordStartIndicator;
-	if (m_fileExtension == ".fa")
-		recordStartIndicator = '>';
-	else
-		recordStartIndicator = '@';
-	while (m_readActive)
-	{
-		// wait for signal
-		{
-			std::unique_lock<std::mutex> lock(m_readMutex);
-			m_readCondition.wait(lock);
-		}
-		while (m_fileStream.good() && m_bufferSize <= MaxBufferSize)
-		{
-			// read next record from input file
-			std::shared_ptr<sequenceBase> record;		
-			if (recordStartIndicator == '>')
-				record = std::shared_ptr<sequenceBase>(new sequenceFasta(m_fileStream));
-			else
-				record = std::shared_ptr<sequenceBase>(new sequenceFastq(m_fileStream));
-			// skip lines beginning with invalid characters
-			std::string buffer;
-			while (m_fileStream.good() && m_fileStream.peek() != recordStartIndicator)
-				std::getline(m_fileStream, buffer);
-			{
-				std::unique_lock<std::mutex> lock(m_readMutex);
-				m_records.push(record);
-				m_bufferSize += (*record).size();
-				if (!m_fileStream.good())
-					m_readActive = false;
-			}// lock destroyed by closing block
-			m_readCondition.notify_one();
-		}
-	}
-}
-
-
-
-
-std::ifstream::pos_type filesize(std::string filename)
-{
-	std::ifstream in(filename, std::ifstream::ate | std::ifstream::binary);
-	return in.tellg();
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class sequenceRecordSource
+//
+//  DESCRIPTION   :	Container class for sequence records
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <thread>
+#include <stdexcept>
+#include <chrono>
+#include <boost/filesystem.hpp>
+
+//-- private headers -----------------------------------------------------
+#include "fileFastx.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const size_t BatchRecords = 256;				// records per batch
+const size_t BatchBases = 1000000;				// bases per batch
+const size_t RingBatches = 16;					// batches buffered by reader
+const uint32_t SpinAttempts = 64;				// yield before sleeping on full or empty ring
+const uint32_t BackoffSleep = 100;				// sleep in microseconds
+const size_t CompressionRatio = 4;				// assumed for memory requirement of gzip input
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+std::ifstream::pos_type filesize(std::string filename);
+void waitBackoff(uint32_t attempt);
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor
+fileFastx::fileFastx
+(
+	std::string filePath,
+	uint32_t threads
+) :fileBase(filePath), m_fileStream(std::ifstream(normPath(), std::ifstream::binary)), m_batches(RingBatches), m_readActive(false)
+{
+	if (m_fileStream.good())
+	{
+		const auto ext = extension();
+		char recordStartIndicator = ' ';
+		if (ext == ".fasta" || ext == ".fa")
+		{
+			m_fileExtension = ".fa";
+			recordStartIndicator = '>';
+		}			
+		else if (ext == ".fastq" || ext == ".fq")
+		{
+			m_fileExtension = ".fq";
+			recordStartIndicator = '@';
+		}
+		else
+			m_fileExtension = "";
+		if (m_fileExtension == "")
+		{
+			m_batches.close();
+			return;
+		}
+		// gzip and BGZF input detected by content
+		if (gzipBuffer::isCompressed(m_fileStream))
+		{
+			m_gzipBuffer.reset(new gzipBuffer(m_fileStream, threads));
+			m_gzipStream.reset(new std::istream(m_gzipBuffer.get()));
+			// report corrupt input instead of silently ending the stream
+			m_gzipStream->exceptions(std::istream::badbit);
+			m_parser.reset(new fastxParser(*m_gzipStream, recordStartIndicator));
+		}
+		else
+			m_parser.reset(new fastxParser(m_fileStream, recordStartIndicator));
+		// start reader thread, parser skips invalid lines
+		m_readActive = true;
+		m_reader = std::thread(&fileFastx::fileReader, this);
+	}
+	else
+		throw std::invalid_argument("Can't read " + filePath);
+}
+
+
+
+
+// virtual destructor
+fileFastx::~fileFastx()
+{
+	m_readActive = false;
+	if (m_reader.joinable())
+		m_reader.join();
+	
+}
+
+
+
+
+// return true if no more sequences available, waits for next batch
+bool 
+fileFastx::empty()
+{
+	std::unique_lock<std::mutex> lock(m_readMutex);
+	if (m_currentRecord < m_currentBatch.size())
+		return false;
+	m_currentRecord = 0;
+	return !getRecords(m_currentBatch);
+}
+
+
+
+
+// return next sequence in file, NULL if not available
+std::shared_ptr<sequenceBase> 
+fileFastx::getRecord()
+{
+	std::unique_lock<std::mutex> lock(m_readMutex);
+	if (m_currentRecord >= m_currentBatch.size())
+	{
+		m_currentRecord = 0;
+		if (!getRecords(m_currentBatch))
+			return std::shared_ptr<sequenceBase>();
+	}
+	return m_currentBatch[m_currentRecord++];
+}
+
+
+
+
+// replace records by next batch of sequences, false if no more available,
+// throws read error of input once all batches before it are returned
+bool
+fileFastx::getRecords
+(
+	std::vector<std::shared_ptr<sequenceBase>>& records
+)
+{
+	for (uint32_t attempt = 0; ; attempt++)
+	{
+		if (m_batches.tryPop(records))
+			return true;
+		// reader pushes all batches before closing the ring
+		if (m_batches.closed())
+		{
+			if (m_batches.tryPop(records))
+				return true;
+			records.clear();
+			if (m_readError)
+				std::rethrow_exception(m_readError);
+			return false;
+		}
+		waitBackoff(attempt);
+	}
+}
+
+
+
+
+// return extension for output file writer, without compression suffix
+std::string 
+fileFastx::extension() 
+const
+{
+	const auto ext = fileBase::extension();
+	if (ext == ".gz")
+		return boost::filesystem::path(normPath()).stem().extension().string();
+	return ext;
+}
+
+
+
+
+// return read progress in range 0 - 1.0
+float 
+fileFastx::progress() 
+{
+	float p = 0;
+	try
+	{
+		p = static_cast<float>(m_fileStream.tellg()) / fileBase::size();
+	}
+	catch (...)
+	{
+
+	}
+	return p;
+}
+
+
+
+
+// predicate required storage for all sequences
+size_t 
+fileFastx::predicateMemoryRequirement
+(
+	void
+)
+{
+	size_t size = filesize(normPath());
+	if (m_gzipBuffer != NULL)
+		size *= CompressionRatio;
+	if (m_fileExtension == ".fq")
+		return size / 2;
+	else
+		return size;
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// file reader function
+void 
+fileFastx::fileReader
+(
+
+)
+{
+	std::vector<std::shared_ptr<sequenceBase>> batch;
+	size_t batchBases = 0;
+	try
+	{
+		while (m_readActive)
+		{
+			// read next record from input file
+			auto record = m_parser->getRecord();
+			if (record != NULL)
+			{
+				batchBases += record->size();
+				batch.push_back(record);
+			}
+			// hand out batch, wait while ring is full
+			if (batch.size() >= BatchRecords || batchBases >= BatchBases || (record == NULL && batch.size() > 0))
+			{
+				for (uint32_t attempt = 0; m_readActive && !m_batches.tryPush(std::move(batch)); attempt++)
+					waitBackoff(attempt);
+				batch = std::vector<std::shared_ptr<sequenceBase>>();
+				batchBases = 0;
+			}
+			if (record == NULL)
+				break;
+		}
+	}
+	catch (std::exception& e)
+	{
+		// passed to consumers, truncated input must not end like a complete file
+		m_readError = std::make_exception_ptr(std::runtime_error("Error reading " + normPath() + ": " + e.what()));
+	}
+	m_batches.close();
+}
+
+
+
+
+// yield for first attempts, sleep afterwards
+void
+waitBackoff
+(
+	uint32_t attempt
+)
+{
+	if (attempt < SpinAttempts)
+		std::this_thread::yield();
+	else
+		std::this_thread::sleep_for(std::chrono::microseconds(BackoffSleep));
+}
+
+
+
+
+std::ifstream::pos_type filesize(std::string filename)
+{
+	std::ifstream in(filename, std::ifstream::ate | std::ifstream::binary);
+	return in.tellg();
 }
\ No newline at end of file
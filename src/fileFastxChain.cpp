@@ -0,0 +1,322 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class fileFastxChain
+//
+//  DESCRIPTION   :	Sequence records of multiple Fasta/ Fastq files read
+//					in order, following file is opened in advance
+//
+//  RESTRICTIONS  : all files contain the same record type
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <algorithm>
+#include <stdexcept>
+#include <boost/filesystem.hpp>
+
+//-- private headers -----------------------------------------------------
+#include "fileFastxChain.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+std::string recordExtension(boost::filesystem::path const & file);
+bool isSequenceFile(boost::filesystem::path const & file);
+bool matchWildcard(std::string const & name, std::string const & pattern);
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor, threads used to decompress BGZF input
+fileFastxChain::fileFastxChain
+(
+	std::vector<std::string> filePaths,
+	uint32_t threads
+) :m_filePaths(filePaths), m_threads(threads)
+{
+	if (m_filePaths.empty())
+		throw std::invalid_argument("No input files");
+	// selected reads of all files are written to the same output
+	m_extension = recordExtension(m_filePaths.front());
+	const bool fasta = m_extension == ".fa" || m_extension == ".fasta";
+	for (auto it = m_filePaths.begin(); it != m_filePaths.end(); ++it)
+	{
+		const auto ext = recordExtension(*it);
+		if ((ext == ".fa" || ext == ".fasta") != fasta)
+			throw std::invalid_argument("Input files mix Fasta and Fastq records: " + *it);
+	}
+	m_current = openNext();
+	prefetchNext();
+}
+
+
+
+
+// virtual destructor
+fileFastxChain::~fileFastxChain()
+{
+
+}
+
+
+
+
+// files, directories and wildcard patterns to sorted list of files
+std::vector<std::string>
+fileFastxChain::expandPaths
+(
+	std::vector<std::string> const & inputs
+)
+{
+	namespace fs = boost::filesystem;
+	std::vector<std::string> filePaths;
+	for (auto it = inputs.begin(); it != inputs.end(); ++it)
+	{
+		fs::path input(*it);
+		std::vector<std::string> matches;
+		if (fs::is_directory(input))
+		{
+			// sequence files directly within directory
+			for (fs::directory_iterator file(input); file != fs::directory_iterator(); ++file)
+				if (fs::is_regular_file(file->path()) && isSequenceFile(file->path()))
+					matches.push_back(file->path().generic_string());
+			if (matches.empty())
+				throw std::invalid_argument("No sequence files in directory " + *it);
+		}
+		else if ((*it).find_first_of("*?") != std::string::npos)
+		{
+			// wildcards in file name only
+			fs::path directory = input.has_parent_path() ? input.parent_path() : fs::path(".");
+			const std::string pattern = input.filename().string();
+			if (fs::is_directory(directory))
+				for (fs::directory_iterator file(directory); file != fs::directory_iterator(); ++file)
+					if (fs::is_regular_file(file->path()) && isSequenceFile(file->path()) &&
+						matchWildcard(file->path().filename().string(), pattern))
+						matches.push_back(file->path().generic_string());
+			if (matches.empty())
+				throw std::invalid_argument("No input files match " + *it);
+		}
+		else if (fs::exists(input))
+			matches.push_back(input.generic_string());
+		else
+			throw std::invalid_argument("Can't read " + *it);
+		std::sort(matches.begin(), matches.end());
+		filePaths.insert(filePaths.end(), matches.begin(), matches.end());
+	}
+	return filePaths;
+}
+
+
+
+
+// return true if no more sequences available, waits for next batch
+bool
+fileFastxChain::empty()
+{
+	std::unique_lock<std::mutex> lock(m_readMutex);
+	if (m_currentRecord < m_currentBatch.size())
+		return false;
+	m_currentRecord = 0;
+	return !getRecords(m_currentBatch);
+}
+
+
+
+
+// return next sequence in file, NULL if not available
+std::shared_ptr<sequenceBase>
+fileFastxChain::getRecord()
+{
+	std::unique_lock<std::mutex> lock(m_readMutex);
+	if (m_currentRecord >= m_currentBatch.size())
+	{
+		m_currentRecord = 0;
+		if (!getRecords(m_currentBatch))
+			return std::shared_ptr<sequenceBase>();
+	}
+	return m_currentBatch[m_currentRecord++];
+}
+
+
+
+
+// replace records by next batch of sequences, false if no more available,
+// throws read errors of member files and errors opening the next file
+bool
+fileFastxChain::getRecords
+(
+	std::vector<std::shared_ptr<sequenceBase>>& records
+)
+{
+	for (;;)
+	{
+		std::shared_ptr<fileFastx> file;
+		{
+			std::lock_guard<std::mutex> lock(m_chainMutex);
+			file = m_current;
+			if (file == NULL)
+			{
+				records.clear();
+				if (m_openError)
+					std::rethrow_exception(m_openError);
+				return false;
+			}
+		}
+		// read error ends the chain, remaining files are not scanned
+		if (file->getRecords(records))
+			return true;
+		// first worker finding the file drained moves on, prefetched file is already read
+		std::lock_guard<std::mutex> lock(m_chainMutex);
+		if (m_current == file)
+		{
+			m_current = m_next;
+			m_currentFile++;
+			prefetchNext();
+		}
+	}
+}
+
+
+
+
+// return extension for output file writer
+std::string
+fileFastxChain::extension()
+const
+{
+	return m_extension;
+}
+
+
+
+
+// return read progress in range 0 - 1.0
+float
+fileFastxChain::progress()
+{
+	std::lock_guard<std::mutex> lock(m_chainMutex);
+	if (m_current == NULL)
+		return 1.0;
+	return (m_currentFile + m_current->progress()) / m_filePaths.size();
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// open next file in list, NULL if none left
+std::shared_ptr<fileFastx>
+fileFastxChain::openNext
+(
+	void
+)
+{
+	if (m_nextFile >= m_filePaths.size())
+		return std::shared_ptr<fileFastx>();
+	const std::string filePath = m_filePaths[m_nextFile++];
+	// reader of unknown format would end without records
+	if (!isSequenceFile(filePath))
+		throw std::invalid_argument("Unsupported input file " + filePath + ", expected Fasta or Fastq");
+	return std::make_shared<fileFastx>(filePath, m_threads);
+}
+
+
+
+
+// open file following the current one, errors are kept until the current file is read
+void
+fileFastxChain::prefetchNext
+(
+	void
+)
+{
+	// called by scan workers, errors are passed on after the current file
+	try
+	{
+		if (!m_openError)
+			m_next = openNext();
+	}
+	catch (std::exception&)
+	{
+		m_next.reset();
+		m_openError = std::current_exception();
+	}
+}
+
+
+
+
+// file extension without compression suffix
+std::string
+recordExtension
+(
+	boost::filesystem::path const & file
+)
+{
+	if (file.extension() == ".gz")
+		return file.stem().extension().string();
+	return file.extension().string();
+}
+
+
+
+
+// true for Fasta and Fastq file extensions
+bool
+isSequenceFile
+(
+	boost::filesystem::path const & file
+)
+{
+	const auto ext = recordExtension(file);
+	return ext == ".fa" || ext == ".fasta" || ext == ".fq" || ext == ".fastq";
+}
+
+
+
+
+// match name against pattern with '*' for any sequence and '?' for any character
+bool
+matchWildcard
+(
+	std::string const & name,
+	std::string const & pattern
+)
+{
+	size_t n = 0, p = 0;
+	size_t starPattern = std::string::npos, starName = 0;
+	while (n < name.size())
+	{
+		if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n]))
+		{
+			n++;
+			p++;
+		}
+		else if (p < pattern.size() && pattern[p] == '*')
+		{
+			starPattern = p++;
+			starName = n;
+		}
+		else if (starPattern != std::string::npos)
+		{
+			// let last star consume one more character
+			p = starPattern + 1;
+			n = ++starName;
+		}
+		else
+			return false;
+	}
+	while (p < pattern.size() && pattern[p] == '*')
+		p++;
+	return p == pattern.size();
+}
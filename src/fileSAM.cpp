@@ -1,179 +1,325 @@
-// \MODULE\---------------------------------------------------------------
-//
-//  CONTENTS      : Class fileSAM
-//
-//  DESCRIPTION   :	Basic implementation for SAM file format interactions
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-// All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-
-//-- standard headers ----------------------------------------------------
-#include <fstream>
-#include <iostream>
-#include <sstream>
-#include <boost/filesystem.hpp>
-
-//-- private headers -----------------------------------------------------
-#include "fileSAM.h"
-
-//-- source control system ID (if needed)---------------------------------
-
-//-- exported global variables - definitions (should be empty) -----------
-
-//-- private constants ---------------------------------------------------
-
-//-- private types -------------------------------------------------------
-
-//-- private functions --------- declarations ----------------------------
-
-//-- private global variables -- definitions (should be empty) -----------
-
-//-- exported functions -------- definitions -----------------------------
-// constructor
-fileSAM::fileSAM
-(
-	std::string filePath
-) :fileBase(filePath)
-{
-
-}
-
-
-
-
-// virtual destructor
-fileSAM::~fileSAM()
-{
-
-}
-
-
-
-
-// write sam header
-void 
-fileSAM::writeHeader
-(
-	samHeader header
-)
-{
-	boost::filesystem::path file(normPath());
-	std::ofstream outputStream((file).generic_string(), std::ofstream::app);
-	// header line
-	outputStream << "@HD" << "\t" << "VN:" + std::to_string(header.majorFormat) + "." + std::to_string(header.minorFormat) << std::endl;
-	// sequence lines
-	for (auto it = header.sequences.begin(); it != header.sequences.end(); ++it)
-		outputStream << "@SQ" << "\t" << "SN:" << (*it).first << "\t" << "LN:" << std::to_string((*it).second) << std::endl;
-	// program line
-	auto prog = header.program;
-	if (prog.ID != "default")
-		outputStream << "@PG" << "\t" <<
-						"ID:" << prog.ID << "\t" <<
-						"PN:" << prog.Name << "\t" <<
-						"VN:" << prog.Version << "\t" <<
-						"CL:" << prog.commandLine << std::endl;
-}
-
-
-
-
-// append record to file
-void
-fileSAM::append
-(
-	samRecord& record
-)
-{
-	std::string parsed = record2string(record);
-	boost::filesystem::path file(normPath());
-	std::ofstream outputStream((file).generic_string(), std::ofstream::app);
-	outputStream << parsed << std::endl;
-	outputStream.flush();
-}
-
-
-
-
-void 
-fileSAM::append
-(
-	std::vector<samRecord>& records
-)
-{
-	boost::filesystem::path file(normPath());
-	std::ofstream outputStream((file).generic_string(), std::ofstream::app);
-	for (auto it = records.begin(); it != records.end(); ++it)
-	{
-		std::string parsed = record2string(*it);
-		outputStream << parsed << std::endl;
-	}
-	outputStream.flush();
-}
-
-
-
-
-//-- private functions --------- definitions -----------------------------
-// record to string
-std::string 
-fileSAM::record2string(samRecord& record)
-{
-	std::string parsed = "";
-	parsed += record.QNAME + "\t" + 
-			  std::to_string(record.FLAG) + "\t" + 
-			  record.RNAME + "\t" + 
-			  std::to_string(record.POS) + "\t" + 
-			  std::to_string(record.MAPQ) + "\t" + 
-			  record.CIGAR + "\t" + 
-			  record.RNEXT + "\t" +
-			  std::to_string(record.PNEXT) + "\t" +
-			  std::to_string(record.TLEN) + "\t" +
-			  record.SEQ + "\t" +
-			  record.QUAL;
-	return parsed;
-}
-
-
-
-
-// parse string to record
-samRecord 
-fileSAM::string2record
-(
-	std::string str
-)
-{
-	std::istringstream iss(str);
-	std::string token;
-	std::vector<std::string> fields;
-	while (std::getline(iss, token, '\t'))
-		fields.push_back(token);
-	samRecord parsed;
-	if (fields.size() >= 11)
-	{
-		parsed.QNAME = fields[0];
-		parsed.RNAME = fields[2];
-		parsed.CIGAR = fields[5];
-		parsed.RNEXT = fields[6];
-		parsed.SEQ = fields[9];
-		parsed.QUAL = fields[10];
-		try
-		{
-			parsed.FLAG = std::stoi(fields[1]);
-			parsed.POS = std::stoi(fields[3]);
-			parsed.MAPQ = std::stoi(fields[4]);
-			parsed.PNEXT = std::stoi(fields[7]);
-			parsed.TLEN = std::stoi(fields[8]);
-		}
-		catch (std::exception&)
-		{
-			// no handling, return default field value
-		}
-	}
-	return parsed;
-}
\ No newline at end of file
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class fileSAM
+//
+//  DESCRIPTION   :	Basic implementation for SAM file format interactions
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <cstring>
+#include <stdexcept>
+
+//-- private headers -----------------------------------------------------
+#include "fileSAM.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const size_t MaxIntegerLength = 11;		// sign and ten digits of 32 bit integer
+const size_t SamIntegerFields = 6;
+const size_t SamStringFields = 6;
+// two digit decimal strings of 0 - 99
+const char DigitPairs[] =
+	"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+	"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+char* writeUnsigned(char* out, uint32_t value);
+char* writeSigned(char* out, int32_t value);
+char* writeField(char* out, std::string const & field);
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor, records are appended to existing file
+fileSAM::fileSAM
+(
+	std::string filePath
+) :fileBase(filePath)
+{
+	m_output.open(normPath(), std::ofstream::app);
+	if (!m_output.is_open())
+		throw std::runtime_error("Could not open " + normPath() + " for writing");
+}
+
+
+
+
+// virtual destructor, closes file if not done before
+fileSAM::~fileSAM()
+{
+	try
+	{
+		close();
+	}
+	catch (std::exception&)
+	{
+		// errors are reported by explicit close
+	}
+}
+
+
+
+
+// write sam header
+void 
+fileSAM::writeHeader
+(
+	samHeader header
+)
+{
+	const std::string text = header2string(header);
+	appendEncoded(text);
+}
+
+
+
+
+// append record to file
+void
+fileSAM::append
+(
+	samRecord& record
+)
+{
+	std::string data;
+	encode(record, data);
+	appendEncoded(data);
+}
+
+
+
+
+void 
+fileSAM::append
+(
+	std::vector<samRecord>& records
+)
+{
+	std::string data;
+	for (auto it = records.begin(); it != records.end(); ++it)
+		encode(*it, data);
+	appendEncoded(data);
+}
+
+
+
+
+// append record as text line to buffer, no allocation if capacity suffices
+void
+fileSAM::encode
+(
+	samRecord const & record,
+	std::string& buffer
+) const
+{
+	const size_t start = buffer.size();
+	buffer.resize(start + record.QNAME.size() + record.RNAME.size() + record.CIGAR.size() +
+		record.RNEXT.size() + record.SEQ.size() + record.QUAL.size() +
+		SamIntegerFields * MaxIntegerLength + SamStringFields + SamIntegerFields);
+	char* out = &buffer[start];
+	out = writeField(out, record.QNAME);
+	out = writeUnsigned(out, record.FLAG);
+	*out++ = '\t';
+	out = writeField(out, record.RNAME);
+	out = writeUnsigned(out, record.POS);
+	*out++ = '\t';
+	out = writeUnsigned(out, record.MAPQ);
+	*out++ = '\t';
+	out = writeField(out, record.CIGAR);
+	out = writeField(out, record.RNEXT);
+	out = writeUnsigned(out, record.PNEXT);
+	*out++ = '\t';
+	out = writeSigned(out, record.TLEN);
+	*out++ = '\t';
+	out = writeField(out, record.SEQ);
+	// last field ends the line
+	std::memcpy(out, record.QUAL.data(), record.QUAL.size());
+	out += record.QUAL.size();
+	*out++ = '\n';
+	buffer.resize(static_cast<size_t>(out - &buffer[0]));
+}
+
+
+
+
+// append lines encoded by encode to file
+void
+fileSAM::appendEncoded
+(
+	std::string const & data
+)
+{
+	if (!m_output.is_open())
+		throw std::runtime_error("Append to closed SAM file");
+	m_output.write(data.data(), data.size());
+	if (m_output.fail())
+		throw std::runtime_error("Failed to write " + normPath());
+}
+
+
+
+
+// write buffered records and close file
+void
+fileSAM::close
+(
+	void
+)
+{
+	if (!m_output.is_open())
+		return;
+	m_output.close();
+	if (m_output.fail())
+		throw std::runtime_error("Failed to write " + normPath());
+}
+
+
+
+
+// text of sam header, also part of the BAM header
+std::string
+fileSAM::header2string
+(
+	samHeader const & header
+)
+{
+	std::ostringstream outputStream;
+	// header line
+	outputStream << "@HD" << "\t" << "VN:" + std::to_string(header.majorFormat) + "." + std::to_string(header.minorFormat) << '\n';
+	// sequence lines
+	for (auto it = header.sequences.begin(); it != header.sequences.end(); ++it)
+		outputStream << "@SQ" << "\t" << "SN:" << (*it).first << "\t" << "LN:" << std::to_string((*it).second) << '\n';
+	// program line
+	auto prog = header.program;
+	if (prog.ID != "default")
+		outputStream << "@PG" << "\t" <<
+						"ID:" << prog.ID << "\t" <<
+						"PN:" << prog.Name << "\t" <<
+						"VN:" << prog.Version << "\t" <<
+						"CL:" << prog.commandLine << '\n';
+	return outputStream.str();
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// parse string to record
+samRecord 
+fileSAM::string2record
+(
+	std::string str
+)
+{
+	std::istringstream iss(str);
+	std::string token;
+	std::vector<std::string> fields;
+	while (std::getline(iss, token, '\t'))
+		fields.push_back(token);
+	samRecord parsed;
+	if (fields.size() >= 11)
+	{
+		parsed.QNAME = fields[0];
+		parsed.RNAME = fields[2];
+		parsed.CIGAR = fields[5];
+		parsed.RNEXT = fields[6];
+		parsed.SEQ = fields[9];
+		parsed.QUAL = fields[10];
+		try
+		{
+			parsed.FLAG = std::stoi(fields[1]);
+			parsed.POS = std::stoi(fields[3]);
+			parsed.MAPQ = std::stoi(fields[4]);
+			parsed.PNEXT = std::stoi(fields[7]);
+			parsed.TLEN = std::stoi(fields[8]);
+		}
+		catch (std::exception&)
+		{
+			// no handling, return default field value
+		}
+	}
+	return parsed;
+}
+
+
+
+
+// decimal representation of value, returns end of written digits
+char*
+writeUnsigned
+(
+	char* out,
+	uint32_t value
+)
+{
+	char digits[MaxIntegerLength];
+	char* first = digits + MaxIntegerLength;
+	// two digits per division
+	while (value >= 100)
+	{
+		const uint32_t pair = (value % 100) * 2;
+		value /= 100;
+		*--first = DigitPairs[pair + 1];
+		*--first = DigitPairs[pair];
+	}
+	if (value >= 10)
+	{
+		*--first = DigitPairs[value * 2 + 1];
+		*--first = DigitPairs[value * 2];
+	}
+	else
+		*--first = static_cast<char>('0' + value);
+	const size_t length = static_cast<size_t>(digits + MaxIntegerLength - first);
+	std::memcpy(out, first, length);
+	return out + length;
+}
+
+
+
+
+// decimal representation of value with sign, returns end of written digits
+char*
+writeSigned
+(
+	char* out,
+	int32_t value
+)
+{
+	if (value >= 0)
+		return writeUnsigned(out, static_cast<uint32_t>(value));
+	*out++ = '-';
+	return writeUnsigned(out, 0u - static_cast<uint32_t>(value));
+}
+
+
+
+
+// field followed by tab, returns end of written field
+char*
+writeField
+(
+	char* out,
+	std::string const & field
+)
+{
+	std::memcpy(out, field.data(), field.size());
+	out += field.size();
+	*out++ = '\t';
+	return out;
+}
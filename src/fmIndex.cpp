@@ -1,957 +1,1878 @@
-// \MODULE\---------------------------------------------------------------
-//
-//  CONTENTS      : Class FM-Index
-//
-//  DESCRIPTION   :	FM-Index
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-// All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-
-//-- standard headers ----------------------------------------------------
-#include <iostream>
-#include <fstream>
-#include <stdexcept>
-#include <algorithm>
-#include <climits>
-
-//-- private headers -----------------------------------------------------
-#include "fmIndex.h"
-#include "suffixArray.h"
-#include "fileFastx.h"
-using namespace H5;
-
-//-- source control system ID (if needed)---------------------------------
-
-//-- exported global variables - definitions (should be empty) -----------
-
-//-- private constants ---------------------------------------------------
-const uint32_t BwtLastDiskChunkSize = 1024000;			// Size of compressed chunks in hdf5 file
-
-
-const struct DatasetNames
-{
-	const std::string m_bwtFirst = "FirstColumn";
-	const std::string m_bwtLast = "LastColumn";
-	const std::string m_tally = "Tally";
-	const std::string m_suffixArraySample = "SuffixArraySample";
-	const std::string m_suffixArray = "SuffixArray";
-}DatasetNames;
-
-
-const struct GroupNames
-{
-	const std::string m_Index = "Index";
-	const std::string m_Subsequences = "Subsequences";
-}GroupNames;
-
-
-//-- private types -------------------------------------------------------
-typedef struct indexValuePair
-{
-	uint32_t index;
-	uint32_t value;
-}indexValuePair;
-
-
-typedef struct IndexFileFirstColumn
-{
-	char chr;
-	uint32_t count;
-}IndexFileFirstColumn;
-
-
-//-- private functions --------- declarations ----------------------------
-void bwtFromSA(const std::string& S, std::vector<uint32_t> const& sa, std::string& bwt, size_t bwtOffset);
-herr_t getGroupDatasetNames(hid_t loc_id, const char* name, const H5L_info_t *linfo, void* opdata);
-
-//-- private global variables -- definitions (should be empty) -----------
-
-//-- exported functions -------- definitions -----------------------------
-// constructor loading index from disk
-fmIndex::fmIndex
-(
-	fmIndex_settings& settings,
-	std::string indexFileName	
-) : m_settings(settings)
-{
-	init();
-	load(indexFileName);
-}
-
-
-
-
-// virtual destructor
-fmIndex::~fmIndex()
-{
-	this->clearDataStructures();
-}
-
-
-
-
-// allocate memory of input string
-void 
-fmIndex::allocateMemory
-(
-	std::string& str, 
-	uint32_t expectedSize
-)
-{
-	// reserve memory for string and appending $ at the end
-	str.reserve(expectedSize + 1);
-}
-
-
-
-
-// build index
-void 
-fmIndex::build
-(
-	fmIndex_settings& settings,
-	std::string& str,
-	std::string outputFilename
-)
-{
-	fmIndex workingIndex;
-	str.append("$");
-	workingIndex.m_settings = settings;
-	workingIndex.buildIndex(str, outputFilename);
-}
-
-
-
-
-// build index using chapters
-void 
-fmIndex::build
-(
-	fmIndex_settings& settings,
-	std::string& str, 
-	std::string outputFilename, 
-	std::map<uint32_t, std::string> chapters
-)
-{
-	fmIndex workingIndex;
-	str.append("$");
-	workingIndex.m_settings = settings;
-	workingIndex.m_nameOffset = chapters;
-	workingIndex.buildIndex(str, outputFilename);
-}
-
-
-
-
-// load existing index from disk
-void 
-fmIndex::load
-(
-	std::string indexFile
-)
-{
-	clearDataStructures();
-	m_nameOffset.clear();
-	Exception::dontPrint();
-	try
-	{
-		// open file
-		H5File file(indexFile, H5F_ACC_RDONLY);
-		auto grpSubsequences = file.openGroup(GroupNames.m_Subsequences);
-		std::vector<std::string> subsequenceNames;
-		H5Literate(grpSubsequences.getId(),
-					H5_INDEX_NAME, H5_ITER_INC, NULL,
-					getGroupDatasetNames, &subsequenceNames);
-
-		// read settings from root attributes
-		uint32_t attr_data[1];
-		Attribute attr = file.openAttribute("suffixSample");
-		attr.read(PredType::NATIVE_UINT32, &attr_data);
-		m_settings.set_m_saSampleStepSize(attr_data[0]);
-		attr = file.openAttribute("tallyStep");
-		attr.read(PredType::NATIVE_UINT32, &attr_data);
-		m_settings.set_m_tallyStepSize(attr_data[0]);
-
-		// read names and offsets of subsequences
-		for (auto it = subsequenceNames.begin(); it != subsequenceNames.end(); ++it)
-		{
-			auto dst = grpSubsequences.openDataSet(*it);
-			uint32_t offset;
-			hsize_t dims[] = { 1 };
-			DataSpace dataspace(1, dims);
-			dst.read(&offset, PredType::NATIVE_UINT32, dataspace);
-			m_nameOffset[offset] = *it;
-		}
-
-		// read bwtFirst
-		auto grpIndex = file.openGroup(GroupNames.m_Index);
-		auto dataset = grpIndex.openDataSet(DatasetNames.m_bwtFirst);
-		auto dataspace = H5Dget_space(dataset.getId());
-		hsize_t dim;
-		H5Sget_simple_extent_dims(dataspace, &dim, NULL);
-		auto bwtFirstData = std::vector<IndexFileFirstColumn>(dim);
-		dataset.read((void*)&*bwtFirstData.begin(), m_fileDataTypes[DatasetNames.m_bwtFirst]);
-		uint8_t charIndex = 0;
-		for (auto it = bwtFirstData.begin(); it != bwtFirstData.end(); ++it)
-		{
-			m_alphabet.push_back((*it).chr);
-			m_charIndex[(*it).chr] = charIndex++;
-			m_bwtFirst.push_back((*it).count);
-		}
-
-		// read bwtLast
-		dataset = grpIndex.openDataSet(DatasetNames.m_bwtLast);
-		dataspace = H5Dget_space(dataset.getId());
-		H5Sget_simple_extent_dims(dataspace, &dim, NULL);
-		m_bwtLast.resize(dim);				// may throw bad_alloc
-		dataset.read((void*)&*m_bwtLast.begin(), m_fileDataTypes[DatasetNames.m_bwtLast]);
-		m_N = dim;
-
-		// read suffix array sample
-		dataset = grpIndex.openDataSet(DatasetNames.m_suffixArraySample);
-		dataspace = H5Dget_space(dataset.getId());
-		H5Sget_simple_extent_dims(dataspace, &dim, NULL);
-		m_suffixArraySample.resize(dim);	// may throw bad_alloc
-		dataset.read((void*)&*m_suffixArraySample.begin(), m_fileDataTypes[DatasetNames.m_suffixArraySample]);
-
-		// read suffix array
-		//dataset = grpIndex.openDataSet(DatasetNames.m_suffixArray);
-		//dataspace = H5Dget_space(dataset.getId());
-		//H5Sget_simple_extent_dims(dataspace, &dim, NULL);
-		//m_suffixArray.resize(dim);	// may throw bad_alloc
-		//dataset.read((void*)&*m_suffixArray.begin(), m_fileDataTypes[DatasetNames.m_suffixArray]);
-		
-		// read tally
-		initTallyDatatype(m_alphabet);
-		m_tally.resize(m_alphabet.size());
-		dataset = grpIndex.openDataSet(DatasetNames.m_tally);
-		dataspace = H5Dget_space(dataset.getId());
-		H5Sget_simple_extent_dims(dataspace, &dim, NULL);
-		auto tallyIter = m_tally.begin();
-		auto alphaIter = m_alphabet.begin();
-		size_t columnOffset = 0;
-		for (; tallyIter != m_tally.end() && alphaIter != m_alphabet.end(); ++tallyIter, ++alphaIter)
-		{
-			CompType colSubType(sizeof(uint32_t));
-			colSubType.insertMember(std::string(1, *alphaIter), 0, PredType::NATIVE_UINT32);
-			(*tallyIter).resize(dim);
-			dataset.read(&*(*tallyIter).begin(), colSubType);
-			columnOffset += sizeof(uint32_t);
-		}
-	}
-	catch (Exception& ex)
-	{
-		if (ex.getDetailMsg().find("H5Fopen") != std::string::npos)
-			throw std::invalid_argument("Index " + indexFile + " not found");
-		else
-			throw std::invalid_argument("Index " + indexFile + " corrupted");
-	}
-	// memory allocation exceptions are left untouched
-}
-
-
-
-
-// return complete index sequence
-std::string
-fmIndex::getIndexSequence(void)
-{
-	std::string ref;
-	ref.reserve(m_N);
-	char currentChar = '$';
-	uint32_t currentRow = 0;
-	for (uint32_t i = 0; i < m_N; i++)
-	{
-		currentChar = m_bwtLast[currentRow];
-		ref.append(1,currentChar);
-		uint32_t currentCharCount = getCount(currentChar, currentRow);
-		currentRow = getRowFromRank(currentChar, currentCharCount - 1);
-	}
-	std::reverse(ref.begin(), ref.end());
-	return ref;
-}
-
-
-
-
-// get substr of index sequence
-std::string
-fmIndex::getIndexSequence
-(
-	uint32_t startIdx, 
-	uint32_t length
-)
-{
-	if (startIdx + length >= m_N)
-		throw std::out_of_range("Requested string out of index range");
-	// suffix array sample is sorted by index, 
-	// have to find checkpoint the hard way
-	uint32_t lokkupStartIdx = startIdx + length;
-	uint32_t checkPointIdx;
-	checkPointIdx = lokkupStartIdx + (m_settings.m_saSampleStepSize - lokkupStartIdx % m_settings.m_saSampleStepSize);
-	uint32_t currentRow = 0;
-	if (checkPointIdx < m_N)
-	{
-		auto it = m_suffixArraySample.cbegin();
-		while (it != m_suffixArraySample.cend() && (*it).value != checkPointIdx)
-			it++;
-		currentRow = (*it).index;
-	}
-	// reconstruct ref string from bwt
-	std::string index;
-	index.reserve(checkPointIdx - startIdx + 1);
-	for (uint32_t i = checkPointIdx - 1; i > startIdx; i--)
-	{
-		char currentChar = m_bwtLast[currentRow];
-		index.append(1, currentChar);
-		uint32_t currentCharCount = getCount(currentChar, currentRow);
-		currentRow = getRowFromRank(currentChar, currentCharCount - 1);	
-	}
-	std::reverse(index.begin(), index.end());
-	return index.substr(0, length);
-}
-
-
-
-
-// return vector containing all occurences of pattern in index
-std::vector<uint32_t> 
-fmIndex::getMatchingPositions
-(
-	std::string const & pattern
-)
-{
-	return getMatchingPositions(pattern, UINT32_MAX);
-}
-
-
-
-
-// limit matching positions for performance reasons
-std::vector<uint32_t>
-fmIndex::getMatchingPositions
-(
-	std::string const & pattern, 
-	const uint32_t maxResults
-)
-{
-	// range for last character in pattern
-	int64_t suffixStart = pattern.size() - 1;
-	uint32_t rowStart = getRowFromRank(pattern[suffixStart], 0);
-	uint32_t rowStop = rowStart + m_bwtFirst[m_charIndex[pattern[suffixStart]]];
-	suffixStart--;
-	// range for following characters
-	while (suffixStart >= 0 && rowStop > rowStart)
-	{
-		const char currentChar = pattern[suffixStart];
-		uint32_t startCount = 0;
-		if (rowStart > 0)
-			startCount = getCount(currentChar, rowStart - 1);
-		uint32_t stopCount = getCount(currentChar, rowStop - 1);
-		if (stopCount > startCount)
-		{
-			uint32_t startRank = startCount;
-			uint32_t stopRank = stopCount;
-			rowStart = getRowFromRank(currentChar, startRank);
-			rowStop = getRowFromRank(currentChar, stopRank);
-			suffixStart--;
-		}
-		else
-			break;
-	}
-	// get positions of matches
-	std::vector<uint32_t> results;
-	if (maxResults >= rowStop - rowStart)
-	{
-		results.reserve(rowStop - rowStart);
-		for (auto i = rowStart; i < rowStop; i++)
-		{
-			auto position = getPositionFromRow(i);
-			if (position >= 0)
-				results.push_back(position);
-		}
-		std::sort(results.begin(), results.end());
-	}
-	return results;
-}
-
-
-
-
-// get position of longest common subsequence (lcs)
-std::vector<lcsDefinition>
-fmIndex::getLongestCommonSubsequence
-(
-	std::string const & pattern
-)
-{
-	int64_t prefixEnd = pattern.size() - 1;
-	int64_t lcsLength = 0;
-	int64_t lcsReadPos = 0;
-	int64_t lcsStartRow = 0, lcsStopRow = 0;
-	// ckeck for each prefix of str
-	while (prefixEnd > 0 && prefixEnd > lcsLength)
-	{
-		// range for last character in pattern
-		int64_t suffixStart = prefixEnd;
-		uint32_t rowStart = getRowFromRank(pattern[suffixStart], 0);
-		uint32_t rowStop = rowStart + m_bwtFirst[m_charIndex[pattern[suffixStart]]];
-		suffixStart--;
-		// range for following characters
-		while (suffixStart >= 0 && rowStop > rowStart)
-		{
-			const char currentChar = pattern[suffixStart];
-			uint32_t startCount = 0;
-			if (rowStart > 0)
-				startCount = getCount(currentChar, rowStart - 1);
-			uint32_t stopCount = getCount(currentChar, rowStop - 1);
-			if (stopCount > startCount)
-			{
-				uint32_t startRank = startCount;
-				uint32_t stopRank = stopCount;
-				rowStart = getRowFromRank(currentChar, startRank);
-				rowStop = getRowFromRank(currentChar, stopRank);
-				suffixStart--;
-			}
-			else
-				break;
-		}
-		if (prefixEnd - suffixStart > lcsLength && rowStart < rowStop)
-		{
-			lcsLength = prefixEnd - suffixStart;
-			lcsStartRow = rowStart;
-			lcsStopRow = rowStop;
-			lcsReadPos = suffixStart + 1;
-		}
-		prefixEnd--;
-	}
-	std::vector<lcsDefinition> results;
-	for (auto i = lcsStartRow; i < lcsStopRow; i++)
-	{
-		auto indexStart = getPositionFromRow(i);
-		if (indexStart >= 0)
-		{
-			lcsDefinition result;
-			result.indexStart = getPositionFromRow(i);
-			result.strStart = lcsReadPos;
-			result.lcsLength = lcsLength;
-			results.push_back(result);
-		}
-	}
-	return results;
-}
-
-
-
-
-// return name and relative position in chapter
-std::pair<std::string, uint32_t> 
-fmIndex::getRelativePosition
-(
-	uint32_t absolutPosition
-)
-{
-	auto it = m_nameOffset.lower_bound(absolutPosition);
-	if (it != m_nameOffset.begin() && (*it).first != absolutPosition)
-		it = std::prev(it);	
-	return std::make_pair((*it).second, absolutPosition - (*it).first);
-}
-
-
-
-
-// optionally return names and lengths of chapters in order
-std::vector<std::pair<std::string, uint32_t>> 
-fmIndex::getChapters
-(
-	void
-)
-{
-	std::vector<std::pair<std::string, uint32_t>> chapters;
-	size_t totalLength = m_bwtLast.size();
-	for (auto it = m_nameOffset.begin(); it != m_nameOffset.end(); ++it)
-	{
-		auto it_next = std::next(it);
-		if (it_next != m_nameOffset.end())
-			chapters.push_back(std::make_pair((*it).second, (*it_next).first - (*it).first));
-		else
-			chapters.push_back(std::make_pair((*it).second, totalLength - (*it).first));
-	}
-	return chapters;
-}
-
-
-
-
-//-- private functions --------- definitions -----------------------------
-// constructor
-fmIndex::fmIndex
-() : m_charIndex(256, 0)
-{
-	init();
-}
-
-
-
-
-// init
-void
-fmIndex::init
-(
-
-)
-{
-	// init static file datatypes
-	// m_bwtLast
-	m_fileDataTypes[DatasetNames.m_bwtLast] = PredType::NATIVE_CHAR;
-	// m_bwtFirst
-	CompType memType(sizeof(IndexFileFirstColumn));
-	memType.insertMember("char", HOFFSET(IndexFileFirstColumn, chr), PredType::NATIVE_UINT8);
-	memType.insertMember("count", HOFFSET(IndexFileFirstColumn, count), PredType::NATIVE_UINT32);
-	m_fileDataTypes[DatasetNames.m_bwtFirst] = memType;
-	// m_suffixArraySample
-	memType = CompType(sizeof(indexValuePair));
-	memType.insertMember("index", HOFFSET(indexValuePair, index), PredType::NATIVE_UINT32);
-	memType.insertMember("value", HOFFSET(indexValuePair, value), PredType::NATIVE_UINT32);
-	m_fileDataTypes[DatasetNames.m_suffixArraySample] = memType;
-	// m_suffixArray
-	m_fileDataTypes[DatasetNames.m_suffixArray] = PredType::NATIVE_UINT32;
-	// add default chapter
-	m_nameOffset[0] = "default";
-}
-
-
-
-
-// build index
-void 
-fmIndex::buildIndex
-(
-	std::string& str, 
-	std::string outputFilename
-)
-{
-	m_N = str.size();
-	suffixArray sa(str, m_settings.m_threads);
-	clearDataStructures();
-	// compute first column of bwt matrix and init index lookup
-	auto alphabet = sa.getAlphabet();
-	auto alphabetCount = sa.getAlphabetCount();
-	uint8_t alphabetSize = 0;
-	auto it1 = alphabet.begin();
-	auto it2 = alphabetCount.begin();
-	for (; it1 != alphabet.end() && it2 != alphabetCount.end(); ++it1, ++it2)
-	{
-		if ((*it1) != '$')
-		{
-			m_charIndex[*it1] = alphabetSize++;
-			m_bwtFirst.push_back(*it2);
-			m_alphabet.push_back(*it1);
-		}
-	}
-
-	// clear old ranks
-	m_tally.resize(alphabetSize);
-
-	// start output file writer
-	m_writeActive = true;
-	m_writeBlock = false;
-	auto writeThread = std::thread(&fmIndex::fileWriter, this, outputFilename);
-
-	// prepare suffix array segment stream
-	auto blockSize = sa.prepareForStream(m_settings.m_MaxSuffixMemoryBlock);
-	m_settings.logging().log(e_logInfo, "Suffix-array stream prepared, max block is " + std::to_string(blockSize));
-
-	// reserve memory
-	m_bwtLast.reserve(blockSize);
-	m_suffixArraySample.reserve(blockSize / m_settings.m_saSampleStepSize + 1);
-	for (auto it = m_tally.begin(); it != m_tally.end(); ++it)
-		(*it).reserve(blockSize / m_settings.m_tallyStepSize + 1);
-
-	// stream FM-Index to disk
-	size_t complete = 0;
-	size_t lastCompletePrint = 0;
-	for (;;)
-	{
-		auto const & sfx = sa.getNextSegment();
-		if (sfx.size() == 0)
-			break;
-		// wait for pending write operations
-		m_writeBlock = false;
-		std::unique_lock<std::mutex> lock(m_writeMutex);
-
-		// process chunk of suffix array
-		processChunk(str, sfx, complete);
-		// m_suffixArray.insert(m_suffixArray.end(), sfx.begin(), sfx.end());
-		// notify file writer thread
-		m_writeBlock = true;
-		lock.unlock();
-		m_writeCondition.notify_one();
-		complete += sfx.size();
-		if (complete > lastCompletePrint + m_N / 100)
-		{
-			m_settings.logging().log(e_logInfo, "Completed " + std::to_string(complete) + " / " + std::to_string(m_N));
-			lastCompletePrint = complete;
-		}		
-	}
-	if (lastCompletePrint != complete)
-		m_settings.logging().log(e_logInfo, "Completed " + std::to_string(complete) + " / " + std::to_string(m_N));
-
-	// finalize output file
-	m_writeBlock = true;
-	m_writeActive = false;
-	m_writeCondition.notify_one();
-	writeThread.join();
-
-	// clear names for the case the class is reused
-	m_nameOffset.clear();
-	m_nameOffset[0] = "default";
-}
-
-
-
-
-// output file writer
-void 
-fmIndex::fileWriter
-(
-	std::string outputFilename
-)
-{
-	// create new file, overwrite if existent
-	H5File file(outputFilename, H5F_ACC_TRUNC);
-
-	// save settings as attributes in root
-	hsize_t attr_dims[1] = {1};
-	uint32_t attr_data[1];
-	DataSpace attr_dataspace = DataSpace(1, attr_dims);
-	Attribute attr = file.createAttribute("suffixSample", PredType::NATIVE_UINT32, attr_dataspace);
-	attr_data[0] = m_settings.get_m_saSampleStepSize();
-	attr.write(PredType::NATIVE_UINT32, attr_data);
-	attr = file.createAttribute("tallyStep", PredType::NATIVE_UINT32, attr_dataspace);
-	attr_data[0] = m_settings.get_m_tallyStepSize();
-	attr.write(PredType::NATIVE_UINT32, attr_data);
-
-	// init compound datatype for tally
-	initTallyDatatype(m_alphabet);
-
-	// write name and offset of sequences
-	auto grpSubsequences = file.createGroup(GroupNames.m_Subsequences);
-	for (auto it = m_nameOffset.begin(); it != m_nameOffset.end(); ++it)
-	{
-		hsize_t dims[1]{1};
-		DataSpace dataspace(1, dims);
-		DataSet dataset = grpSubsequences.createDataSet((*it).second, PredType::NATIVE_UINT32, dataspace);
-		dataset.write((void*)&(*it).first, PredType::NATIVE_UINT32);
-	}
-
-	// write first column of bwt matrix
-	auto bwtFirstData = std::vector<IndexFileFirstColumn>();
-	auto it1 = m_bwtFirst.begin();
-	auto it2 = m_alphabet.begin();
-	for (; it1 != m_bwtFirst.end() && it2 != m_alphabet.end(); ++it1, ++it2)
-	{
-		IndexFileFirstColumn item;
-		item.chr = *it2;
-		item.count = *it1;
-		bwtFirstData.push_back(item);
-	}
-	hsize_t dims[] = { m_bwtFirst.size() };
-	hsize_t chunkDims[] = { BwtLastDiskChunkSize < m_N / 10 ? BwtLastDiskChunkSize : m_N };
-	DataSpace dataspace(1, dims);
-	auto grpIndex = file.createGroup(GroupNames.m_Index);
-	DataSet dst_bwtFirst = grpIndex.createDataSet(DatasetNames.m_bwtFirst, 
-												  m_fileDataTypes[DatasetNames.m_bwtFirst], 
-												  dataspace);
-	dst_bwtFirst.write((void*)&*(bwtFirstData.begin()), m_fileDataTypes[DatasetNames.m_bwtFirst]);
-
-	// init datasets for stream writing
-	dims[0] = m_N;
-	dataspace = DataSpace(1, dims);
-	DSetCreatPropList properties;
-	properties.setChunk(1, chunkDims);
-	properties.setDeflate(3);
-	DataSet dst_bwtLast = grpIndex.createDataSet(DatasetNames.m_bwtLast, 
-												 m_fileDataTypes[DatasetNames.m_bwtLast], 
-												 dataspace, properties);
-	m_N % m_settings.m_saSampleStepSize == 0 ? dims[0] = m_N / m_settings.m_saSampleStepSize : 
-											   dims[0] = m_N / m_settings.m_saSampleStepSize + 1;
-	dataspace = DataSpace(1, dims);
-	DataSet dst_suffixArraySample = grpIndex.createDataSet(DatasetNames.m_suffixArraySample, 
-														   m_fileDataTypes[DatasetNames.m_suffixArraySample], 
-														   dataspace);
-	m_N % m_settings.m_tallyStepSize == 0 ? dims[0] = m_N / m_settings.m_tallyStepSize : 
-											dims[0] = m_N / m_settings.m_tallyStepSize + 1;
-	dataspace = DataSpace(1, dims);
-	DataSet dst_tally = grpIndex.createDataSet(DatasetNames.m_tally,
-											   m_fileDataTypes[DatasetNames.m_tally], 
-											   dataspace);
-	size_t tallyPosition = 0;
-	size_t suffixArraySamplePosition = 0;
-	size_t bwtLastPosition = 0;
-	hsize_t offset[1], count[1], stride[1], block[1];
-	stride[0] = 1;
-	block[0] = 1;
-	DataSpace memspace;
-	while (m_writeActive)
-	{
-		// wait for signal
-		{
-			std::unique_lock<std::mutex> lock(m_writeMutex);
-			m_writeCondition.wait(lock);
-		}
-		if (m_writeBlock) // secure against spurious wakeup
-		{
-			volatile std::unique_lock<std::mutex> lock(m_writeMutex);
-			// write bwt_Last
-			offset[0] = bwtLastPosition;
-			count[0] = m_bwtLast.size();
-			dims[0] = m_bwtLast.size();
-			memspace = DataSpace(1, dims, NULL);
-			dataspace = dst_bwtLast.getSpace();
-			dataspace.selectHyperslab(H5S_SELECT_SET, count, offset, stride, block);
-			dst_bwtLast.write((void*)&*m_bwtLast.begin(), 
-							  m_fileDataTypes[DatasetNames.m_bwtLast], 
-							  memspace, dataspace);
-			bwtLastPosition += m_bwtLast.size();
-			m_bwtLast.clear();
-			// write suffix array sample
-			offset[0] = suffixArraySamplePosition;
-			count[0] = m_suffixArraySample.size();
-			dims[0] = m_suffixArraySample.size();
-			memspace = DataSpace(1, dims, NULL);
-			dataspace = dst_suffixArraySample.getSpace();
-			dataspace.selectHyperslab(H5S_SELECT_SET, count, offset, stride, block);
-			dst_suffixArraySample.write((void*)&*m_suffixArraySample.begin(), 
-										m_fileDataTypes[DatasetNames.m_suffixArraySample], 
-										memspace, dataspace);
-			suffixArraySamplePosition += m_suffixArraySample.size();
-			m_suffixArraySample.clear();
-			// write tally
-			const size_t tallyLength = (*m_tally.begin()).size();
-			offset[0] = tallyPosition;
-			count[0] = tallyLength;
-			dims[0] = tallyLength;
-			memspace = DataSpace(1, dims, NULL);
-			dataspace = dst_tally.getSpace();
-			dataspace.selectHyperslab(H5S_SELECT_SET, count, offset, stride, block);
-			std::vector<uint32_t> continiousBuffer(tallyLength * m_alphabet.size());
-			for (uint32_t i = 0; i < m_alphabet.size(); i++)
-			{
-				auto bufIter = continiousBuffer.begin() + i;
-				for (auto it = m_tally[i].begin(); it != m_tally[i].end(); ++it)
-				{
-					*bufIter = *it;
-					bufIter += m_alphabet.size();
-				}				
-			}
-			dst_tally.write((void*)&*continiousBuffer.begin(), 
-							m_fileDataTypes[DatasetNames.m_tally], 
-							memspace, dataspace);
-			tallyPosition += tallyLength;
-			for (auto it = m_tally.begin(); it != m_tally.end(); ++it)
-				(*it).clear();
-		}
-	}
-	// debug store complete suffixArray
-	 //dims[0] = m_N;
-	 //dataspace = DataSpace(1, dims);
-	 //properties.setChunk(1, chunkDims);
-	 //properties.setDeflate(3);
-	 //DataSet dst_suffixArray = grpIndex.createDataSet(DatasetNames.m_suffixArray, 
-		//										  m_fileDataTypes[DatasetNames.m_suffixArray], 
-		//										  dataspace, properties);
-	 //memspace = DataSpace(1, dims, NULL);
-	 //dst_suffixArray.write((void*)&*m_suffixArray.begin(),
-		//				    m_fileDataTypes[DatasetNames.m_suffixArray],
-		//				    memspace, dataspace);
-	// end of debug
-	dst_bwtFirst.close();
-	dst_bwtLast.close();
-	dst_suffixArraySample.close();
-	// dst_suffixArray.close();
-	dst_tally.close();
-	m_settings.logging().log(e_logInfo, "Finished writing index to disk.");
-	// done, file is closed by destructor
-}
-
-
-
-
-// get position from suffix array sample
-int64_t 
-fmIndex::getPositionFromRow
-(
-	uint32_t row
-)
-{
-	indexValuePair cmpVal;
-	cmpVal.index = row;
-	auto it = std::lower_bound(m_suffixArraySample.begin(),
-		m_suffixArraySample.end(),
-		cmpVal,
-		[](indexValuePair lhs, indexValuePair rhs) -> bool{return lhs.index < rhs.index; });
-	const uint32_t SaSampleStepSize = m_settings.m_saSampleStepSize;
-	uint32_t steps = 0;
-	while ((*it).index != cmpVal.index)
-	{
-		const char currentChar = m_bwtLast[cmpVal.index];
-		uint32_t currentCount = getCount(currentChar, cmpVal.index);
-		uint32_t currentRank = currentCount - 1;		// count will always be > 0
-		cmpVal.index = getRowFromRank(currentChar, currentRank);
-		it = std::lower_bound(m_suffixArraySample.begin(),
-			m_suffixArraySample.end(),
-			cmpVal,
-			[](indexValuePair lhs, indexValuePair rhs) -> bool{return lhs.index < rhs.index; });
-		if (it == m_suffixArraySample.end())
-		{
-			it--;
-		}
-		steps++;
-		if (steps > SaSampleStepSize + 1)
-		{
-			// should not happen, ...
-			m_settings.logging().log(e_logError, "Error while looking up suffix array sample. Please contact development.");
-			return -1;
-		}
-	}
-	return (*it).value + steps;
-}
-
-
-
-
-// process chunk of suffix array
-void 
-fmIndex::processChunk
-(
-	std::string const & s,
-	std::vector<uint32_t> const & sfx, 
-	const uint32_t offset
-)
-{
-	// expand bwt
-	auto bwtOffset = m_bwtLast.size();
-	m_bwtLast.resize(m_bwtLast.size() + sfx.size());
-	bwtFromSA(s, sfx, m_bwtLast, bwtOffset);
-
-	// expand suffix array sample
-	auto index = offset;
-	auto SaSampleStepSize = m_settings.m_saSampleStepSize;
-	for (auto it = sfx.begin(); it != sfx.end(); ++it)
-	{
-		if ((*it) % SaSampleStepSize == 0)
-		{
-			indexValuePair p;
-			p.index = index;
-			p.value = *it;
-			m_suffixArraySample.push_back(p);
-		}
-		index++;
-	}
-
-	// init tally on first call
-	static std::vector<uint32_t> tallyLine;
-	if (offset == 0)
-	{
-		tallyLine = std::vector<uint32_t>(m_alphabet.size(), 0);
-	}
-		
-	// expand tally
-	index = offset;
-	const uint32_t TallyStepSize = m_settings.m_tallyStepSize;
-	for (auto it = m_bwtLast.begin() + bwtOffset; it != m_bwtLast.end(); ++it)
-	{
-		if ((*it) != '$')
-			tallyLine[m_charIndex[*it]]++;
-		if (index % TallyStepSize == 0)
-		{
-			for (uint32_t j = 0; j < m_alphabet.size(); j++)
-				m_tally[j].push_back(tallyLine[j]);
-		}
-		index++;
-	}
-}
-
-
-
-
-// init file datatypes
-void 
-fmIndex::initTallyDatatype
-(
-	 std::string alphabet
-)
-{
-	if (m_fileDataTypes.find(DatasetNames.m_tally) != m_fileDataTypes.end())
-		m_fileDataTypes.erase(DatasetNames.m_tally);
-	// m_tally
-	CompType memType(sizeof(uint32_t) * alphabet.size());
-	for (size_t i = 0; i < alphabet.size(); i++)
-		memType.insertMember(alphabet.substr(i, 1), i * sizeof(uint32_t), PredType::NATIVE_UINT32);
-	m_fileDataTypes[DatasetNames.m_tally] = memType;
-}
-
-
-
-
-// clear all members
-void 
-fmIndex::clearDataStructures
-(
-	void
-)
-{
-	this->m_charIndex = std::vector<uint8_t>(256, 255);
-	this->m_alphabet.clear();
-	this->m_bwtFirst.clear();
-	this->m_bwtLast.clear();
-	this->m_tally.clear();
-	this->m_suffixArraySample.clear();
-}
-
-
-
-
-void
-bwtFromSA
-(
-	const std::string& S,
-	std::vector<uint32_t> const& sa,
-	std::string& bwt,
-	size_t bwtOffset
-)
-{
-	for (size_t i = 0; i < sa.size(); i++)
-	{
-		if (sa[i] == 0)
-			bwt[bwtOffset + i] = *(S.rbegin());
-		else
-			bwt[bwtOffset + i] = S[sa[i] - 1];
-	}
-}
-
-
-
-
-herr_t 
-getGroupDatasetNames
-(
-	hid_t loc_id, 
-	const char* name, 
-	const H5L_info_t *linfo, 
-	void* opdata
-)
-{
-	auto dsNames = reinterpret_cast<std::vector<std::string>*>(opdata);
-	hid_t ds = H5Dopen2(loc_id, name, H5P_DEFAULT);
-	if (ds > 0)
-		dsNames->push_back(name);
-	H5Dclose(ds);
-	return 0;
-}
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class FM-Index
+//
+//  DESCRIPTION   :	FM-Index
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <cstring>
+#include <boost/filesystem.hpp>
+
+//-- private headers -----------------------------------------------------
+#include "fmIndex.h"
+#include "suffixArray.h"
+#include "suffixArraySAIS.h"
+#include "fileFastx.h"
+using namespace H5;
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const uint32_t BwtLastDiskChunkSize = 1024000;			// Size of compressed chunks in hdf5 file
+const char NativeIndexMagic[8] = { 'S', 'E', 'L', 'F', 'M', 'I', '1', '\0' };	// first bytes of native index
+const uint32_t NativeIndexVersion = 4;					// version of native index layout
+const uint64_t NativeSectionAlignment = 4096;			// page alignment of sections in native index
+const uint32_t MaxKmerTableLength = 14;					// 2 GB table of k-mer intervals
+const char KmerAlphabet[] = "ACGT";						// characters of k-mer table in code order
+
+
+const struct DatasetNames
+{
+	const std::string m_bwtFirst = "FirstColumn";
+	const std::string m_bwtLast = "LastColumn";
+	const std::string m_bwtLastPacked = "LastColumnPacked";
+	const std::string m_bwtExceptions = "LastColumnExceptions";
+	const std::string m_tally = "Tally";
+	const std::string m_suffixArraySample = "SuffixArraySample";
+	const std::string m_suffixArray = "SuffixArray";
+	const std::string m_kmerIntervals = "KmerIntervals";
+	const std::string m_textPacked = "TextPacked";
+	const std::string m_textExceptions = "TextExceptions";
+}DatasetNames;
+
+
+const struct GroupNames
+{
+	const std::string m_Index = "Index";
+	const std::string m_Subsequences = "Subsequences";
+}GroupNames;
+
+
+//-- private types -------------------------------------------------------
+typedef struct indexValuePair
+{
+	uint32_t index;
+	uint32_t value;
+}indexValuePair;
+
+
+typedef struct IndexFileFirstColumn
+{
+	char chr;
+	uint32_t count;
+}IndexFileFirstColumn;
+
+
+// sections of native index file, each starting at page boundary
+enum NativeIndexSection
+{
+	e_nativeChapters = 0,			// offset, name length and name of chapters
+	e_nativeFirstColumn,			// character and count pairs of first column
+	e_nativeOccurrence,				// blocks of occurrence table
+	e_nativeExceptions,				// row, length and character of packed exception runs
+	e_nativeSampledRows,			// rank bitvector of sampled rows
+	e_nativeSamplePositions,		// text positions of sampled rows in row order
+	e_nativeSampleRows,				// sampled rows in text position order
+	e_nativeKmerIntervals,			// first and end row of all k-mers
+	e_nativeTextPacked,				// 2-bit packed forward text
+	e_nativeTextExceptions,			// position, length and character of text exception runs
+	e_nativeSectionCount
+};
+
+
+// first page of native index, all values in native byte order
+typedef struct NativeIndexHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t N;
+	uint32_t saSampleStepSize;
+	uint32_t tallyStepSize;
+	uint32_t packedBwt;
+	uint32_t alphabetSize;
+	uint32_t sampleCount;
+	uint32_t sampleRowCount;
+	uint32_t kmerLength;
+	uint32_t reserved;
+	uint64_t sourceSize;			// size of hdf5 index converted from
+	int64_t sourceTime;				// modification time of hdf5 index
+	uint64_t offset[e_nativeSectionCount];
+	uint64_t size[e_nativeSectionCount];
+}NativeIndexHeader;
+
+
+// state of backward search of a single pattern
+typedef struct backwardSearchState
+{
+	uint32_t pattern;				// index of pattern in batch
+	int64_t suffixStart;			// next character to extend
+	uint32_t rowStart;				// first row of matching suffix range
+	uint32_t rowStop;				// end of matching suffix range
+}backwardSearchState;
+
+
+// state of suffix array lookup of a single row
+typedef struct locateState
+{
+	uint32_t pattern;				// index of pattern in batch
+	uint32_t row;					// current row of LF walk
+	uint32_t steps;					// LF steps taken from initial row
+}locateState;
+
+
+//-- private functions --------- declarations ----------------------------
+void appendUint32(std::string& buffer, const uint32_t value);
+uint32_t readUint32(const char* data);
+void bwtFromSA(const std::string& S, std::vector<uint32_t> const& sa, std::string& bwt, size_t bwtOffset);
+herr_t getGroupDatasetNames(hid_t loc_id, const char* name, const H5L_info_t *linfo, void* opdata);
+std::vector<std::pair<std::string, uint32_t>> chapterLengths(std::map<uint32_t, std::string> const & nameOffset, size_t totalLength);
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor loading index from disk
+fmIndex::fmIndex
+(
+	fmIndex_settings& settings,
+	std::string indexFileName	
+) : m_settings(settings)
+{
+	init();
+	load(indexFileName);
+}
+
+
+
+
+// virtual destructor
+fmIndex::~fmIndex()
+{
+	this->clearDataStructures();
+}
+
+
+
+
+// allocate memory of input string
+void 
+fmIndex::allocateMemory
+(
+	std::string& str, 
+	uint32_t expectedSize
+)
+{
+	// reserve memory for string and appending $ at the end
+	str.reserve(expectedSize + 1);
+}
+
+
+
+
+// build index
+void 
+fmIndex::build
+(
+	fmIndex_settings& settings,
+	std::string& str,
+	std::string outputFilename
+)
+{
+	fmIndex workingIndex;
+	str.append("$");
+	workingIndex.m_settings = settings;
+	workingIndex.buildIndex(str, outputFilename);
+	if (settings.m_kmerTableLength > 0)
+		workingIndex.addKmerIntervals(outputFilename);
+	if (settings.m_packedText)
+		workingIndex.addPackedText(str, outputFilename);
+}
+
+
+
+
+// build index using chapters
+void 
+fmIndex::build
+(
+	fmIndex_settings& settings,
+	std::string& str, 
+	std::string outputFilename, 
+	std::map<uint32_t, std::string> chapters
+)
+{
+	fmIndex workingIndex;
+	str.append("$");
+	workingIndex.m_settings = settings;
+	workingIndex.m_nameOffset = chapters;
+	workingIndex.buildIndex(str, outputFilename);
+	if (settings.m_kmerTableLength > 0)
+		workingIndex.addKmerIntervals(outputFilename);
+	if (settings.m_packedText)
+		workingIndex.addPackedText(str, outputFilename);
+}
+
+
+
+
+// load existing index from disk
+void 
+fmIndex::load
+(
+	std::string indexFile
+)
+{
+	clearDataStructures();
+	m_nameOffset.clear();
+	// native index files are mapped instead of read
+	char magic[sizeof(NativeIndexMagic)];
+	std::ifstream indexStream(indexFile, std::ios::binary);
+	if (indexStream.read(magic, sizeof(magic)) && std::equal(magic, magic + sizeof(magic), NativeIndexMagic))
+	{
+		indexStream.close();
+		// reject native index not converted from the hdf5 index next to it
+		const boost::filesystem::path sourceFile = boost::filesystem::path(indexFile).replace_extension(".h5");
+		if (boost::filesystem::path(indexFile).extension() == ".fmi" && boost::filesystem::exists(sourceFile) &&
+			!isNativeCurrent(indexFile, sourceFile.string()))
+			throw std::invalid_argument("Index " + indexFile + " does not match " + sourceFile.string() + ", convert it again");
+		loadNative(indexFile);
+		return;
+	}
+	indexStream.close();
+	boost::system::error_code ec;
+	m_sourceSize = boost::filesystem::file_size(indexFile, ec);
+	m_sourceTime = ec ? 0 : boost::filesystem::last_write_time(indexFile, ec);
+	Exception::dontPrint();
+	try
+	{
+		// open file
+		H5File file(indexFile, H5F_ACC_RDONLY);
+		auto grpSubsequences = file.openGroup(GroupNames.m_Subsequences);
+		std::vector<std::string> subsequenceNames;
+		H5Literate(grpSubsequences.getId(),
+					H5_INDEX_NAME, H5_ITER_INC, NULL,
+					getGroupDatasetNames, &subsequenceNames);
+
+		// read settings from root attributes
+		uint32_t attr_data[1];
+		Attribute attr = file.openAttribute("suffixSample");
+		attr.read(PredType::NATIVE_UINT32, &attr_data);
+		m_settings.set_m_saSampleStepSize(attr_data[0]);
+		attr = file.openAttribute("tallyStep");
+		attr.read(PredType::NATIVE_UINT32, &attr_data);
+		m_settings.set_m_tallyStepSize(attr_data[0]);
+
+		// read names and offsets of subsequences
+		for (auto it = subsequenceNames.begin(); it != subsequenceNames.end(); ++it)
+		{
+			auto dst = grpSubsequences.openDataSet(*it);
+			uint32_t offset;
+			hsize_t dims[] = { 1 };
+			DataSpace dataspace(1, dims);
+			dst.read(&offset, PredType::NATIVE_UINT32, dataspace);
+			m_nameOffset[offset] = *it;
+		}
+
+		// read bwtFirst
+		auto grpIndex = file.openGroup(GroupNames.m_Index);
+		auto dataset = grpIndex.openDataSet(DatasetNames.m_bwtFirst);
+		auto dataspace = H5Dget_space(dataset.getId());
+		hsize_t dim;
+		H5Sget_simple_extent_dims(dataspace, &dim, NULL);
+		auto bwtFirstData = std::vector<IndexFileFirstColumn>(dim);
+		dataset.read((void*)&*bwtFirstData.begin(), m_fileDataTypes[DatasetNames.m_bwtFirst]);
+		uint8_t charIndex = 0;
+		uint32_t firstRow = 1;
+		for (auto it = bwtFirstData.begin(); it != bwtFirstData.end(); ++it)
+		{
+			m_alphabet.push_back((*it).chr);
+			m_charIndex[(*it).chr] = charIndex++;
+			m_bwtFirst.push_back((*it).count);
+			m_firstRow[static_cast<uint8_t>((*it).chr)] = firstRow;
+			firstRow += (*it).count;
+		}
+
+		// read bwtLast, either plain or 2-bit packed with exception runs
+		m_settings.m_packedBwt = H5Lexists(grpIndex.getId(), DatasetNames.m_bwtLastPacked.c_str(), H5P_DEFAULT) > 0;
+		std::vector<uint8_t> bwtLastPacked;
+		if (m_settings.m_packedBwt)
+		{
+			m_N = 1;
+			for (auto it = m_bwtFirst.begin(); it != m_bwtFirst.end(); ++it)
+				m_N += *it;
+			dataset = grpIndex.openDataSet(DatasetNames.m_bwtLastPacked);
+			dataspace = H5Dget_space(dataset.getId());
+			H5Sget_simple_extent_dims(dataspace, &dim, NULL);
+			bwtLastPacked.resize(dim);		// may throw bad_alloc
+			dataset.read((void*)&*bwtLastPacked.begin(), m_fileDataTypes[DatasetNames.m_bwtLastPacked]);
+			dataset = grpIndex.openDataSet(DatasetNames.m_bwtExceptions);
+			dataspace = H5Dget_space(dataset.getId());
+			H5Sget_simple_extent_dims(dataspace, &dim, NULL);
+			m_bwtExceptions.resize(dim);
+			if (dim)
+				dataset.read((void*)&*m_bwtExceptions.begin(), m_fileDataTypes[DatasetNames.m_bwtExceptions]);
+		}
+		else
+		{
+			dataset = grpIndex.openDataSet(DatasetNames.m_bwtLast);
+			dataspace = H5Dget_space(dataset.getId());
+			H5Sget_simple_extent_dims(dataspace, &dim, NULL);
+			m_bwtLast.resize(dim);				// may throw bad_alloc
+			dataset.read((void*)&*m_bwtLast.begin(), m_fileDataTypes[DatasetNames.m_bwtLast]);
+			m_N = dim;
+		}
+
+		// read optional k-mer interval table, k is given by its size
+		m_settings.m_kmerTableLength = 0;
+		if (H5Lexists(grpIndex.getId(), DatasetNames.m_kmerIntervals.c_str(), H5P_DEFAULT) > 0)
+		{
+			dataset = grpIndex.openDataSet(DatasetNames.m_kmerIntervals);
+			dataspace = H5Dget_space(dataset.getId());
+			H5Sget_simple_extent_dims(dataspace, &dim, NULL);
+			while (m_settings.m_kmerTableLength < MaxKmerTableLength && (2ULL << (2 * m_settings.m_kmerTableLength)) < dim)
+				m_settings.m_kmerTableLength++;
+			if ((2ULL << (2 * m_settings.m_kmerTableLength)) != dim || m_settings.m_kmerTableLength == 0)
+				throw std::invalid_argument("Index " + indexFile + " corrupted");
+			m_kmerIntervalData.resize(dim);		// may throw bad_alloc
+			dataset.read((void*)&*m_kmerIntervalData.begin(), m_fileDataTypes[DatasetNames.m_kmerIntervals]);
+			m_kmerIntervals = m_kmerIntervalData.data();
+		}
+
+		// read optional packed text
+		if (H5Lexists(grpIndex.getId(), DatasetNames.m_textPacked.c_str(), H5P_DEFAULT) > 0)
+		{
+			dataset = grpIndex.openDataSet(DatasetNames.m_textPacked);
+			dataspace = H5Dget_space(dataset.getId());
+			H5Sget_simple_extent_dims(dataspace, &dim, NULL);
+			std::vector<uint8_t> textPacked(dim);		// may throw bad_alloc
+			dataset.read((void*)&*textPacked.begin(), m_fileDataTypes[DatasetNames.m_textPacked]);
+			dataset = grpIndex.openDataSet(DatasetNames.m_textExceptions);
+			dataspace = H5Dget_space(dataset.getId());
+			H5Sget_simple_extent_dims(dataspace, &dim, NULL);
+			std::vector<bwtExceptionRun> textExceptions(dim);
+			if (dim)
+				dataset.read((void*)&*textExceptions.begin(), m_fileDataTypes[DatasetNames.m_textExceptions]);
+			m_packedText.build(textPacked, m_N, textExceptions);
+		}
+
+		// read suffix array sample
+		dataset = grpIndex.openDataSet(DatasetNames.m_suffixArraySample);
+		dataspace = H5Dget_space(dataset.getId());
+		H5Sget_simple_extent_dims(dataspace, &dim, NULL);
+		m_suffixArraySample.resize(dim);	// may throw bad_alloc
+		dataset.read((void*)&*m_suffixArraySample.begin(), m_fileDataTypes[DatasetNames.m_suffixArraySample]);
+
+		// read suffix array
+		//dataset = grpIndex.openDataSet(DatasetNames.m_suffixArray);
+		//dataspace = H5Dget_space(dataset.getId());
+		//H5Sget_simple_extent_dims(dataspace, &dim, NULL);
+		//m_suffixArray.resize(dim);	// may throw bad_alloc
+		//dataset.read((void*)&*m_suffixArray.begin(), m_fileDataTypes[DatasetNames.m_suffixArray]);
+
+		// convert suffix array sample to bitvector of sampled rows, positions 
+		// in row order and rows in position order
+		std::vector<uint32_t> sampledRows;
+		sampledRows.reserve(m_suffixArraySample.size());
+		m_samplePositionData.reserve(m_suffixArraySample.size());
+		m_sampleRowData.assign(m_N / m_settings.m_saSampleStepSize + 1, 0);
+		for (auto it = m_suffixArraySample.begin(); it != m_suffixArraySample.end(); ++it)
+		{
+			if ((*it).value >= m_N || (*it).value % m_settings.m_saSampleStepSize != 0)
+				throw std::invalid_argument("Index " + indexFile + " corrupted");
+			sampledRows.push_back((*it).index);
+			m_samplePositionData.push_back((*it).value);
+			m_sampleRowData[(*it).value / m_settings.m_saSampleStepSize] = (*it).index;
+		}
+		m_sampledRows.build(sampledRows, m_N);
+		m_samplePositions = m_samplePositionData.data();
+		m_sampleCount = static_cast<uint32_t>(m_samplePositionData.size());
+		m_sampleRows = m_sampleRowData.data();
+		m_sampleRowCount = static_cast<uint32_t>(m_sampleRowData.size());
+		std::vector<indexValuePair>().swap(m_suffixArraySample);
+		
+		// convert last column to occurrence blocks, the block counts
+		// replace the tally checkpoints stored on disk
+		if (m_settings.m_packedBwt)
+		{
+			m_packedOccurrenceTable.build(bwtLastPacked, m_N, m_bwtExceptions, m_alphabet);
+			std::vector<bwtExceptionRun>().swap(m_bwtExceptions);
+		}
+		else
+		{
+			m_occurrenceTable.build(m_bwtLast, m_charIndex, static_cast<uint8_t>(m_alphabet.size()));
+			std::string().swap(m_bwtLast);
+		}
+	}
+	catch (Exception& ex)
+	{
+		if (ex.getDetailMsg().find("H5Fopen") != std::string::npos)
+			throw std::invalid_argument("Index " + indexFile + " not found");
+		else
+			throw std::invalid_argument("Index " + indexFile + " corrupted");
+	}
+	// memory allocation exceptions are left untouched
+}
+
+
+
+
+// write loaded index in native format for memory mapping
+void
+fmIndex::saveNative
+(
+	std::string indexFile
+)
+{
+	// serialize small sections, large sections are written in place
+	std::string chapters;
+	for (auto it = m_nameOffset.begin(); it != m_nameOffset.end(); ++it)
+	{
+		appendUint32(chapters, (*it).first);
+		appendUint32(chapters, static_cast<uint32_t>((*it).second.size()));
+		chapters.append((*it).second);
+	}
+	std::string firstColumn;
+	for (size_t i = 0; i < m_alphabet.size(); i++)
+	{
+		appendUint32(firstColumn, static_cast<uint8_t>(m_alphabet[i]));
+		appendUint32(firstColumn, m_bwtFirst[i]);
+	}
+	std::string exceptions;
+	const uint64_t* occurrenceData = m_occurrenceTable.data();
+	size_t occurrenceWords = m_occurrenceTable.words();
+	if (m_settings.m_packedBwt)
+	{
+		auto runs = m_packedOccurrenceTable.getExceptions();
+		for (auto it = runs.begin(); it != runs.end(); ++it)
+		{
+			appendUint32(exceptions, (*it).row);
+			appendUint32(exceptions, (*it).length);
+			appendUint32(exceptions, static_cast<uint8_t>((*it).chr));
+		}
+		occurrenceData = m_packedOccurrenceTable.data();
+		occurrenceWords = m_packedOccurrenceTable.words();
+	}
+	std::vector<std::pair<const char*, uint64_t>> sections(e_nativeSectionCount);
+	sections[e_nativeChapters] = std::make_pair(chapters.data(), chapters.size());
+	sections[e_nativeFirstColumn] = std::make_pair(firstColumn.data(), firstColumn.size());
+	sections[e_nativeOccurrence] = std::make_pair(reinterpret_cast<const char*>(occurrenceData), occurrenceWords * sizeof(uint64_t));
+	sections[e_nativeExceptions] = std::make_pair(exceptions.data(), exceptions.size());
+	sections[e_nativeSampledRows] = std::make_pair(reinterpret_cast<const char*>(m_sampledRows.data()), m_sampledRows.words() * sizeof(uint64_t));
+	sections[e_nativeSamplePositions] = std::make_pair(reinterpret_cast<const char*>(m_samplePositions), m_sampleCount * sizeof(uint32_t));
+	sections[e_nativeSampleRows] = std::make_pair(reinterpret_cast<const char*>(m_sampleRows), m_sampleRowCount * sizeof(uint32_t));
+	const uint64_t kmerIntervals = m_kmerIntervals == NULL ? 0 : 2ULL << (2 * m_settings.m_kmerTableLength);
+	sections[e_nativeKmerIntervals] = std::make_pair(reinterpret_cast<const char*>(m_kmerIntervals), kmerIntervals * sizeof(uint32_t));
+	std::string textExceptions;
+	auto const & textRuns = m_packedText.getExceptions();
+	for (auto it = textRuns.begin(); it != textRuns.end(); ++it)
+	{
+		appendUint32(textExceptions, (*it).row);
+		appendUint32(textExceptions, (*it).length);
+		appendUint32(textExceptions, static_cast<uint8_t>((*it).chr));
+	}
+	sections[e_nativeTextPacked] = std::make_pair(reinterpret_cast<const char*>(m_packedText.data()), m_packedText.bytes());
+	sections[e_nativeTextExceptions] = std::make_pair(textExceptions.data(), textExceptions.size());
+
+	// header in first page, sections start at following page boundaries
+	NativeIndexHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, NativeIndexMagic, sizeof(NativeIndexMagic));
+	header.version = NativeIndexVersion;
+	header.N = m_N;
+	header.saSampleStepSize = m_settings.m_saSampleStepSize;
+	header.tallyStepSize = m_settings.m_tallyStepSize;
+	header.packedBwt = m_settings.m_packedBwt ? 1 : 0;
+	header.alphabetSize = static_cast<uint32_t>(m_alphabet.size());
+	header.sampleCount = m_sampleCount;
+	header.sampleRowCount = m_sampleRowCount;
+	header.kmerLength = m_kmerIntervals == NULL ? 0 : m_settings.m_kmerTableLength;
+	header.sourceSize = m_sourceSize;
+	header.sourceTime = m_sourceTime;
+	uint64_t offset = NativeSectionAlignment;
+	for (size_t i = 0; i < sections.size(); i++)
+	{
+		header.offset[i] = offset;
+		header.size[i] = sections[i].second;
+		offset += (sections[i].second + NativeSectionAlignment - 1) / NativeSectionAlignment * NativeSectionAlignment;
+	}
+
+	// write sections with zero padding
+	std::ofstream outputStream(indexFile, std::ios::binary | std::ios::trunc);
+	if (!outputStream.is_open())
+		throw std::invalid_argument("Could not open " + indexFile + " for writing");
+	const std::vector<char> padding(NativeSectionAlignment, 0);
+	outputStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	uint64_t position = sizeof(header);
+	for (size_t i = 0; i < sections.size(); i++)
+	{
+		outputStream.write(&*padding.begin(), header.offset[i] - position);
+		outputStream.write(sections[i].first, sections[i].second);
+		position = header.offset[i] + sections[i].second;
+	}
+	outputStream.close();
+	if (outputStream.fail())
+		throw std::invalid_argument("Failed to write index " + indexFile);
+}
+
+
+
+
+// return complete index sequence
+std::string
+fmIndex::getIndexSequence(void)
+{
+	std::string ref;
+	ref.reserve(m_N);
+	char currentChar = '$';
+	uint32_t currentRow = 0;
+	for (uint32_t i = 0; i < m_N; i++)
+	{
+		currentChar = getLastColumn(currentRow);
+		ref.append(1,currentChar);
+		uint32_t currentCharCount = getCount(currentChar, currentRow);
+		currentRow = getRowFromRank(currentChar, currentCharCount - 1);
+	}
+	std::reverse(ref.begin(), ref.end());
+	return ref;
+}
+
+
+
+
+// get substr of index sequence
+std::string
+fmIndex::getIndexSequence
+(
+	uint32_t startIdx, 
+	uint32_t length
+)
+{
+	if (startIdx + length >= m_N)
+		throw std::out_of_range("Requested string out of index range");
+	if (m_packedText.size() > 0)
+		return m_packedText.getSequence(startIdx, length);
+	// start at next sampled position
+	uint32_t lokkupStartIdx = startIdx + length;
+	uint32_t checkPointIdx;
+	checkPointIdx = lokkupStartIdx + (m_settings.m_saSampleStepSize - lokkupStartIdx % m_settings.m_saSampleStepSize);
+	// row zero is the suffix of the terminal character at m_N - 1
+	uint32_t currentRow = 0;
+	if (checkPointIdx < m_N)
+		currentRow = m_sampleRows[checkPointIdx / m_settings.m_saSampleStepSize];
+	else
+		checkPointIdx = m_N - 1;
+	// reconstruct ref string from bwt, preceding character of each row
+	std::string index;
+	index.reserve(checkPointIdx - startIdx);
+	for (uint32_t i = checkPointIdx; i > startIdx; i--)
+	{
+		char currentChar = getLastColumn(currentRow);
+		index.append(1, currentChar);
+		uint32_t currentCharCount = getCount(currentChar, currentRow);
+		currentRow = getRowFromRank(currentChar, currentCharCount - 1);	
+	}
+	std::reverse(index.begin(), index.end());
+	return index.substr(0, length);
+}
+
+
+
+
+// return vector containing all occurences of pattern in index
+std::vector<uint32_t> 
+fmIndex::getMatchingPositions
+(
+	std::string const & pattern
+)
+{
+	return getMatchingPositions(pattern, UINT32_MAX);
+}
+
+
+
+
+// limit matching positions for performance reasons
+std::vector<uint32_t>
+fmIndex::getMatchingPositions
+(
+	std::string const & pattern, 
+	const uint32_t maxResults
+)
+{
+	// range for last k-mer or character in pattern
+	int64_t suffixStart = pattern.size() - 1;
+	uint32_t rowStart, rowStop;
+	startBackwardSearch(pattern, 0, suffixStart, rowStart, rowStop);
+	// range for following characters
+	while (suffixStart >= 0 && rowStop > rowStart)
+	{
+		const char currentChar = pattern[suffixStart];
+		uint32_t startCount = 0;
+		if (rowStart > 0)
+			startCount = getCount(currentChar, rowStart - 1);
+		uint32_t stopCount = getCount(currentChar, rowStop - 1);
+		if (stopCount > startCount)
+		{
+			uint32_t startRank = startCount;
+			uint32_t stopRank = stopCount;
+			rowStart = getRowFromRank(currentChar, startRank);
+			rowStop = getRowFromRank(currentChar, stopRank);
+			suffixStart--;
+		}
+		else
+			break;
+	}
+	// get positions of matches
+	std::vector<uint32_t> results;
+	if (maxResults >= rowStop - rowStart)
+	{
+		results.reserve(rowStop - rowStart);
+		for (auto i = rowStart; i < rowStop; i++)
+		{
+			auto position = getPositionFromRow(i);
+			if (position >= 0)
+				results.push_back(position);
+		}
+		std::sort(results.begin(), results.end());
+	}
+	return results;
+}
+
+
+
+
+// limit matching positions of all patterns, the backward searches and
+// suffix array lookups advance in lock-step and prefetch the rows of their
+// next step, cache misses of different patterns overlap
+std::vector<std::vector<uint32_t>>
+fmIndex::getMatchingPositions
+(
+	std::vector<std::string> const & patterns,
+	const uint32_t maxResults
+)
+{
+	// range for last k-mer or character in each pattern
+	std::vector<backwardSearchState> searches;
+	searches.reserve(patterns.size());
+	for (uint32_t i = 0; i < patterns.size(); i++)
+	{
+		if (patterns[i].empty())
+			continue;
+		backwardSearchState search;
+		search.pattern = i;
+		search.suffixStart = patterns[i].size() - 1;
+		startBackwardSearch(patterns[i], 0, search.suffixStart, search.rowStart, search.rowStop);
+		if (search.rowStop <= search.rowStart)
+			continue;
+		if (search.rowStart > 0)
+			prefetchRow(search.rowStart - 1);
+		prefetchRow(search.rowStop - 1);
+		searches.push_back(search);
+	}
+
+	// extend all active searches by one character per round, finished
+	// searches are swapped behind the active ones
+	size_t active = searches.size();
+	while (active > 0)
+	{
+		size_t next = 0;
+		for (size_t i = 0; i < active; i++)
+		{
+			backwardSearchState& search = searches[i];
+			if (search.suffixStart < 0 || search.rowStop <= search.rowStart)
+				continue;
+			const char currentChar = patterns[search.pattern][search.suffixStart];
+			uint32_t startCount = 0;
+			if (search.rowStart > 0)
+				startCount = getCount(currentChar, search.rowStart - 1);
+			uint32_t stopCount = getCount(currentChar, search.rowStop - 1);
+			if (stopCount > startCount)
+			{
+				search.rowStart = getRowFromRank(currentChar, startCount);
+				search.rowStop = getRowFromRank(currentChar, stopCount);
+				search.suffixStart--;
+				if (search.suffixStart >= 0)
+				{
+					if (search.rowStart > 0)
+						prefetchRow(search.rowStart - 1);
+					prefetchRow(search.rowStop - 1);
+					std::swap(searches[i], searches[next++]);
+				}
+			}
+		}
+		active = next;
+	}
+
+	// walk all matching rows to the next suffix array sample
+	std::vector<std::vector<uint32_t>> results(patterns.size());
+	std::vector<locateState> locates;
+	for (auto it = searches.begin(); it != searches.end(); ++it)
+	{
+		if (maxResults < (*it).rowStop - (*it).rowStart)
+			continue;
+		results[(*it).pattern].reserve((*it).rowStop - (*it).rowStart);
+		for (uint32_t row = (*it).rowStart; row < (*it).rowStop; row++)
+		{
+			locateState locate;
+			locate.pattern = (*it).pattern;
+			locate.row = row;
+			locate.steps = 0;
+			m_sampledRows.prefetch(row);
+			locates.push_back(locate);
+		}
+	}
+	const uint32_t SaSampleStepSize = m_settings.m_saSampleStepSize;
+	active = locates.size();
+	while (active > 0)
+	{
+		size_t next = 0;
+		for (size_t i = 0; i < active; i++)
+		{
+			locateState& locate = locates[i];
+			uint32_t sampleRank;
+			if (m_sampledRows.getRank(locate.row, sampleRank))
+				results[locate.pattern].push_back(m_samplePositions[sampleRank] + locate.steps);
+			else if (locate.steps > SaSampleStepSize)
+			{
+				// should not happen, ...
+				m_settings.logging().log(e_logError, "Error while looking up suffix array sample. Please contact development.");
+			}
+			else
+			{
+				const char currentChar = getLastColumn(locate.row);
+				uint32_t currentCount = getCount(currentChar, locate.row);
+				locate.row = getRowFromRank(currentChar, currentCount - 1);		// count will always be > 0
+				locate.steps++;
+				m_sampledRows.prefetch(locate.row);
+				prefetchRow(locate.row);
+				locates[next++] = locate;
+			}
+		}
+		active = next;
+	}
+	for (auto it = results.begin(); it != results.end(); ++it)
+		std::sort((*it).begin(), (*it).end());
+	return results;
+}
+
+
+
+
+// get position of longest common subsequence (lcs), the rightmost one
+// if several have maximal length. Ends of the pattern are scanned left to
+// right for windows of the required length. A window that does not occur
+// excludes all following ends up to its mismatch plus the window length,
+// a window that does occur is extended to a maximal exact match.
+std::vector<lcsDefinition>
+fmIndex::getLongestCommonSubsequence
+(
+	std::string const & pattern
+)
+{
+	std::vector<lcsDefinition> results;
+	if (pattern.empty())
+		return results;
+	const int64_t patternEnd = pattern.size() - 1;
+	int64_t lcsLength = 0;
+	int64_t lcsReadPos = 0;
+	uint32_t lcsStartRow = 0, lcsStopRow = 0;
+	// longest match ending with the pattern wins ties with all others
+	int64_t suffixStart = patternEnd;
+	uint32_t rowStart, rowStop;
+	startBackwardSearch(pattern, 0, suffixStart, rowStart, rowStop);
+	extendBackwardSearch(pattern, 0, suffixStart, rowStart, rowStop);
+	if (rowStart < rowStop)
+	{
+		lcsLength = patternEnd - suffixStart;
+		lcsReadPos = suffixStart + 1;
+		lcsStartRow = rowStart;
+		lcsStopRow = rowStop;
+	}
+	int64_t requiredLength = lcsLength + 1;
+	int64_t matchEnd = requiredLength - 1;
+	while (matchEnd < patternEnd)
+	{
+		// test window of required length
+		const int64_t windowStart = matchEnd - requiredLength + 1;
+		suffixStart = matchEnd;
+		startBackwardSearch(pattern, windowStart, suffixStart, rowStart, rowStop);
+		extendBackwardSearch(pattern, windowStart, suffixStart, rowStart, rowStop);
+		if (suffixStart >= windowStart)
+		{
+			matchEnd = suffixStart + requiredLength;
+			continue;
+		}
+		// extend to left maximal match, it has the same start for all longer ends
+		extendBackwardSearch(pattern, 0, suffixStart, rowStart, rowStop);
+		const int64_t matchStart = suffixStart + 1;
+		uint32_t matchStartRow = rowStart, matchStopRow = rowStop;
+		// find right end by exponential and binary search
+		int64_t failedEnd = patternEnd + 1;
+		int64_t step = 1;
+		bool bounded = false;
+		while (matchEnd + 1 < failedEnd)
+		{
+			const int64_t probeEnd = bounded ? matchEnd + (failedEnd - matchEnd) / 2 :
+											   std::min(matchEnd + step, patternEnd);
+			suffixStart = probeEnd;
+			startBackwardSearch(pattern, matchStart, suffixStart, rowStart, rowStop);
+			extendBackwardSearch(pattern, matchStart, suffixStart, rowStart, rowStop);
+			if (suffixStart < matchStart)
+			{
+				matchEnd = probeEnd;
+				matchStartRow = rowStart;
+				matchStopRow = rowStop;
+				step *= 2;
+			}
+			else
+			{
+				failedEnd = probeEnd;
+				bounded = true;
+			}
+		}
+		// later matches of equal length replace this one
+		lcsLength = matchEnd - matchStart + 1;
+		lcsReadPos = matchStart;
+		lcsStartRow = matchStartRow;
+		lcsStopRow = matchStopRow;
+		requiredLength = lcsLength;
+		matchEnd++;
+	}
+	for (auto i = lcsStartRow; i < lcsStopRow; i++)
+	{
+		auto indexStart = getPositionFromRow(i);
+		if (indexStart >= 0)
+		{
+			lcsDefinition result;
+			result.indexStart = indexStart;
+			result.strStart = lcsReadPos;
+			result.lcsLength = lcsLength;
+			results.push_back(result);
+		}
+	}
+	return results;
+}
+
+
+
+
+// return name and relative position in chapter
+std::pair<std::string, uint32_t> 
+fmIndex::getRelativePosition
+(
+	uint32_t absolutPosition
+)
+{
+	auto it = m_nameOffset.lower_bound(absolutPosition);
+	if (it != m_nameOffset.begin() && (*it).first != absolutPosition)
+		it = std::prev(it);	
+	return std::make_pair((*it).second, absolutPosition - (*it).first);
+}
+
+
+
+
+// optionally return names and lengths of chapters in order
+std::vector<std::pair<std::string, uint32_t>> 
+fmIndex::getChapters
+(
+	void
+)
+{
+	return chapterLengths(m_nameOffset, m_N);
+}
+
+
+
+
+// names and lengths of chapters read from index file without loading the index
+std::vector<std::pair<std::string, uint32_t>>
+fmIndex::readChapters
+(
+	std::string indexFile
+)
+{
+	std::map<uint32_t, std::string> nameOffset;
+	// native index, header and chapter section only
+	NativeIndexHeader header;
+	std::ifstream indexStream(indexFile, std::ios::binary);
+	if (indexStream.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+		std::equal(header.magic, header.magic + sizeof(NativeIndexMagic), NativeIndexMagic))
+	{
+		if (header.version != NativeIndexVersion)
+			throw std::invalid_argument("Index " + indexFile + " has unsupported version " + std::to_string(header.version));
+		std::string section(header.size[e_nativeChapters], '\0');
+		indexStream.seekg(header.offset[e_nativeChapters]);
+		if (!indexStream.read(&section[0], section.size()))
+			throw std::invalid_argument("Index " + indexFile + " corrupted");
+		for (size_t pos = 0; pos < section.size();)
+		{
+			if (section.size() - pos < 2 * sizeof(uint32_t))
+				throw std::invalid_argument("Index " + indexFile + " corrupted");
+			const uint32_t offset = readUint32(section.data() + pos);
+			const uint32_t length = readUint32(section.data() + pos + sizeof(uint32_t));
+			pos += 2 * sizeof(uint32_t);
+			if (section.size() - pos < length)
+				throw std::invalid_argument("Index " + indexFile + " corrupted");
+			nameOffset[offset] = section.substr(pos, length);
+			pos += length;
+		}
+		return chapterLengths(nameOffset, header.N);
+	}
+	indexStream.close();
+	// hdf5 index, length of text is given by the first column
+	Exception::dontPrint();
+	try
+	{
+		H5File file(indexFile, H5F_ACC_RDONLY);
+		auto grpSubsequences = file.openGroup(GroupNames.m_Subsequences);
+		std::vector<std::string> subsequenceNames;
+		H5Literate(grpSubsequences.getId(),
+					H5_INDEX_NAME, H5_ITER_INC, NULL,
+					getGroupDatasetNames, &subsequenceNames);
+		for (auto it = subsequenceNames.begin(); it != subsequenceNames.end(); ++it)
+		{
+			auto dst = grpSubsequences.openDataSet(*it);
+			uint32_t offset;
+			hsize_t dims[] = { 1 };
+			DataSpace dataspace(1, dims);
+			dst.read(&offset, PredType::NATIVE_UINT32, dataspace);
+			nameOffset[offset] = *it;
+		}
+		CompType firstColumnType(sizeof(IndexFileFirstColumn));
+		firstColumnType.insertMember("char", HOFFSET(IndexFileFirstColumn, chr), PredType::NATIVE_UINT8);
+		firstColumnType.insertMember("count", HOFFSET(IndexFileFirstColumn, count), PredType::NATIVE_UINT32);
+		auto dataset = file.openGroup(GroupNames.m_Index).openDataSet(DatasetNames.m_bwtFirst);
+		auto dataspace = H5Dget_space(dataset.getId());
+		hsize_t dim;
+		H5Sget_simple_extent_dims(dataspace, &dim, NULL);
+		H5Sclose(dataspace);
+		auto bwtFirstData = std::vector<IndexFileFirstColumn>(dim);
+		if (dim)
+			dataset.read((void*)&*bwtFirstData.begin(), firstColumnType);
+		size_t totalLength = 1;
+		for (auto it = bwtFirstData.begin(); it != bwtFirstData.end(); ++it)
+			totalLength += (*it).count;
+		return chapterLengths(nameOffset, totalLength);
+	}
+	catch (Exception& ex)
+	{
+		if (ex.getDetailMsg().find("H5Fopen") != std::string::npos)
+			throw std::invalid_argument("Index " + indexFile + " not found");
+		else
+			throw std::invalid_argument("Index " + indexFile + " corrupted");
+	}
+}
+
+
+
+
+// return length of indexed sequence
+uint32_t
+fmIndex::getLength
+(
+	void
+)
+{
+	return m_N;
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// constructor
+fmIndex::fmIndex
+() : m_charIndex(256, 0)
+{
+	init();
+}
+
+
+
+
+// init
+void
+fmIndex::init
+(
+
+)
+{
+	// init static file datatypes
+	// m_bwtLast
+	m_fileDataTypes[DatasetNames.m_bwtLast] = PredType::NATIVE_CHAR;
+	// m_bwtLastPacked
+	m_fileDataTypes[DatasetNames.m_bwtLastPacked] = PredType::NATIVE_UINT8;
+	// m_bwtExceptions
+	CompType exceptionType(sizeof(bwtExceptionRun));
+	exceptionType.insertMember("row", HOFFSET(bwtExceptionRun, row), PredType::NATIVE_UINT32);
+	exceptionType.insertMember("length", HOFFSET(bwtExceptionRun, length), PredType::NATIVE_UINT32);
+	exceptionType.insertMember("char", HOFFSET(bwtExceptionRun, chr), PredType::NATIVE_UINT8);
+	m_fileDataTypes[DatasetNames.m_bwtExceptions] = exceptionType;
+	// m_bwtFirst
+	CompType memType(sizeof(IndexFileFirstColumn));
+	memType.insertMember("char", HOFFSET(IndexFileFirstColumn, chr), PredType::NATIVE_UINT8);
+	memType.insertMember("count", HOFFSET(IndexFileFirstColumn, count), PredType::NATIVE_UINT32);
+	m_fileDataTypes[DatasetNames.m_bwtFirst] = memType;
+	// m_suffixArraySample
+	memType = CompType(sizeof(indexValuePair));
+	memType.insertMember("index", HOFFSET(indexValuePair, index), PredType::NATIVE_UINT32);
+	memType.insertMember("value", HOFFSET(indexValuePair, value), PredType::NATIVE_UINT32);
+	m_fileDataTypes[DatasetNames.m_suffixArraySample] = memType;
+	// m_suffixArray
+	m_fileDataTypes[DatasetNames.m_suffixArray] = PredType::NATIVE_UINT32;
+	// m_kmerIntervals
+	m_fileDataTypes[DatasetNames.m_kmerIntervals] = PredType::NATIVE_UINT32;
+	// m_textPacked and m_textExceptions
+	m_fileDataTypes[DatasetNames.m_textPacked] = PredType::NATIVE_UINT8;
+	m_fileDataTypes[DatasetNames.m_textExceptions] = exceptionType;
+	// symbol codes of k-mer table
+	m_kmerSymbol = std::vector<uint8_t>(256, 4);
+	for (uint8_t i = 0; i < 4; i++)
+		m_kmerSymbol[static_cast<uint8_t>(KmerAlphabet[i])] = i;
+	// add default chapter
+	m_nameOffset[0] = "default";
+}
+
+
+
+
+// true if native index was converted from the current hdf5 index
+bool
+fmIndex::isNativeCurrent
+(
+	std::string nativeFile,
+	std::string sourceFile
+)
+{
+	NativeIndexHeader header;
+	std::ifstream indexStream(nativeFile, std::ios::binary);
+	if (!indexStream.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+		!std::equal(header.magic, header.magic + sizeof(NativeIndexMagic), NativeIndexMagic) ||
+		header.version != NativeIndexVersion)
+		return false;
+	indexStream.close();
+	boost::system::error_code ec;
+	const uint64_t sourceSize = boost::filesystem::file_size(sourceFile, ec);
+	if (ec || header.sourceSize != sourceSize)
+		return false;
+	const int64_t sourceTime = boost::filesystem::last_write_time(sourceFile, ec);
+	if (ec || header.sourceTime != sourceTime)
+		return false;
+	// names and lengths of chapters include the text length N
+	return readChapters(nativeFile) == readChapters(sourceFile);
+}
+
+
+
+
+// map index in native format
+void
+fmIndex::loadNative
+(
+	std::string indexFile
+)
+{
+	m_mappedIndex.open(indexFile);
+	const char* base = m_mappedIndex.data();
+	const uint64_t fileSize = m_mappedIndex.size();
+	NativeIndexHeader header;
+	if (fileSize < sizeof(header))
+		throw std::invalid_argument("Index " + indexFile + " corrupted");
+	std::memcpy(&header, base, sizeof(header));
+	if (header.version != NativeIndexVersion)
+		throw std::invalid_argument("Index " + indexFile + " has unsupported version " + std::to_string(header.version));
+	for (size_t i = 0; i < e_nativeSectionCount; i++)
+	{
+		if (header.offset[i] % NativeSectionAlignment != 0 || header.offset[i] > fileSize ||
+			header.size[i] > fileSize - header.offset[i])
+			throw std::invalid_argument("Index " + indexFile + " corrupted");
+	}
+	if (header.saSampleStepSize == 0 ||
+		header.size[e_nativeFirstColumn] != header.alphabetSize * 2 * sizeof(uint32_t) ||
+		header.size[e_nativeExceptions] % (3 * sizeof(uint32_t)) != 0 ||
+		header.size[e_nativeSamplePositions] != header.sampleCount * sizeof(uint32_t) ||
+		header.size[e_nativeSampleRows] != header.sampleRowCount * sizeof(uint32_t) ||
+		header.sampleRowCount != header.N / header.saSampleStepSize + 1 ||
+		header.kmerLength > MaxKmerTableLength ||
+		header.size[e_nativeKmerIntervals] != (header.kmerLength ? (2ULL << (2 * header.kmerLength)) * sizeof(uint32_t) : 0) ||
+		(header.size[e_nativeTextPacked] != 0 && header.size[e_nativeTextPacked] != (static_cast<uint64_t>(header.N) + 3) / 4) ||
+		header.size[e_nativeTextExceptions] % (3 * sizeof(uint32_t)) != 0)
+		throw std::invalid_argument("Index " + indexFile + " corrupted");
+	m_settings.set_m_saSampleStepSize(header.saSampleStepSize);
+	m_settings.set_m_tallyStepSize(header.tallyStepSize);
+	m_settings.m_packedBwt = header.packedBwt != 0;
+	m_N = header.N;
+	m_sourceSize = header.sourceSize;
+	m_sourceTime = header.sourceTime;
+
+	// read names and offsets of subsequences
+	const char* section = base + header.offset[e_nativeChapters];
+	for (uint64_t pos = 0; pos < header.size[e_nativeChapters];)
+	{
+		if (header.size[e_nativeChapters] - pos < 2 * sizeof(uint32_t))
+			throw std::invalid_argument("Index " + indexFile + " corrupted");
+		const uint32_t offset = readUint32(section + pos);
+		const uint32_t length = readUint32(section + pos + sizeof(uint32_t));
+		pos += 2 * sizeof(uint32_t);
+		if (header.size[e_nativeChapters] - pos < length)
+			throw std::invalid_argument("Index " + indexFile + " corrupted");
+		m_nameOffset[offset] = std::string(section + pos, length);
+		pos += length;
+	}
+
+	// read first column
+	section = base + header.offset[e_nativeFirstColumn];
+	uint32_t firstRow = 1;
+	for (uint32_t i = 0; i < header.alphabetSize; i++)
+	{
+		const uint8_t chr = static_cast<uint8_t>(readUint32(section + 2 * i * sizeof(uint32_t)));
+		const uint32_t count = readUint32(section + (2 * i + 1) * sizeof(uint32_t));
+		m_alphabet.push_back(static_cast<char>(chr));
+		m_charIndex[chr] = static_cast<uint8_t>(i);
+		m_bwtFirst.push_back(count);
+		m_firstRow[chr] = firstRow;
+		firstRow += count;
+	}
+	if (firstRow != m_N)
+		throw std::invalid_argument("Index " + indexFile + " corrupted");
+
+	// use occurrence blocks and samples in place
+	const uint64_t* occurrenceData = reinterpret_cast<const uint64_t*>(base + header.offset[e_nativeOccurrence]);
+	const size_t occurrenceWords = header.size[e_nativeOccurrence] / sizeof(uint64_t);
+	if (m_settings.m_packedBwt)
+	{
+		section = base + header.offset[e_nativeExceptions];
+		std::vector<bwtExceptionRun> exceptions(header.size[e_nativeExceptions] / (3 * sizeof(uint32_t)));
+		for (size_t i = 0; i < exceptions.size(); i++)
+		{
+			exceptions[i].row = readUint32(section + 3 * i * sizeof(uint32_t));
+			exceptions[i].length = readUint32(section + (3 * i + 1) * sizeof(uint32_t));
+			exceptions[i].chr = static_cast<char>(readUint32(section + (3 * i + 2) * sizeof(uint32_t)));
+		}
+		m_packedOccurrenceTable.attach(occurrenceData, occurrenceWords, m_N, exceptions, m_alphabet);
+	}
+	else
+		m_occurrenceTable.attach(occurrenceData, occurrenceWords, m_N, static_cast<uint8_t>(m_alphabet.size()));
+	m_sampledRows.attach(reinterpret_cast<const uint64_t*>(base + header.offset[e_nativeSampledRows]),
+						 header.size[e_nativeSampledRows] / sizeof(uint64_t), m_N);
+	m_samplePositions = reinterpret_cast<const uint32_t*>(base + header.offset[e_nativeSamplePositions]);
+	m_sampleCount = header.sampleCount;
+	m_sampleRows = reinterpret_cast<const uint32_t*>(base + header.offset[e_nativeSampleRows]);
+	m_sampleRowCount = header.sampleRowCount;
+	m_settings.m_kmerTableLength = header.kmerLength;
+	if (header.kmerLength > 0)
+		m_kmerIntervals = reinterpret_cast<const uint32_t*>(base + header.offset[e_nativeKmerIntervals]);
+	if (header.size[e_nativeTextPacked] > 0)
+	{
+		section = base + header.offset[e_nativeTextExceptions];
+		std::vector<bwtExceptionRun> exceptions(header.size[e_nativeTextExceptions] / (3 * sizeof(uint32_t)));
+		for (size_t i = 0; i < exceptions.size(); i++)
+		{
+			exceptions[i].row = readUint32(section + 3 * i * sizeof(uint32_t));
+			exceptions[i].length = readUint32(section + (3 * i + 1) * sizeof(uint32_t));
+			exceptions[i].chr = static_cast<char>(readUint32(section + (3 * i + 2) * sizeof(uint32_t)));
+		}
+		m_packedText.attach(reinterpret_cast<const uint8_t*>(base + header.offset[e_nativeTextPacked]),
+							header.size[e_nativeTextPacked], m_N, exceptions);
+	}
+}
+
+
+
+
+// compute k-mer interval table of loaded index and add it to index file
+void
+fmIndex::addKmerIntervals
+(
+	std::string indexFile
+)
+{
+	const uint32_t kmerLength = m_settings.m_kmerTableLength;
+	load(indexFile);
+	m_settings.m_kmerTableLength = kmerLength;
+	buildKmerIntervals();
+	try
+	{
+		H5File file(indexFile, H5F_ACC_RDWR);
+		auto grpIndex = file.openGroup(GroupNames.m_Index);
+		hsize_t dims[] = { m_kmerIntervalData.size() };
+		hsize_t chunkDims[] = { std::min<hsize_t>(BwtLastDiskChunkSize, dims[0]) };
+		DSetCreatPropList properties;
+		properties.setChunk(1, chunkDims);
+		properties.setDeflate(3);
+		DataSpace dataspace(1, dims);
+		DataSet dataset = grpIndex.createDataSet(DatasetNames.m_kmerIntervals, 
+												 m_fileDataTypes[DatasetNames.m_kmerIntervals], 
+												 dataspace, properties);
+		dataset.write((void*)&*m_kmerIntervalData.begin(), m_fileDataTypes[DatasetNames.m_kmerIntervals]);
+		dataset.close();
+	}
+	catch (Exception&)
+	{
+		throw std::invalid_argument("Failed to write k-mer table to index " + indexFile);
+	}
+	m_settings.logging().log(e_logInfo, "Added table of " + std::to_string(kmerLength) + "-mer intervals");
+}
+
+
+
+
+// add 2-bit packed text to index file
+void
+fmIndex::addPackedText
+(
+	std::string const & str,
+	std::string indexFile
+)
+{
+	std::vector<uint8_t> packed;
+	std::vector<bwtExceptionRun> exceptions;
+	packedOccurrenceTable::pack(str, str.size(), 0, packed, exceptions);
+	try
+	{
+		H5File file(indexFile, H5F_ACC_RDWR);
+		auto grpIndex = file.openGroup(GroupNames.m_Index);
+		hsize_t dims[] = { packed.size() };
+		hsize_t chunkDims[] = { std::min<hsize_t>(BwtLastDiskChunkSize, dims[0]) };
+		DSetCreatPropList properties;
+		properties.setChunk(1, chunkDims);
+		properties.setDeflate(3);
+		DataSpace dataspace(1, dims);
+		DataSet dataset = grpIndex.createDataSet(DatasetNames.m_textPacked, 
+												 m_fileDataTypes[DatasetNames.m_textPacked], 
+												 dataspace, properties);
+		dataset.write((void*)&*packed.begin(), m_fileDataTypes[DatasetNames.m_textPacked]);
+		dataset.close();
+		dims[0] = exceptions.size();
+		dataspace = DataSpace(1, dims);
+		dataset = grpIndex.createDataSet(DatasetNames.m_textExceptions, 
+										 m_fileDataTypes[DatasetNames.m_textExceptions], 
+										 dataspace);
+		if (!exceptions.empty())
+			dataset.write((void*)&*exceptions.begin(), m_fileDataTypes[DatasetNames.m_textExceptions]);
+		dataset.close();
+	}
+	catch (Exception&)
+	{
+		throw std::invalid_argument("Failed to write packed text to index " + indexFile);
+	}
+	m_settings.logging().log(e_logInfo, "Added packed text with " + std::to_string(exceptions.size()) + " exception runs");
+}
+
+
+
+
+// compute intervals of all k-mers over ACGT, each level prepends one
+// character to all k-mers of the previous level
+void
+fmIndex::buildKmerIntervals
+(
+	void
+)
+{
+	std::vector<uint32_t> current = { 0, m_N };
+	for (uint32_t length = 0; length < m_settings.m_kmerTableLength; length++)
+	{
+		const size_t kmers = current.size() / 2;
+		std::vector<uint32_t> next(current.size() * 4, 0);
+		for (uint8_t symbol = 0; symbol < 4; symbol++)
+		{
+			const char currentChar = KmerAlphabet[symbol];
+			if (m_charIndex[static_cast<uint8_t>(currentChar)] >= m_alphabet.size())
+				continue;
+			uint32_t* interval = &next[2 * symbol * kmers];
+			for (size_t i = 0; i < kmers; i++, interval += 2)
+			{
+				const uint32_t rowStart = current[2 * i];
+				const uint32_t rowStop = current[2 * i + 1];
+				if (rowStop <= rowStart)
+					continue;
+				uint32_t startCount = 0;
+				if (rowStart > 0)
+					startCount = getCount(currentChar, rowStart - 1);
+				uint32_t stopCount = getCount(currentChar, rowStop - 1);
+				if (stopCount > startCount)
+				{
+					interval[0] = getRowFromRank(currentChar, startCount);
+					interval[1] = getRowFromRank(currentChar, stopCount);
+				}
+			}
+		}
+		current.swap(next);
+	}
+	m_kmerIntervalData.swap(current);
+	m_kmerIntervals = m_kmerIntervalData.data();
+}
+
+
+
+
+// build index
+void 
+fmIndex::buildIndex
+(
+	std::string& str, 
+	std::string outputFilename
+)
+{
+	if (m_settings.m_kmerTableLength > MaxKmerTableLength)
+		throw std::invalid_argument("K-mer table length is limited to " + std::to_string(MaxKmerTableLength));
+	m_N = str.size();
+	std::unique_ptr<ISuffixArray> saEngine;
+	if (m_settings.m_saEngine == e_saInducedSort)
+		saEngine.reset(new suffixArraySAIS(str, m_settings.m_threads));
+	else
+		saEngine.reset(new suffixArray(str, m_settings.m_threads));
+	ISuffixArray& sa = *saEngine;
+	clearDataStructures();
+	// compute first column of bwt matrix and init index lookup
+	auto alphabet = sa.getAlphabet();
+	auto alphabetCount = sa.getAlphabetCount();
+	uint8_t alphabetSize = 0;
+	auto it1 = alphabet.begin();
+	auto it2 = alphabetCount.begin();
+	for (; it1 != alphabet.end() && it2 != alphabetCount.end(); ++it1, ++it2)
+	{
+		if ((*it1) != '$')
+		{
+			m_charIndex[*it1] = alphabetSize++;
+			m_bwtFirst.push_back(*it2);
+			m_alphabet.push_back(*it1);
+		}
+	}
+
+	// clear old ranks
+	m_tally.resize(alphabetSize);
+
+	// start output file writer
+	m_writeActive = true;
+	m_writeBlock = false;
+	auto writeThread = std::thread(&fmIndex::fileWriter, this, outputFilename);
+
+	// prepare suffix array segment stream
+	auto blockSize = sa.prepareForStream(m_settings.m_MaxSuffixMemoryBlock);
+	m_settings.logging().log(e_logInfo, "Suffix-array stream prepared, max block is " + std::to_string(blockSize));
+
+	// reserve memory
+	m_bwtLast.reserve(blockSize);
+	m_suffixArraySample.reserve(blockSize / m_settings.m_saSampleStepSize + 1);
+	for (auto it = m_tally.begin(); it != m_tally.end(); ++it)
+		(*it).reserve(blockSize / m_settings.m_tallyStepSize + 1);
+
+	// stream FM-Index to disk
+	size_t complete = 0;
+	size_t lastCompletePrint = 0;
+	for (;;)
+	{
+		auto const & sfx = sa.getNextSegment();
+		if (sfx.size() == 0)
+			break;
+		// wait for pending write operations
+		std::unique_lock<std::mutex> lock(m_writeMutex);
+
+		// process chunk of suffix array
+		processChunk(str, sfx, complete);
+		// m_suffixArray.insert(m_suffixArray.end(), sfx.begin(), sfx.end());
+		// notify file writer thread
+		m_writeBlock = true;
+		lock.unlock();
+		m_writeCondition.notify_one();
+		complete += sfx.size();
+		if (complete > lastCompletePrint + m_N / 100)
+		{
+			m_settings.logging().log(e_logInfo, "Completed " + std::to_string(complete) + " / " + std::to_string(m_N));
+			lastCompletePrint = complete;
+		}		
+	}
+	if (lastCompletePrint != complete)
+		m_settings.logging().log(e_logInfo, "Completed " + std::to_string(complete) + " / " + std::to_string(m_N));
+
+	// finalize output file, the writer drains pending chunks before it exits
+	{
+		std::unique_lock<std::mutex> lock(m_writeMutex);
+		m_writeActive = false;
+	}
+	m_writeCondition.notify_one();
+	writeThread.join();
+
+	// clear names for the case the class is reused
+	m_nameOffset.clear();
+	m_nameOffset[0] = "default";
+}
+
+
+
+
+// output file writer
+void 
+fmIndex::fileWriter
+(
+	std::string outputFilename
+)
+{
+	// create new file, overwrite if existent
+	H5File file(outputFilename, H5F_ACC_TRUNC);
+
+	// save settings as attributes in root
+	hsize_t attr_dims[1] = {1};
+	uint32_t attr_data[1];
+	DataSpace attr_dataspace = DataSpace(1, attr_dims);
+	Attribute attr = file.createAttribute("suffixSample", PredType::NATIVE_UINT32, attr_dataspace);
+	attr_data[0] = m_settings.get_m_saSampleStepSize();
+	attr.write(PredType::NATIVE_UINT32, attr_data);
+	attr = file.createAttribute("tallyStep", PredType::NATIVE_UINT32, attr_dataspace);
+	attr_data[0] = m_settings.get_m_tallyStepSize();
+	attr.write(PredType::NATIVE_UINT32, attr_data);
+
+	// init compound datatype for tally
+	initTallyDatatype(m_alphabet);
+
+	// write name and offset of sequences
+	auto grpSubsequences = file.createGroup(GroupNames.m_Subsequences);
+	for (auto it = m_nameOffset.begin(); it != m_nameOffset.end(); ++it)
+	{
+		hsize_t dims[1]{1};
+		DataSpace dataspace(1, dims);
+		DataSet dataset = grpSubsequences.createDataSet((*it).second, PredType::NATIVE_UINT32, dataspace);
+		dataset.write((void*)&(*it).first, PredType::NATIVE_UINT32);
+	}
+
+	// write first column of bwt matrix
+	auto bwtFirstData = std::vector<IndexFileFirstColumn>();
+	auto it1 = m_bwtFirst.begin();
+	auto it2 = m_alphabet.begin();
+	for (; it1 != m_bwtFirst.end() && it2 != m_alphabet.end(); ++it1, ++it2)
+	{
+		IndexFileFirstColumn item;
+		item.chr = *it2;
+		item.count = *it1;
+		bwtFirstData.push_back(item);
+	}
+	hsize_t dims[] = { m_bwtFirst.size() };
+	hsize_t chunkDims[] = { BwtLastDiskChunkSize < m_N / 10 ? BwtLastDiskChunkSize : m_N };
+	DataSpace dataspace(1, dims);
+	auto grpIndex = file.createGroup(GroupNames.m_Index);
+	DataSet dst_bwtFirst = grpIndex.createDataSet(DatasetNames.m_bwtFirst, 
+												  m_fileDataTypes[DatasetNames.m_bwtFirst], 
+												  dataspace);
+	dst_bwtFirst.write((void*)&*(bwtFirstData.begin()), m_fileDataTypes[DatasetNames.m_bwtFirst]);
+
+	// init datasets for stream writing
+	dims[0] = m_N;
+	dataspace = DataSpace(1, dims);
+	DSetCreatPropList properties;
+	properties.setChunk(1, chunkDims);
+	properties.setDeflate(3);
+	DataSet dst_bwtLast;
+	if (m_settings.m_packedBwt)
+	{
+		dims[0] = (m_N + 3) / 4;
+		chunkDims[0] = chunkDims[0] < dims[0] ? chunkDims[0] : dims[0];
+		properties.setChunk(1, chunkDims);
+		dataspace = DataSpace(1, dims);
+		dst_bwtLast = grpIndex.createDataSet(DatasetNames.m_bwtLastPacked, 
+											 m_fileDataTypes[DatasetNames.m_bwtLastPacked], 
+											 dataspace, properties);
+	}
+	else
+	{
+		dst_bwtLast = grpIndex.createDataSet(DatasetNames.m_bwtLast, 
+											 m_fileDataTypes[DatasetNames.m_bwtLast], 
+											 dataspace, properties);
+	}
+	m_N % m_settings.m_saSampleStepSize == 0 ? dims[0] = m_N / m_settings.m_saSampleStepSize : 
+											   dims[0] = m_N / m_settings.m_saSampleStepSize + 1;
+	dataspace = DataSpace(1, dims);
+	DataSet dst_suffixArraySample = grpIndex.createDataSet(DatasetNames.m_suffixArraySample, 
+														   m_fileDataTypes[DatasetNames.m_suffixArraySample], 
+														   dataspace);
+	m_N % m_settings.m_tallyStepSize == 0 ? dims[0] = m_N / m_settings.m_tallyStepSize : 
+											dims[0] = m_N / m_settings.m_tallyStepSize + 1;
+	dataspace = DataSpace(1, dims);
+	DataSet dst_tally = grpIndex.createDataSet(DatasetNames.m_tally,
+											   m_fileDataTypes[DatasetNames.m_tally], 
+											   dataspace);
+	size_t tallyPosition = 0;
+	size_t suffixArraySamplePosition = 0;
+	size_t bwtLastPosition = 0;
+	hsize_t offset[1], count[1], stride[1], block[1];
+	stride[0] = 1;
+	block[0] = 1;
+	DataSpace memspace;
+	std::vector<uint8_t> packedBuffer;
+	for (;;)
+	{
+		// wait for signal, pending chunks are written before leaving
+		std::unique_lock<std::mutex> lock(m_writeMutex);
+		m_writeCondition.wait(lock, [this]{ return m_writeBlock || !m_writeActive; });
+		if (!m_writeBlock)
+			break;
+		m_writeBlock = false;
+		// write bwt_Last
+		if (m_settings.m_packedBwt)
+		{
+			// pack complete bytes, trailing symbols remain buffered for the next chunk
+			const size_t symbols = m_bwtLast.size() - m_bwtLast.size() % 4;
+			packedOccurrenceTable::pack(m_bwtLast, symbols, static_cast<uint32_t>(bwtLastPosition), 
+										packedBuffer, m_bwtExceptions);
+			if (!packedBuffer.empty())
+			{
+				offset[0] = bwtLastPosition / 4;
+				count[0] = packedBuffer.size();
+				dims[0] = packedBuffer.size();
+				memspace = DataSpace(1, dims, NULL);
+				dataspace = dst_bwtLast.getSpace();
+				dataspace.selectHyperslab(H5S_SELECT_SET, count, offset, stride, block);
+				dst_bwtLast.write((void*)&*packedBuffer.begin(), 
+								  m_fileDataTypes[DatasetNames.m_bwtLastPacked], 
+								  memspace, dataspace);
+			}
+			bwtLastPosition += symbols;
+			m_bwtLast.erase(0, symbols);
+		}
+		else
+		{
+			offset[0] = bwtLastPosition;
+			count[0] = m_bwtLast.size();
+			dims[0] = m_bwtLast.size();
+			memspace = DataSpace(1, dims, NULL);
+			dataspace = dst_bwtLast.getSpace();
+			dataspace.selectHyperslab(H5S_SELECT_SET, count, offset, stride, block);
+			dst_bwtLast.write((void*)&*m_bwtLast.begin(), 
+							  m_fileDataTypes[DatasetNames.m_bwtLast], 
+							  memspace, dataspace);
+			bwtLastPosition += m_bwtLast.size();
+			m_bwtLast.clear();
+		}
+		// write suffix array sample
+		offset[0] = suffixArraySamplePosition;
+		count[0] = m_suffixArraySample.size();
+		dims[0] = m_suffixArraySample.size();
+		memspace = DataSpace(1, dims, NULL);
+		dataspace = dst_suffixArraySample.getSpace();
+		dataspace.selectHyperslab(H5S_SELECT_SET, count, offset, stride, block);
+		dst_suffixArraySample.write((void*)&*m_suffixArraySample.begin(), 
+									m_fileDataTypes[DatasetNames.m_suffixArraySample], 
+									memspace, dataspace);
+		suffixArraySamplePosition += m_suffixArraySample.size();
+		m_suffixArraySample.clear();
+		// write tally
+		const size_t tallyLength = (*m_tally.begin()).size();
+		offset[0] = tallyPosition;
+		count[0] = tallyLength;
+		dims[0] = tallyLength;
+		memspace = DataSpace(1, dims, NULL);
+		dataspace = dst_tally.getSpace();
+		dataspace.selectHyperslab(H5S_SELECT_SET, count, offset, stride, block);
+		std::vector<uint32_t> continiousBuffer(tallyLength * m_alphabet.size());
+		for (uint32_t i = 0; i < m_alphabet.size(); i++)
+		{
+			auto bufIter = continiousBuffer.begin() + i;
+			for (auto it = m_tally[i].begin(); it != m_tally[i].end(); ++it)
+			{
+				*bufIter = *it;
+				bufIter += m_alphabet.size();
+			}				
+		}
+		dst_tally.write((void*)&*continiousBuffer.begin(), 
+						m_fileDataTypes[DatasetNames.m_tally], 
+						memspace, dataspace);
+		tallyPosition += tallyLength;
+		for (auto it = m_tally.begin(); it != m_tally.end(); ++it)
+			(*it).clear();
+	}
+	// write trailing packed symbols and exception runs
+	if (m_settings.m_packedBwt)
+	{
+		if (!m_bwtLast.empty())
+		{
+			packedOccurrenceTable::pack(m_bwtLast, m_bwtLast.size(), static_cast<uint32_t>(bwtLastPosition), 
+										packedBuffer, m_bwtExceptions);
+			offset[0] = bwtLastPosition / 4;
+			count[0] = packedBuffer.size();
+			dims[0] = packedBuffer.size();
+			memspace = DataSpace(1, dims, NULL);
+			dataspace = dst_bwtLast.getSpace();
+			dataspace.selectHyperslab(H5S_SELECT_SET, count, offset, stride, block);
+			dst_bwtLast.write((void*)&*packedBuffer.begin(), 
+							  m_fileDataTypes[DatasetNames.m_bwtLastPacked], 
+							  memspace, dataspace);
+			m_bwtLast.clear();
+		}
+		dims[0] = m_bwtExceptions.size();
+		dataspace = DataSpace(1, dims);
+		DataSet dst_bwtExceptions = grpIndex.createDataSet(DatasetNames.m_bwtExceptions, 
+														   m_fileDataTypes[DatasetNames.m_bwtExceptions], 
+														   dataspace);
+		if (!m_bwtExceptions.empty())
+			dst_bwtExceptions.write((void*)&*m_bwtExceptions.begin(), m_fileDataTypes[DatasetNames.m_bwtExceptions]);
+		dst_bwtExceptions.close();
+		m_settings.logging().log(e_logInfo, "Packed last column with " + std::to_string(m_bwtExceptions.size()) + " exception runs");
+	}
+	// debug store complete suffixArray
+	 //dims[0] = m_N;
+	 //dataspace = DataSpace(1, dims);
+	 //properties.setChunk(1, chunkDims);
+	 //properties.setDeflate(3);
+	 //DataSet dst_suffixArray = grpIndex.createDataSet(DatasetNames.m_suffixArray, 
+		//										  m_fileDataTypes[DatasetNames.m_suffixArray], 
+		//										  dataspace, properties);
+	 //memspace = DataSpace(1, dims, NULL);
+	 //dst_suffixArray.write((void*)&*m_suffixArray.begin(),
+		//				    m_fileDataTypes[DatasetNames.m_suffixArray],
+		//				    memspace, dataspace);
+	// end of debug
+	dst_bwtFirst.close();
+	dst_bwtLast.close();
+	dst_suffixArraySample.close();
+	// dst_suffixArray.close();
+	dst_tally.close();
+	m_settings.logging().log(e_logInfo, "Finished writing index to disk.");
+	// done, file is closed by destructor
+}
+
+
+
+
+// get position from suffix array sample
+int64_t 
+fmIndex::getPositionFromRow
+(
+	uint32_t row
+)
+{
+	const uint32_t SaSampleStepSize = m_settings.m_saSampleStepSize;
+	uint32_t steps = 0;
+	uint32_t sampleRank;
+	while (!m_sampledRows.getRank(row, sampleRank))
+	{
+		const char currentChar = getLastColumn(row);
+		uint32_t currentCount = getCount(currentChar, row);
+		uint32_t currentRank = currentCount - 1;		// count will always be > 0
+		row = getRowFromRank(currentChar, currentRank);
+		steps++;
+		if (steps > SaSampleStepSize + 1)
+		{
+			// should not happen, ...
+			m_settings.logging().log(e_logError, "Error while looking up suffix array sample. Please contact development.");
+			return -1;
+		}
+	}
+	return m_samplePositions[sampleRank] + steps;
+}
+
+
+
+
+// process chunk of suffix array
+void 
+fmIndex::processChunk
+(
+	std::string const & s,
+	std::vector<uint32_t> const & sfx, 
+	const uint32_t offset
+)
+{
+	// expand bwt
+	auto bwtOffset = m_bwtLast.size();
+	m_bwtLast.resize(m_bwtLast.size() + sfx.size());
+	bwtFromSA(s, sfx, m_bwtLast, bwtOffset);
+
+	// expand suffix array sample
+	auto index = offset;
+	auto SaSampleStepSize = m_settings.m_saSampleStepSize;
+	for (auto it = sfx.begin(); it != sfx.end(); ++it)
+	{
+		if ((*it) % SaSampleStepSize == 0)
+		{
+			indexValuePair p;
+			p.index = index;
+			p.value = *it;
+			m_suffixArraySample.push_back(p);
+		}
+		index++;
+	}
+
+	// init tally on first call
+	static std::vector<uint32_t> tallyLine;
+	if (offset == 0)
+	{
+		tallyLine = std::vector<uint32_t>(m_alphabet.size(), 0);
+	}
+		
+	// expand tally
+	index = offset;
+	const uint32_t TallyStepSize = m_settings.m_tallyStepSize;
+	for (auto it = m_bwtLast.begin() + bwtOffset; it != m_bwtLast.end(); ++it)
+	{
+		if ((*it) != '$')
+			tallyLine[m_charIndex[*it]]++;
+		if (index % TallyStepSize == 0)
+		{
+			for (uint32_t j = 0; j < m_alphabet.size(); j++)
+				m_tally[j].push_back(tallyLine[j]);
+		}
+		index++;
+	}
+}
+
+
+
+
+// init file datatypes
+void 
+fmIndex::initTallyDatatype
+(
+	 std::string alphabet
+)
+{
+	if (m_fileDataTypes.find(DatasetNames.m_tally) != m_fileDataTypes.end())
+		m_fileDataTypes.erase(DatasetNames.m_tally);
+	// m_tally
+	CompType memType(sizeof(uint32_t) * alphabet.size());
+	for (size_t i = 0; i < alphabet.size(); i++)
+		memType.insertMember(alphabet.substr(i, 1), i * sizeof(uint32_t), PredType::NATIVE_UINT32);
+	m_fileDataTypes[DatasetNames.m_tally] = memType;
+}
+
+
+
+
+// clear all members
+void 
+fmIndex::clearDataStructures
+(
+	void
+)
+{
+	this->m_charIndex = std::vector<uint8_t>(256, 255);
+	this->m_alphabet.clear();
+	this->m_bwtFirst.clear();
+	this->m_firstRow = std::vector<uint32_t>(256, 0);
+	this->m_bwtLast.clear();
+	this->m_tally.clear();
+	this->m_bwtExceptions.clear();
+	this->m_occurrenceTable.clear();
+	this->m_packedOccurrenceTable.clear();
+	this->m_suffixArraySample.clear();
+	this->m_sampledRows.clear();
+	this->m_samplePositions = NULL;
+	this->m_sampleCount = 0;
+	this->m_sampleRows = NULL;
+	this->m_sampleRowCount = 0;
+	this->m_samplePositionData.clear();
+	this->m_sampleRowData.clear();
+	this->m_kmerIntervals = NULL;
+	this->m_kmerIntervalData.clear();
+	this->m_packedText.clear();
+	this->m_mappedIndex.close();
+}
+
+
+
+
+void
+bwtFromSA
+(
+	const std::string& S,
+	std::vector<uint32_t> const& sa,
+	std::string& bwt,
+	size_t bwtOffset
+)
+{
+	for (size_t i = 0; i < sa.size(); i++)
+	{
+		if (sa[i] == 0)
+			bwt[bwtOffset + i] = *(S.rbegin());
+		else
+			bwt[bwtOffset + i] = S[sa[i] - 1];
+	}
+}
+
+
+
+
+// append value in native byte order
+void
+appendUint32
+(
+	std::string& buffer,
+	const uint32_t value
+)
+{
+	buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+
+
+
+// read unaligned value in native byte order
+uint32_t
+readUint32
+(
+	const char* data
+)
+{
+	uint32_t value;
+	std::memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+
+
+
+// names and lengths of chapters from their offsets in text of given length
+std::vector<std::pair<std::string, uint32_t>>
+chapterLengths
+(
+	std::map<uint32_t, std::string> const & nameOffset,
+	size_t totalLength
+)
+{
+	std::vector<std::pair<std::string, uint32_t>> chapters;
+	for (auto it = nameOffset.begin(); it != nameOffset.end(); ++it)
+	{
+		auto it_next = std::next(it);
+		if (it_next != nameOffset.end())
+			chapters.push_back(std::make_pair((*it).second, (*it_next).first - (*it).first));
+		else
+			chapters.push_back(std::make_pair((*it).second, totalLength - (*it).first));
+	}
+	return chapters;
+}
+
+
+
+
+herr_t 
+getGroupDatasetNames
+(
+	hid_t loc_id, 
+	const char* name, 
+	const H5L_info_t *linfo, 
+	void* opdata
+)
+{
+	auto dsNames = reinterpret_cast<std::vector<std::string>*>(opdata);
+	hid_t ds = H5Dopen2(loc_id, name, H5P_DEFAULT);
+	if (ds > 0)
+		dsNames->push_back(name);
+	H5Dclose(ds);
+	return 0;
+}
@@ -1,125 +1,215 @@
-// \MODULE\---------------------------------------------------------------
-//
-//  CONTENTS      : Class fmIndex_settings
-//
-//  DESCRIPTION   :	Settings for fmIndex
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-// All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-
-//-- standard headers ----------------------------------------------------
-
-//-- private headers -----------------------------------------------------
-#include "fmIndex_settings.h"
-
-//-- source control system ID (if needed)---------------------------------
-
-//-- exported global variables - definitions (should be empty) -----------
-
-//-- private constants ---------------------------------------------------
-
-//-- private types -------------------------------------------------------
-
-//-- private functions --------- declarations ----------------------------
-
-//-- private global variables -- definitions (should be empty) -----------
-
-//-- exported functions -------- definitions -----------------------------
-// default constructor
-fmIndex_settings::fmIndex_settings()
-{
-
-}
-
-
-
-
-// virtual destructor
-fmIndex_settings::~fmIndex_settings()
-{
-
-}
-
-
-
-
-// setter
-void 
-fmIndex_settings::set_m_threads(uint32_t value)
-{
-	m_threads = value > 0 ? value : 1;
-}
-
-
-
-
-void 
-fmIndex_settings::set_m_tallyStepSize(uint32_t value)
-{
-	m_tallyStepSize = value > 0 ? value : 1;
-}
-
-
-
-
-void 
-fmIndex_settings::set_m_saSampleStepSize(uint32_t value)
-{
-	m_saSampleStepSize = value > 0 ? value : 1;
-}
-
-
-
-
-void 
-fmIndex_settings::set_m_MaxSuffixMemoryBlock(uint32_t value)
-{
-	m_MaxSuffixMemoryBlock = value > 10000 ? value : 10000;	// we need at least a bit of space to sort
-}
-
-
-
-
-// getter
-uint32_t 
-fmIndex_settings::get_m_threads(void)
-{
-	return m_threads;
-}
-
-
-
-
-uint32_t 
-fmIndex_settings::get_m_tallyStepSize(void)
-{
-	return m_tallyStepSize;
-}
-
-
-
-
-uint32_t 
-fmIndex_settings::get_m_saSampleStepSize(void)
-{
-	return m_saSampleStepSize;
-}
-
-
-
-
-uint32_t 
-fmIndex_settings::get_m_MaxSuffixMemoryBlock(void)
-{
-	return m_MaxSuffixMemoryBlock;
-}
-
-
-
-
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class fmIndex_settings
+//
+//  DESCRIPTION   :	Settings for fmIndex
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+
+//-- private headers -----------------------------------------------------
+#include "fmIndex_settings.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// default constructor
+fmIndex_settings::fmIndex_settings()
+{
+
+}
+
+
+
+
+// virtual destructor
+fmIndex_settings::~fmIndex_settings()
+{
+
+}
+
+
+
+
+// setter
+void 
+fmIndex_settings::set_m_threads(uint32_t value)
+{
+	m_threads = value > 0 ? value : 1;
+}
+
+
+
+
+void 
+fmIndex_settings::set_m_tallyStepSize(uint32_t value)
+{
+	m_tallyStepSize = value > 0 ? value : 1;
+}
+
+
+
+
+void 
+fmIndex_settings::set_m_saSampleStepSize(uint32_t value)
+{
+	m_saSampleStepSize = value > 0 ? value : 1;
+}
+
+
+
+
+void 
+fmIndex_settings::set_m_MaxSuffixMemoryBlock(uint32_t value)
+{
+	m_MaxSuffixMemoryBlock = value > 10000 ? value : 10000;	// we need at least a bit of space to sort
+}
+
+
+
+
+void 
+fmIndex_settings::set_m_packedBwt(bool value)
+{
+	m_packedBwt = value;
+}
+
+
+
+
+void 
+fmIndex_settings::set_m_saEngine(SuffixArrayEngine value)
+{
+	m_saEngine = value;
+}
+
+
+
+
+void 
+fmIndex_settings::set_m_nativeIndex(bool value)
+{
+	m_nativeIndex = value;
+}
+
+
+
+
+void 
+fmIndex_settings::set_m_kmerTableLength(uint32_t value)
+{
+	m_kmerTableLength = value;
+}
+
+
+
+
+void 
+fmIndex_settings::set_m_packedText(bool value)
+{
+	m_packedText = value;
+}
+
+
+
+
+// getter
+uint32_t 
+fmIndex_settings::get_m_threads(void)
+{
+	return m_threads;
+}
+
+
+
+
+uint32_t 
+fmIndex_settings::get_m_tallyStepSize(void)
+{
+	return m_tallyStepSize;
+}
+
+
+
+
+uint32_t 
+fmIndex_settings::get_m_saSampleStepSize(void)
+{
+	return m_saSampleStepSize;
+}
+
+
+
+
+uint32_t 
+fmIndex_settings::get_m_MaxSuffixMemoryBlock(void)
+{
+	return m_MaxSuffixMemoryBlock;
+}
+
+
+
+
+bool 
+fmIndex_settings::get_m_packedBwt(void)
+{
+	return m_packedBwt;
+}
+
+
+
+
+SuffixArrayEngine 
+fmIndex_settings::get_m_saEngine(void)
+{
+	return m_saEngine;
+}
+
+
+
+
+bool 
+fmIndex_settings::get_m_nativeIndex(void)
+{
+	return m_nativeIndex;
+}
+
+
+
+
+uint32_t 
+fmIndex_settings::get_m_kmerTableLength(void)
+{
+	return m_kmerTableLength;
+}
+
+
+
+
+bool 
+fmIndex_settings::get_m_packedText(void)
+{
+	return m_packedText;
+}
+
+
+
+
 //-- private functions --------- definitions -----------------------------
\ No newline at end of file
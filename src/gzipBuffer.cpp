@@ -0,0 +1,405 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class gzipBuffer
+//
+//  DESCRIPTION   :	Stream buffer decompressing gzip input, blocks of
+//					BGZF input are decompressed in parallel
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : zlib
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+//-- private headers -----------------------------------------------------
+#include "gzipBuffer.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const size_t BgzfHeaderSize = 18;				// gzip header with BC extra subfield
+const size_t BgzfFooterSize = 8;				// CRC32 and ISIZE
+const size_t InputChunk = 1024 * 1024;			// compressed bytes read at once
+const size_t OutputChunk = 4 * 1024 * 1024;		// decompressed bytes per refill
+const size_t JobBytes = 256 * 1024;				// compressed bytes per BGZF job
+const size_t JobsPerThread = 4;					// BGZF jobs in flight per worker
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+uint32_t readLittleEndian(const char* data, size_t bytes);
+bool isBgzfHeader(const char* data, size_t size);
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor, threads used for BGZF input only
+gzipBuffer::gzipBuffer
+(
+	std::istream& source,
+	uint32_t threads
+) :m_source(source)
+{
+	// keep bytes of format detection for decompression
+	m_header.resize(BgzfHeaderSize);
+	m_source.read(m_header.data(), m_header.size());
+	m_header.resize(static_cast<size_t>(m_source.gcount()));
+	m_sourceEnd = !m_source.good();
+	m_blocked = isBgzfHeader(m_header.data(), m_header.size());
+	if (m_blocked)
+	{
+		const uint32_t workers = std::max(threads, 1u);
+		m_maxJobs = JobsPerThread * workers;
+		for (uint32_t i = 0; i < workers; i++)
+			m_workers.push_back(std::thread(&gzipBuffer::inflateWorker, this));
+	}
+	else
+	{
+		std::memset(&m_stream, 0, sizeof(m_stream));
+		// detect gzip or zlib header, members of concatenated files are handled in inflateStream
+		if (inflateInit2(&m_stream, 15 + 32) != Z_OK)
+			throw std::runtime_error("Failed to initialize zlib");
+		m_streamInit = true;
+		m_input.resize(InputChunk);
+		m_output.resize(OutputChunk);
+	}
+}
+
+
+
+
+// virtual destructor
+gzipBuffer::~gzipBuffer()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_jobQueued.notify_all();
+	for (auto it = m_workers.begin(); it != m_workers.end(); ++it)
+		(*it).join();
+	if (m_streamInit)
+		inflateEnd(&m_stream);
+}
+
+
+
+
+// true if stream starts with gzip magic number, position is not changed
+bool
+gzipBuffer::isCompressed
+(
+	std::istream& source
+)
+{
+	const auto position = source.tellg();
+	char magic[2];
+	source.read(magic, 2);
+	const bool compressed = source.gcount() == 2 &&
+		static_cast<uint8_t>(magic[0]) == 0x1f && static_cast<uint8_t>(magic[1]) == 0x8b;
+	source.clear();
+	source.seekg(position);
+	return compressed;
+}
+
+
+
+
+// true if input consists of BGZF blocks
+bool
+gzipBuffer::isBlocked
+(
+	void
+)const
+{
+	return m_blocked;
+}
+
+
+
+
+// refill get area with decompressed data
+gzipBuffer::int_type
+gzipBuffer::underflow
+(
+
+)
+{
+	if (gptr() < egptr())
+		return traits_type::to_int_type(*gptr());
+	if (!m_blocked)
+	{
+		if (!inflateStream())
+			return traits_type::eof();
+		return traits_type::to_int_type(*gptr());
+	}
+	for (;;)
+	{
+		// queue following blocks to keep workers busy
+		while (m_jobs.size() < m_maxJobs)
+		{
+			auto job = readBlocks();
+			if (job == NULL)
+				break;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_pending.push(job);
+			}
+			m_jobQueued.notify_one();
+			m_jobs.push_back(job);
+		}
+		if (m_jobs.empty())
+			return traits_type::eof();
+		// jobs are consumed in input order
+		m_current = m_jobs.front();
+		m_jobs.pop_front();
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_jobDone.wait(lock, [this]{ return m_current->done; });
+		}
+		if (m_current->failed)
+			throw std::runtime_error("Corrupt BGZF block");
+		// empty end of file marker blocks are skipped
+		if (m_current->data.size() > 0)
+		{
+			char* data = m_current->data.data();
+			setg(data, data, data + m_current->data.size());
+			return traits_type::to_int_type(*gptr());
+		}
+	}
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// read from sniffed header bytes first, then from source
+size_t
+gzipBuffer::readSource
+(
+	char* buffer,
+	size_t size
+)
+{
+	size_t bytesRead = 0;
+	if (m_headerPosition < m_header.size())
+	{
+		bytesRead = std::min(size, m_header.size() - m_headerPosition);
+		std::memcpy(buffer, m_header.data() + m_headerPosition, bytesRead);
+		m_headerPosition += bytesRead;
+	}
+	if (bytesRead < size && !m_sourceEnd)
+	{
+		m_source.read(buffer + bytesRead, size - bytesRead);
+		bytesRead += static_cast<size_t>(m_source.gcount());
+		m_sourceEnd = !m_source.good();
+	}
+	return bytesRead;
+}
+
+
+
+
+// inflate next chunk of gzip stream
+bool
+gzipBuffer::inflateStream
+(
+	void
+)
+{
+	for (;;)
+	{
+		if (m_stream.avail_in == 0)
+		{
+			m_stream.next_in = reinterpret_cast<Bytef*>(m_input.data());
+			m_stream.avail_in = static_cast<uInt>(readSource(m_input.data(), m_input.size()));
+			// counters are reset after each complete member
+			if (m_stream.avail_in == 0 && m_stream.total_in > 0)
+				throw std::runtime_error("Truncated gzip input");
+			if (m_stream.avail_in == 0)
+				return false;
+		}
+		m_stream.next_out = reinterpret_cast<Bytef*>(m_output.data());
+		m_stream.avail_out = static_cast<uInt>(m_output.size());
+		const int ret = inflate(&m_stream, Z_NO_FLUSH);
+		// concatenated members, each with own header
+		if (ret == Z_STREAM_END)
+			inflateReset(&m_stream);
+		else if (ret != Z_OK && ret != Z_BUF_ERROR)
+			throw std::runtime_error("Corrupt gzip input");
+		const size_t produced = m_output.size() - m_stream.avail_out;
+		if (produced > 0)
+		{
+			setg(m_output.data(), m_output.data(), m_output.data() + produced);
+			return true;
+		}
+	}
+}
+
+
+
+
+// read complete BGZF blocks for next job, NULL at end of input
+std::shared_ptr<gzipBuffer::bgzfJob>
+gzipBuffer::readBlocks
+(
+	void
+)
+{
+	auto job = std::make_shared<bgzfJob>();
+	auto& compressed = job->compressed;
+	while (compressed.size() < JobBytes)
+	{
+		const size_t start = compressed.size();
+		compressed.resize(start + BgzfHeaderSize);
+		const size_t headerBytes = readSource(compressed.data() + start, BgzfHeaderSize);
+		if (headerBytes == 0)
+		{
+			compressed.resize(start);
+			break;
+		}
+		if (!isBgzfHeader(compressed.data() + start, headerBytes))
+			throw std::runtime_error("Invalid BGZF block header");
+		// BSIZE is total block size minus one
+		const size_t blockSize = readLittleEndian(compressed.data() + start + 16, 2) + 1;
+		if (blockSize < BgzfHeaderSize + BgzfFooterSize)
+			throw std::runtime_error("Invalid BGZF block size");
+		compressed.resize(start + blockSize);
+		const size_t remaining = blockSize - BgzfHeaderSize;
+		if (readSource(compressed.data() + start + BgzfHeaderSize, remaining) != remaining)
+			throw std::runtime_error("Truncated BGZF block");
+	}
+	if (compressed.empty())
+		return std::shared_ptr<bgzfJob>();
+	return job;
+}
+
+
+
+
+// decompress blocks of job, false on corrupt data
+bool
+gzipBuffer::inflateBlocks
+(
+	z_stream& stream,
+	bgzfJob& job
+)
+{
+	const char* compressed = job.compressed.data();
+	const size_t compressedSize = job.compressed.size();
+	// decompressed size is stored in block footers
+	size_t dataSize = 0;
+	for (size_t block = 0; block < compressedSize; block += readLittleEndian(compressed + block + 16, 2) + 1)
+	{
+		const size_t blockSize = readLittleEndian(compressed + block + 16, 2) + 1;
+		dataSize += readLittleEndian(compressed + block + blockSize - 4, 4);
+	}
+	job.data.resize(dataSize);
+	size_t position = 0;
+	for (size_t block = 0; block < compressedSize; )
+	{
+		const size_t blockSize = readLittleEndian(compressed + block + 16, 2) + 1;
+		const size_t headerSize = 12 + readLittleEndian(compressed + block + 10, 2);
+		const uint32_t crc = readLittleEndian(compressed + block + blockSize - 8, 4);
+		const uint32_t size = readLittleEndian(compressed + block + blockSize - 4, 4);
+		if (headerSize + BgzfFooterSize > blockSize)
+			return false;
+		if (size > 0)
+		{
+			Bytef* data = reinterpret_cast<Bytef*>(job.data.data() + position);
+			inflateReset(&stream);
+			stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed + block + headerSize));
+			stream.avail_in = static_cast<uInt>(blockSize - headerSize - BgzfFooterSize);
+			stream.next_out = data;
+			stream.avail_out = size;
+			if (inflate(&stream, Z_FINISH) != Z_STREAM_END || stream.avail_out != 0)
+				return false;
+			if (crc32(0, data, size) != crc)
+				return false;
+		}
+		position += size;
+		block += blockSize;
+	}
+	return true;
+}
+
+
+
+
+// worker thread decompressing queued jobs
+void
+gzipBuffer::inflateWorker
+(
+	void
+)
+{
+	z_stream stream;
+	std::memset(&stream, 0, sizeof(stream));
+	// raw deflate data, headers are parsed in readBlocks
+	const bool ready = inflateInit2(&stream, -15) == Z_OK;
+	for (;;)
+	{
+		std::shared_ptr<bgzfJob> job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_jobQueued.wait(lock, [this]{ return m_stop || !m_pending.empty(); });
+			if (m_stop)
+				break;
+			job = m_pending.front();
+			m_pending.pop();
+		}
+		const bool success = ready && inflateBlocks(stream, *job);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			job->failed = !success;
+			job->done = true;
+		}
+		m_jobDone.notify_all();
+	}
+	if (ready)
+		inflateEnd(&stream);
+}
+
+
+
+
+// little endian unsigned integer of 2 or 4 bytes
+uint32_t
+readLittleEndian
+(
+	const char* data,
+	size_t bytes
+)
+{
+	uint32_t value = 0;
+	for (size_t i = bytes; i-- > 0;)
+		value = (value << 8) | static_cast<uint8_t>(data[i]);
+	return value;
+}
+
+
+
+
+// gzip member header with BGZF extra subfield 'BC'
+bool
+isBgzfHeader
+(
+	const char* data,
+	size_t size
+)
+{
+	return size >= BgzfHeaderSize &&
+		static_cast<uint8_t>(data[0]) == 0x1f && static_cast<uint8_t>(data[1]) == 0x8b &&
+		static_cast<uint8_t>(data[2]) == 8 && (static_cast<uint8_t>(data[3]) & 4) &&
+		readLittleEndian(data + 10, 2) == 6 &&
+		data[12] == 'B' && data[13] == 'C' && readLittleEndian(data + 14, 2) == 2;
+}
@@ -0,0 +1,298 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class kmerCounter
+//
+//  DESCRIPTION   :	Counting of k-mers in flat arrays indexed by
+//					integer encoded k-mers
+//
+//  RESTRICTIONS  : alphabet size to the power of k limited by memory
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <algorithm>
+#include <thread>
+
+//-- private headers -----------------------------------------------------
+#include "kmerCounter.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const uint64_t MaxTableSize = 1ULL << 28;				// 1 GB of counts per table
+const uint64_t MaxCountMemory = 4ULL << 30;				// 4 GB for all thread local tables
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor counting characters of S
+kmerCounter::kmerCounter
+(
+	std::string const & S,
+	uint32_t threads
+) : m_S(S)
+{
+	m_threads = threads > 0 ? threads : 1;
+	// characters are counted by their unsigned value
+	m_charCode = std::vector<uint8_t>(256);
+	for (uint32_t i = 0; i < 256; ++i)
+		m_charCode[i] = static_cast<uint8_t>(i);
+	m_alphabet = std::string(256, '\0');
+	for (uint32_t i = 0; i < 256; ++i)
+		m_alphabet[i] = static_cast<char>(i);
+	count(1);
+	// reduce to characters present in S
+	std::string alphabet;
+	std::vector<uint32_t> counts;
+	for (uint32_t i = 0; i < 256; ++i)
+	{
+		if (m_counts[i] > 0)
+		{
+			m_charCode[i] = static_cast<uint8_t>(alphabet.size());
+			alphabet.push_back(static_cast<char>(i));
+			counts.push_back(m_counts[i]);
+		}
+	}
+	m_alphabet = alphabet;
+	m_alphabetCount = counts;
+	m_counts = counts;
+}
+
+
+
+
+// virtual destructor
+kmerCounter::~kmerCounter()
+{
+
+}
+
+
+
+
+// get sorted alphabet of S
+std::string
+kmerCounter::getAlphabet
+(
+	void
+)
+{
+	return m_alphabet;
+}
+
+
+
+
+// get number of characters for each letter in alphabet
+std::vector<uint32_t>
+kmerCounter::getAlphabetCount
+(
+	void
+)
+{
+	return m_alphabetCount;
+}
+
+
+
+
+// count k-mers of length k, false if table exceeds memory limit
+bool
+kmerCounter::count
+(
+	uint32_t k
+)
+{
+	uint64_t tableSize = 1;
+	for (uint32_t i = 0; i < k; ++i)
+	{
+		tableSize *= m_alphabet.size();
+		if (tableSize > MaxTableSize)
+			return false;
+	}
+	if (k == 0 || m_S.size() < k)
+		return false;
+	// thread local tables within memory limit
+	const size_t positions = m_S.size() - k + 1;
+	const uint64_t tableBytes = tableSize * sizeof(uint32_t);
+	size_t threads = std::min(static_cast<size_t>(m_threads), static_cast<size_t>(MaxCountMemory / tableBytes));
+	threads = std::max(std::min(threads, positions), static_cast<size_t>(1));
+	m_k = k;
+	std::vector<std::vector<uint32_t>> tables(threads);
+	const size_t segmentSize = (positions + threads - 1) / threads;
+	auto worker = std::vector<std::thread>();
+	for (size_t i = 1; i < threads; i++)
+	{
+		const size_t segmentBegin = std::min(i * segmentSize, positions);
+		const size_t segmentEnd = std::min(segmentBegin + segmentSize, positions);
+		worker.push_back(std::thread(&kmerCounter::countSegment, this, std::ref(tables[i]), segmentBegin, segmentEnd));
+	}
+	countSegment(tables[0], 0, std::min(segmentSize, positions));
+	for (size_t i = 0; i < worker.size(); i++)
+		worker[i].join();
+	worker.clear();
+	// parallel reduction into first table
+	const size_t reduceSize = (tableSize + threads - 1) / threads;
+	for (size_t i = 1; i < threads; i++)
+	{
+		const size_t reduceBegin = std::min(i * reduceSize, static_cast<size_t>(tableSize));
+		const size_t reduceEnd = std::min(reduceBegin + reduceSize, static_cast<size_t>(tableSize));
+		worker.push_back(std::thread(&kmerCounter::reduceSegment, this, std::ref(tables), reduceBegin, reduceEnd));
+	}
+	reduceSegment(tables, 0, std::min(reduceSize, static_cast<size_t>(tableSize)));
+	for (size_t i = 0; i < worker.size(); i++)
+		worker[i].join();
+	m_counts.swap(tables[0]);
+	return true;
+}
+
+
+
+
+// length of currently counted k-mers
+uint32_t
+kmerCounter::getKmerLength
+(
+	void
+)
+{
+	return m_k;
+}
+
+
+
+
+// highest count of a single k-mer
+uint32_t
+kmerCounter::getMaxCount
+(
+	void
+)
+{
+	if (m_counts.empty())
+		return 0;
+	return *std::max_element(m_counts.begin(), m_counts.end());
+}
+
+
+
+
+// merge consecutive k-mers into buckets smaller than maxBucketSize
+std::vector<kmerBucket>
+kmerCounter::getBuckets
+(
+	uint32_t maxBucketSize
+)
+{
+	std::vector<kmerBucket> buckets;
+	uint64_t lastCode = 0;
+	for (uint64_t code = 0; code < m_counts.size(); ++code)
+	{
+		const uint32_t count = m_counts[code];
+		if (count == 0)
+			continue;
+		if (!buckets.empty() && buckets.back().length + count < maxBucketSize)
+		{
+			buckets.back().length += count;
+			lastCode = code;
+		}
+		else
+		{
+			if (!buckets.empty())
+				buckets.back().end = decode(lastCode);
+			kmerBucket bucket;
+			bucket.begin = decode(code);
+			bucket.length = count;
+			buckets.push_back(bucket);
+			lastCode = code;
+		}
+	}
+	if (!buckets.empty())
+		buckets.back().end = decode(lastCode);
+	return buckets;
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// count k-mers starting in range of S into table
+void
+kmerCounter::countSegment
+(
+	std::vector<uint32_t>& table,
+	size_t begin,
+	size_t end
+)
+{
+	uint64_t tableSize = 1;
+	for (uint32_t i = 0; i < m_k; ++i)
+		tableSize *= m_alphabet.size();
+	table.assign(tableSize, 0);
+	if (begin >= end)
+		return;
+	const uint64_t sigma = m_alphabet.size();
+	const uint64_t leadingDigit = tableSize / sigma;
+	// encode first k-mer, then roll by removing the leading digit
+	uint64_t code = 0;
+	for (size_t i = begin; i < begin + m_k; ++i)
+		code = code * sigma + m_charCode[static_cast<uint8_t>(m_S[i])];
+	table[code]++;
+	for (size_t i = begin + 1; i < end; ++i)
+	{
+		code -= m_charCode[static_cast<uint8_t>(m_S[i - 1])] * leadingDigit;
+		code = code * sigma + m_charCode[static_cast<uint8_t>(m_S[i + m_k - 1])];
+		table[code]++;
+	}
+}
+
+
+
+
+// add tables of all threads in range of codes to first table
+void
+kmerCounter::reduceSegment
+(
+	std::vector<std::vector<uint32_t>>& tables,
+	size_t begin,
+	size_t end
+)
+{
+	auto& result = tables[0];
+	for (size_t i = 1; i < tables.size(); ++i)
+	{
+		auto const & table = tables[i];
+		for (size_t j = begin; j < end; ++j)
+			result[j] += table[j];
+	}
+}
+
+
+
+
+// decode k-mer from integer
+std::string
+kmerCounter::decode
+(
+	uint64_t code
+)
+{
+	std::string kmer(m_k, ' ');
+	const uint64_t sigma = m_alphabet.size();
+	for (uint32_t i = m_k; i > 0; --i)
+	{
+		kmer[i - 1] = m_alphabet[code % sigma];
+		code /= sigma;
+	}
+	return kmer;
+}
@@ -1,192 +1,421 @@
-// \MODULE\---------------------------------------------------------------
-//
-//  CONTENTS      : Selection main function
-//
-//  DESCRIPTION   :	FM-Index based selection of a subset of reads
-//					within specified region(s)
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-// All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-
-//-- standard headers ----------------------------------------------------
-#include <iostream>
-#include <string>
-#include <cstdint>
-#include <boost/program_options.hpp>
-#include <boost/filesystem.hpp>
-
-//-- private headers -----------------------------------------------------
-#include "selection.h"
-#include "fileFastx.h"
-
-//-- private functions --------- declarations ----------------------------
-void printUsage();
-
-//-- exported functions -------- definitions -----------------------------
-int main(int argc, char *argv[])
-{
-	namespace po = boost::program_options;
-	try
-	{
-		po::options_description all("Command");
-		all.add_options()
-			("command", po::value<std::string>()->required(), "Command to execute")
-			("options", po::value<std::vector<std::string>>(), "Options for command")
-			;
-		po::positional_options_description pos;
-		pos.add("command", 1).
-			add("options", -1);
-		po::variables_map vm;	
-		po::parsed_options parsed = po::command_line_parser(argc, argv).
-			options(all).
-			positional(pos).
-			allow_unregistered().
-			run();
-		po::store(parsed, vm);
-		// branch on selected command
-		try
-		{
-			po::notify(vm);
-			std::string command = vm["command"].as<std::string>();
-			std::vector<std::string> opts = po::collect_unrecognized(parsed.options, po::include_positional);
-			opts.erase(opts.begin());	// remove command option
-			// build index for reference sequence
-			if (command == "index")
-			{
-				selection_settings settings;
-				po::options_description printOpt("Index building options");
-				printOpt.add_options()
-					("threads,t", po::value<uint32_t>()->default_value(settings.get_m_threads()), "Number of threads")
-					("prefix,p", po::value<std::string>(), "Prefix of output database [Same as reference filename]")
-					("tallyStep", po::value<uint32_t>()->default_value(settings.get_m_fmIndex_settings().get_m_tallyStepSize()), "Tally step size")
-					("suffixSample", po::value<uint32_t>()->default_value(settings.get_m_fmIndex_settings().get_m_saSampleStepSize()), "Suffix-array sample step size")
-					("sortMemory", po::value<uint32_t>()->default_value(settings.get_m_fmIndex_settings().get_m_MaxSuffixMemoryBlock()), "Memory for sorting suffix array")
-					;
-				po::options_description allOpt;
-				allOpt.add(printOpt);
-				allOpt.add_options()
-					("reference,r", po::value<std::string>()->required(), "Input reference sequence")
-					;
-				po::positional_options_description pos;
-				pos.add("reference", 1);
-				try
-				{
-					po::store(po::command_line_parser(opts).
-													  options(allOpt).
-													  positional(pos).
-													  run(), vm);
-					po::notify(vm);
-					std::string path2Reference = vm["reference"].as<std::string>();
-					std::string dbPrefix = path2Reference;
-					if (vm.count("prefix"))
-						dbPrefix = vm["prefix"].as<std::string>();
-					settings.set_m_threads(vm["threads"].as<uint32_t>());
-					settings.get_m_fmIndex_settings().set_m_tallyStepSize(vm["tallyStep"].as<uint32_t>());
-					settings.get_m_fmIndex_settings().set_m_saSampleStepSize(vm["suffixSample"].as<uint32_t>());
-					settings.get_m_fmIndex_settings().set_m_MaxSuffixMemoryBlock(vm["sortMemory"].as<uint32_t>());
-					selectION::buildFromFastx(settings, path2Reference, dbPrefix);
-				}
-				catch (po::error&)
-				{
-					std::cout << "Usage: selection index [options] <reference.fa>" << std::endl;
-					std::cout << printOpt;
-					return 0;
-				}
-			}
-			// scan input files/directories for reads matching filter
-			else if (command == "scan")
-			{
-				selection_settings settings;
-				po::options_description printOpt("Read selection options");
-				printOpt.add_options()			
-					("filter,f", po::value<std::string>(), "Input selection filter")				
-					("sam,s", po::value<std::string>()->default_value(settings.get_m_sam()), "Write pseudo alignment in sam format to file")
-					("threads,t", po::value<uint32_t>()->default_value(settings.get_m_threads()), "Number of threads")
-					("quality,q", po::value<uint32_t>()->default_value(settings.get_m_qualityThreshold()), "Quality threshold for filtered reads")
-					("scanPrefix", po::value<uint32_t>()->default_value(settings.get_m_pseudoAligner_settings().get_m_scanPrefix()), "Prefix of read to use for alignment")
-					;
-				po::options_description allOpt;
-				allOpt.add(printOpt);
-				allOpt.add_options()
-					("prefix,p", po::value<std::string>()->required(), "Prefix of database")
-					("input,i", po::value<std::string>()->required(), "Input fastq filename")				
-					("output,o", po::value<std::string>()->required(), "Output directory for selected reads")	
-					;
-				po::positional_options_description pos;
-				pos.add("prefix", 1).add("input",1).add("output", 1);
-				try
-				{
-					po::store(po::command_line_parser(opts).
-													 options(allOpt).
-													 positional(pos).
-													 run(), vm);
-					po::notify(vm);	
-					std::string dbPrefix = vm["prefix"].as<std::string>();
-					std::string path2Input = vm["input"].as<std::string>();					
-					std::string outDir = vm["output"].as<std::string>();
-					settings.set_m_sam(vm["sam"].as<std::string>());
-					settings.set_m_threads(vm["threads"].as<uint32_t>());
-					settings.set_m_qualityThreshold(vm["quality"].as<uint32_t>());
-					settings.get_m_pseudoAligner_settings().set_m_scanPrefix(vm["scanPrefix"].as<uint32_t>());
-					std::string cmd;
-					for (int i = 0; i < argc; i++)
-						cmd.append(std::string(argv[i]) + " ");
-					settings.set_m_cmd(cmd);
-					selectION sel(settings, dbPrefix);
-					fileFastx seq(path2Input);
-					positionFilter filter;
-					if (vm.count("filter"))
-					{
-						std::string path2Filter = vm["filter"].as<std::string>();
-						uint32_t n = filter.addSelectors(path2Filter);
-						settings.logging().log(e_logInfo, "Successfully loaded " + std::to_string(n) + " selectors");
-					}				
-					sel.select(seq, filter, outDir);
-				}
-				catch (po::error&)
-				{
-					std::cout << "Usage: selection scan [options] <db.prefix> <input.fq> <outputDir>" << std::endl;
-					std::cout << printOpt;
-					return 0;
-				}
-			}
-			else
-			{
-				printUsage();
-				return 0;
-			}
-		}
-		catch (po::error&)
-		{
-			// error specifying command
-			printUsage();
-			return 0;
-		}
-	}
-	catch (std::exception& e)
-	{
-		std::cerr	<< "Exception in selectION: \n" 
-					<< e.what() << "\n"
-					<< "Application closed." << std::endl;
-		return 1;
-	}
-	return 0;
-}
-
-
-
-
-//-- private functions --------- definitions -----------------------------
-void 
-printUsage()
-{
-	std::cout << "Program:\tSelectION" << std::endl
-		<< "Usage:\t\tselection <command> [options]" << std::endl
-		<< "Commands:\tindex : Build FM-Index for reference sequence" << std::endl
-		<< "\t\tscan : Scan input for reads matching specified positions" << std::endl;
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Selection main function
+//
+//  DESCRIPTION   :	FM-Index based selection of a subset of reads
+//					within specified region(s)
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+#include <boost/program_options.hpp>
+#include <boost/filesystem.hpp>
+
+//-- private headers -----------------------------------------------------
+#include "selection.h"
+#include "fileFastxChain.h"
+#include "selectionServer.h"
+#include "selectionClient.h"
+
+//-- private functions --------- declarations ----------------------------
+void printUsage();
+
+//-- exported functions -------- definitions -----------------------------
+int main(int argc, char *argv[])
+{
+	namespace po = boost::program_options;
+	try
+	{
+		po::options_description all("Command");
+		all.add_options()
+			("command", po::value<std::string>()->required(), "Command to execute")
+			("options", po::value<std::vector<std::string>>(), "Options for command")
+			;
+		po::positional_options_description pos;
+		pos.add("command", 1).
+			add("options", -1);
+		po::variables_map vm;	
+		po::parsed_options parsed = po::command_line_parser(argc, argv).
+			options(all).
+			positional(pos).
+			allow_unregistered().
+			run();
+		po::store(parsed, vm);
+		// branch on selected command
+		try
+		{
+			po::notify(vm);
+			std::string command = vm["command"].as<std::string>();
+			std::vector<std::string> opts = po::collect_unrecognized(parsed.options, po::include_positional);
+			opts.erase(opts.begin());	// remove command option
+			// build index for reference sequence
+			if (command == "index")
+			{
+				selection_settings settings;
+				po::options_description printOpt("Index building options");
+				printOpt.add_options()
+					("threads,t", po::value<uint32_t>()->default_value(settings.get_m_threads()), "Number of threads")
+					("prefix,p", po::value<std::string>(), "Prefix of output database [Same as reference filename]")
+					("tallyStep", po::value<uint32_t>()->default_value(settings.get_m_fmIndex_settings().get_m_tallyStepSize()), "Tally step size")
+					("suffixSample", po::value<uint32_t>()->default_value(settings.get_m_fmIndex_settings().get_m_saSampleStepSize()), "Suffix-array sample step size")
+					("sortMemory", po::value<uint32_t>()->default_value(settings.get_m_fmIndex_settings().get_m_MaxSuffixMemoryBlock()), "Memory for sorting suffix array")
+					("saEngine", po::value<std::string>()->default_value("sort"), "Suffix array construction [sort|sais]")
+					("packed", po::bool_switch()->default_value(settings.get_m_fmIndex_settings().get_m_packedBwt()), "Store last column 2-bit packed")
+					("kmerTable", po::value<uint32_t>()->default_value(settings.get_m_fmIndex_settings().get_m_kmerTableLength()), "K-mer length of interval lookup table, 0 disables")
+					("native", po::bool_switch()->default_value(settings.get_m_fmIndex_settings().get_m_nativeIndex()), "Write memory mapped native index")
+					("packedText", po::bool_switch()->default_value(settings.get_m_fmIndex_settings().get_m_packedText()), "Store 2-bit packed reference for sequence lookup")
+					;
+				po::options_description allOpt;
+				allOpt.add(printOpt);
+				allOpt.add_options()
+					("reference,r", po::value<std::string>()->required(), "Input reference sequence")
+					;
+				po::positional_options_description pos;
+				pos.add("reference", 1);
+				try
+				{
+					po::store(po::command_line_parser(opts).
+													  options(allOpt).
+													  positional(pos).
+													  run(), vm);
+					po::notify(vm);
+					std::string path2Reference = vm["reference"].as<std::string>();
+					std::string dbPrefix = path2Reference;
+					if (vm.count("prefix"))
+						dbPrefix = vm["prefix"].as<std::string>();
+					settings.set_m_threads(vm["threads"].as<uint32_t>());
+					settings.get_m_fmIndex_settings().set_m_tallyStepSize(vm["tallyStep"].as<uint32_t>());
+					settings.get_m_fmIndex_settings().set_m_saSampleStepSize(vm["suffixSample"].as<uint32_t>());
+					settings.get_m_fmIndex_settings().set_m_MaxSuffixMemoryBlock(vm["sortMemory"].as<uint32_t>());
+					settings.get_m_fmIndex_settings().set_m_packedBwt(vm["packed"].as<bool>());
+					settings.get_m_fmIndex_settings().set_m_nativeIndex(vm["native"].as<bool>());
+					settings.get_m_fmIndex_settings().set_m_kmerTableLength(vm["kmerTable"].as<uint32_t>());
+					settings.get_m_fmIndex_settings().set_m_packedText(vm["packedText"].as<bool>());
+					std::string saEngine = vm["saEngine"].as<std::string>();
+					if (saEngine == "sais")
+						settings.get_m_fmIndex_settings().set_m_saEngine(e_saInducedSort);
+					else if (saEngine != "sort")
+						throw po::invalid_option_value(saEngine);
+					selectION::buildFromFastx(settings, path2Reference, dbPrefix);
+				}
+				catch (po::error&)
+				{
+					std::cout << "Usage: selection index [options] <reference.fa>" << std::endl;
+					std::cout << printOpt;
+					return 0;
+				}
+			}
+			// convert existing index to memory mapped native format
+			else if (command == "convert")
+			{
+				selection_settings settings;
+				po::options_description allOpt;
+				allOpt.add_options()
+					("prefix,p", po::value<std::string>()->required(), "Prefix of database")
+					;
+				po::positional_options_description pos;
+				pos.add("prefix", 1);
+				try
+				{
+					po::store(po::command_line_parser(opts).
+													  options(allOpt).
+													  positional(pos).
+													  run(), vm);
+					po::notify(vm);
+					selectION::convertIndex(settings, vm["prefix"].as<std::string>());
+				}
+				catch (po::error&)
+				{
+					std::cout << "Usage: selection convert <db.prefix>" << std::endl;
+					return 0;
+				}
+			}
+			// compile region file to memory mapped selector index
+			else if (command == "selectors")
+			{
+				selection_settings settings;
+				po::options_description printOpt("Selector index options");
+				printOpt.add_options()
+					("feature", po::value<std::string>()->default_value(""), "GTF/GFF feature type to select, all if empty")
+					;
+				po::options_description allOpt;
+				allOpt.add(printOpt);
+				allOpt.add_options()
+					("prefix,p", po::value<std::string>()->required(), "Prefix of database")
+					("regions,r", po::value<std::string>()->required(), "Input regions in BED, GTF/GFF or csv format")
+					("output,o", po::value<std::string>()->required(), "Output selector index")
+					;
+				po::positional_options_description pos;
+				pos.add("prefix", 1).add("regions", 1).add("output", 1);
+				try
+				{
+					po::store(po::command_line_parser(opts).
+													  options(allOpt).
+													  positional(pos).
+													  run(), vm);
+					po::notify(vm);
+					selectION::compileSelectors(settings, vm["prefix"].as<std::string>(), vm["regions"].as<std::string>(),
+						vm["feature"].as<std::string>(), vm["output"].as<std::string>());
+				}
+				catch (po::error&)
+				{
+					std::cout << "Usage: selection selectors [options] <db.prefix> <regions.bed|gtf|gff|csv> <selectors.sel>" << std::endl;
+					std::cout << printOpt;
+					return 0;
+				}
+			}
+			// scan input files/directories for reads matching filter
+			else if (command == "scan")
+			{
+				selection_settings settings;
+				po::options_description printOpt("Read selection options");
+				printOpt.add_options()			
+					("filter,f", po::value<std::string>(), "Input selection filter")				
+					("feature", po::value<std::string>()->default_value(""), "GTF/GFF feature type of filter, all if empty")
+					("sam,s", po::value<std::string>()->default_value(settings.get_m_sam()), "Write pseudo alignment in sam format to file")
+					("bam", po::bool_switch()->default_value(settings.get_m_bam()), "Write pseudo alignment file in BGZF compressed BAM format")
+					("threads,t", po::value<uint32_t>()->default_value(settings.get_m_threads()), "Number of threads")
+					("quality,q", po::value<uint32_t>()->default_value(settings.get_m_qualityThreshold()), "Quality threshold for filtered reads")
+					("scanPrefix", po::value<uint32_t>()->default_value(settings.get_m_pseudoAligner_settings().get_m_scanPrefix()), "Prefix of read to use for alignment")
+					("earlyStop", po::value<uint32_t>()->default_value(settings.get_m_pseudoAligner_settings().get_m_earlyStopQuality()), "Stop scanning read at this mapping quality, 0 scans whole prefix")
+					("align", po::bool_switch()->default_value(settings.get_m_align()), "Write seed alignment with CIGAR instead of position estimate")
+					("seeds", po::value<std::string>()->default_value("distance"), "Seeds of alignment [distance|minimizer]")
+					("minimizerWindow", po::value<uint32_t>()->default_value(settings.get_m_pseudoAligner_settings().get_m_minimizerWindow()), "Consecutive k-mers per minimizer")
+					("maxChainGap", po::value<uint32_t>()->default_value(settings.get_m_pseudoAligner_settings().get_m_maxChainGap()), "Largest gap in read or reference between chained seeds")
+					("refine", po::bool_switch()->default_value(settings.get_m_pseudoAligner_settings().get_m_refineAlignment()), "Banded alignment of read and reference between seeds")
+					;
+				po::options_description allOpt;
+				allOpt.add(printOpt);
+				allOpt.add_options()
+					("prefix,p", po::value<std::string>()->required(), "Prefix of database")
+					("input,i", po::value<std::vector<std::string>>()->required()->composing(), "Input fastq files, directories or patterns")
+					("output,o", po::value<std::string>(), "Output directory for selected reads")	
+					;
+				po::positional_options_description pos;
+				// last positional input is the output directory
+				pos.add("prefix", 1).add("input", -1);
+				try
+				{
+					po::store(po::command_line_parser(opts).
+													 options(allOpt).
+													 positional(pos).
+													 run(), vm);
+					po::notify(vm);	
+					std::string dbPrefix = vm["prefix"].as<std::string>();
+					std::vector<std::string> inputs = vm["input"].as<std::vector<std::string>>();
+					std::string outDir;
+					if (vm.count("output"))
+						outDir = vm["output"].as<std::string>();
+					else if (inputs.size() > 1)
+					{
+						outDir = inputs.back();
+						inputs.pop_back();
+					}
+					else
+						throw po::required_option("output");
+					settings.set_m_sam(vm["sam"].as<std::string>());
+					settings.set_m_bam(vm["bam"].as<bool>());
+					settings.set_m_threads(vm["threads"].as<uint32_t>());
+					settings.set_m_qualityThreshold(vm["quality"].as<uint32_t>());
+					settings.get_m_pseudoAligner_settings().set_m_scanPrefix(vm["scanPrefix"].as<uint32_t>());
+					settings.get_m_pseudoAligner_settings().set_m_earlyStopQuality(vm["earlyStop"].as<uint32_t>());
+					settings.set_m_align(vm["align"].as<bool>());
+					std::string seeds = vm["seeds"].as<std::string>();
+					if (seeds == "minimizer")
+						settings.get_m_pseudoAligner_settings().set_m_seedEngine(e_seedMinimizer);
+					else if (seeds != "distance")
+						throw po::invalid_option_value(seeds);
+					settings.get_m_pseudoAligner_settings().set_m_minimizerWindow(vm["minimizerWindow"].as<uint32_t>());
+					settings.get_m_pseudoAligner_settings().set_m_maxChainGap(vm["maxChainGap"].as<uint32_t>());
+					settings.get_m_pseudoAligner_settings().set_m_refineAlignment(vm["refine"].as<bool>());
+					std::string cmd;
+					for (int i = 0; i < argc; i++)
+						cmd.append(std::string(argv[i]) + " ");
+					settings.set_m_cmd(cmd);
+					selectION sel(settings, dbPrefix);
+					auto inputFiles = fileFastxChain::expandPaths(inputs);
+					settings.logging().log(e_logInfo, "Scanning " + std::to_string(inputFiles.size()) + " input files");
+					fileFastxChain seq(inputFiles, settings.get_m_threads());
+					positionFilter filter;
+					if (vm.count("filter"))
+					{
+						std::string path2Filter = vm["filter"].as<std::string>();
+						uint32_t n = filter.addSelectors(path2Filter, vm["feature"].as<std::string>());
+						settings.logging().log(e_logInfo, "Successfully loaded " + std::to_string(n) + " selectors");
+						uint32_t unresolved = sel.resolveSelectors(filter);
+						if (unresolved > 0)
+							settings.logging().log(e_logWarning, std::to_string(unresolved) + " selectors on references not in index");
+					}				
+					if (!sel.select(seq, filter, outDir))
+						return 1;
+				}
+				catch (po::error&)
+				{
+					std::cout << "Usage: selection scan [options] <db.prefix> <input.fq|dir|pattern>... <outputDir>" << std::endl;
+					std::cout << printOpt;
+					return 0;
+				}
+			}
+			// keep index resident and answer queries on socket
+			else if (command == "serve")
+			{
+				selection_settings settings;
+				po::options_description printOpt("Server options");
+				printOpt.add_options()
+					("filter,f", po::value<std::string>(), "Input selection filter")
+					("feature", po::value<std::string>()->default_value(""), "GTF/GFF feature type of filter, all if empty")
+					("threads,t", po::value<uint32_t>()->default_value(settings.get_m_threads()), "Number of threads")
+					("quality,q", po::value<uint32_t>()->default_value(settings.get_m_qualityThreshold()), "Quality threshold for selector matches")
+					("scanPrefix", po::value<uint32_t>()->default_value(settings.get_m_pseudoAligner_settings().get_m_scanPrefix()), "Prefix of read to use for alignment")
+					("earlyStop", po::value<uint32_t>()->default_value(settings.get_m_pseudoAligner_settings().get_m_earlyStopQuality()), "Stop scanning read at this mapping quality, 0 scans whole prefix")
+					;
+				po::options_description allOpt;
+				allOpt.add(printOpt);
+				allOpt.add_options()
+					("prefix,p", po::value<std::string>()->required(), "Prefix of database")
+					("socket,s", po::value<std::string>()->required(), "Path of Unix domain socket")
+					;
+				po::positional_options_description pos;
+				pos.add("prefix", 1).add("socket", 1);
+				try
+				{
+					po::store(po::command_line_parser(opts).
+													 options(allOpt).
+													 positional(pos).
+													 run(), vm);
+					po::notify(vm);
+					settings.set_m_threads(vm["threads"].as<uint32_t>());
+					settings.set_m_qualityThreshold(vm["quality"].as<uint32_t>());
+					settings.get_m_pseudoAligner_settings().set_m_scanPrefix(vm["scanPrefix"].as<uint32_t>());
+					settings.get_m_pseudoAligner_settings().set_m_earlyStopQuality(vm["earlyStop"].as<uint32_t>());
+					selectION sel(settings, vm["prefix"].as<std::string>());
+					positionFilter filter;
+					if (vm.count("filter"))
+					{
+						uint32_t n = filter.addSelectors(vm["filter"].as<std::string>(), vm["feature"].as<std::string>());
+						settings.logging().log(e_logInfo, "Successfully loaded " + std::to_string(n) + " selectors");
+						uint32_t unresolved = sel.resolveSelectors(filter);
+						if (unresolved > 0)
+							settings.logging().log(e_logWarning, std::to_string(unresolved) + " selectors on references not in index");
+					}
+					selectionServer server(settings, sel, filter);
+					server.run(vm["socket"].as<std::string>());
+				}
+				catch (po::error&)
+				{
+					std::cout << "Usage: selection serve [options] <db.prefix> <socket>" << std::endl;
+					std::cout << printOpt;
+					return 0;
+				}
+			}
+			// send reads to running server, print results
+			else if (command == "query")
+			{
+				selection_settings settings;
+				po::options_description printOpt("Query options");
+				printOpt.add_options()
+					("batch,b", po::value<uint32_t>()->default_value(64), "Reads per request")
+					("length,l", po::value<uint32_t>()->default_value(0), "Bases sent of each read, 0 for all")
+					("chunk,c", po::value<uint32_t>()->default_value(0), "Stream reads in chunks of bases until decided, 0 sends whole reads")
+					;
+				po::options_description allOpt;
+				allOpt.add(printOpt);
+				allOpt.add_options()
+					("socket,s", po::value<std::string>()->required(), "Path of Unix domain socket")
+					("input,i", po::value<std::vector<std::string>>()->required()->composing(), "Input fastq files, directories or patterns")
+					;
+				po::positional_options_description pos;
+				pos.add("socket", 1).add("input", -1);
+				try
+				{
+					po::store(po::command_line_parser(opts).
+													 options(allOpt).
+													 positional(pos).
+													 run(), vm);
+					po::notify(vm);
+					const uint32_t batchSize = std::max(vm["batch"].as<uint32_t>(), 1u);
+					const uint32_t length = vm["length"].as<uint32_t>();
+					const uint32_t chunkSize = vm["chunk"].as<uint32_t>();
+					selectionClient client(vm["socket"].as<std::string>());
+					fileFastxChain seq(fileFastxChain::expandPaths(vm["input"].as<std::vector<std::string>>()), settings.get_m_threads());
+					std::vector<serveQuery> queries;
+					for (;;)
+					{
+						auto record = seq.getRecord();
+						if (record != NULL)
+						{
+							serveQuery query;
+							auto name = record->getName();
+							query.id = name.substr(0, name.find(' '));
+							query.sequence = length > 0 ? record->getSequence().substr(0, length) : record->getSequence();
+							queries.push_back(query);
+						}
+						if (queries.size() >= batchSize || (record == NULL && queries.size() > 0))
+						{
+							auto results = chunkSize > 0 ? client.stream(queries, chunkSize) : client.query(queries);
+							for (auto it = results.begin(); it != results.end(); ++it)
+								std::cout << serveResult2string(*it) << '\n';
+							std::cout.flush();
+							queries.clear();
+						}
+						if (record == NULL)
+							break;
+					}
+					std::cerr << client.getStatistics();
+				}
+				catch (po::error&)
+				{
+					std::cout << "Usage: selection query [options] <socket> <input.fq|dir|pattern>..." << std::endl;
+					std::cout << printOpt;
+					return 0;
+				}
+			}
+			else
+			{
+				printUsage();
+				return 0;
+			}
+		}
+		catch (po::error&)
+		{
+			// error specifying command
+			printUsage();
+			return 0;
+		}
+	}
+	catch (std::exception& e)
+	{
+		std::cerr	<< "Exception in selectION: \n" 
+					<< e.what() << "\n"
+					<< "Application closed." << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+void 
+printUsage()
+{
+	std::cout << "Program:\tSelectION" << std::endl
+		<< "Usage:\t\tselection <command> [options]" << std::endl
+		<< "Commands:\tindex : Build FM-Index for reference sequence" << std::endl
+		<< "\t\tconvert : Write memory mapped index for existing database" << std::endl
+		<< "\t\tselectors : Compile regions to memory mapped selector index" << std::endl
+		<< "\t\tscan : Scan input for reads matching specified positions" << std::endl
+		<< "\t\tserve : Answer position queries on Unix domain socket" << std::endl
+		<< "\t\tquery : Send reads to running server" << std::endl;
 }
\ No newline at end of file
@@ -0,0 +1,139 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class mappedFile
+//
+//  DESCRIPTION   :	Read-only memory mapping of a file
+//
+//  RESTRICTIONS  : POSIX systems
+//
+//  REQUIRES      : mmap
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+//-- private headers -----------------------------------------------------
+#include "mappedFile.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// default constructor
+mappedFile::mappedFile()
+{
+
+}
+
+
+
+
+// virtual destructor, unmaps file
+mappedFile::~mappedFile()
+{
+	close();
+}
+
+
+
+
+// map complete file read-only, throws if not possible
+void
+mappedFile::open
+(
+	std::string filePath
+)
+{
+	close();
+	int fd = ::open(filePath.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw std::invalid_argument("File " + filePath + " not found");
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+	{
+		::close(fd);
+		throw std::invalid_argument("File " + filePath + " is empty");
+	}
+	void* data = mmap(NULL, fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);		// mapping stays valid after closing descriptor
+	if (data == MAP_FAILED)
+		throw std::invalid_argument("Failed to map file " + filePath);
+	m_data = static_cast<const char*>(data);
+	m_size = fileStat.st_size;
+}
+
+
+
+
+// unmap file
+void
+mappedFile::close
+(
+	void
+)
+{
+	if (m_data != NULL)
+		munmap(const_cast<char*>(m_data), m_size);
+	m_data = NULL;
+	m_size = 0;
+}
+
+
+
+
+// true if file is mapped
+bool
+mappedFile::isOpen
+(
+	void
+) const
+{
+	return m_data != NULL;
+}
+
+
+
+
+// begin of mapped memory
+const char*
+mappedFile::data
+(
+	void
+) const
+{
+	return m_data;
+}
+
+
+
+
+// size of mapped file in Byte
+size_t
+mappedFile::size
+(
+	void
+) const
+{
+	return m_size;
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
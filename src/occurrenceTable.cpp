@@ -0,0 +1,214 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class occurrenceTable
+//
+//  DESCRIPTION   :	Cache line interleaved occurrence counts of the
+//					last bwt column
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : popcnt instruction
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <cstring>
+#include <stdexcept>
+
+//-- private headers -----------------------------------------------------
+#include "occurrenceTable.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const uint32_t CacheLineWords = 8;			// 64 bit words per cache line
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// default constructor
+occurrenceTable::occurrenceTable()
+{
+
+}
+
+
+
+
+// virtual destructor
+occurrenceTable::~occurrenceTable()
+{
+
+}
+
+
+
+
+// build from last column, charIndex maps characters to symbol codes
+void
+occurrenceTable::build
+(
+	std::string const & bwtLast,
+	std::vector<uint8_t> const & charIndex,
+	const uint8_t alphabetSize
+)
+{
+	clear();
+	const size_t blockCount = initLayout(static_cast<uint32_t>(bwtLast.size()), alphabetSize);
+
+	// allocate with space for cache line alignment
+	m_storage.assign(blockCount * m_blockWords + CacheLineWords, 0);
+	const size_t misalignment = reinterpret_cast<uintptr_t>(m_storage.data()) % (CacheLineWords * sizeof(uint64_t));
+	uint64_t* data = m_storage.data() + (misalignment ? CacheLineWords - misalignment / sizeof(uint64_t) : 0);
+
+	// fill blocks with preceding counts and bit-sliced symbols
+	std::vector<uint32_t> counts(alphabetSize, 0);
+	auto bwtIter = bwtLast.cbegin();
+	for (size_t blockIndex = 0; blockIndex < blockCount; blockIndex++)
+	{
+		uint64_t* block = data + blockIndex * m_blockWords;
+		if (alphabetSize > 0)
+			std::memcpy(block, counts.data(), alphabetSize * sizeof(uint32_t));
+		for (uint32_t i = 0; i <= m_blockMask && bwtIter != bwtLast.cend(); ++i, ++bwtIter)
+		{
+			uint8_t code = charIndex[static_cast<uint8_t>(*bwtIter)];
+			if (code < alphabetSize)
+				counts[code]++;
+			else
+				code = alphabetSize;
+			uint64_t* group = block + m_countWords + (i >> 6) * m_planes;
+			for (uint32_t j = 0; j < m_planes; ++j)
+				group[j] |= static_cast<uint64_t>((code >> j) & 1) << (i & 63);
+		}
+	}
+	m_data = data;
+}
+
+
+
+
+// use blocks in external memory, e.g. a mapped index file
+void
+occurrenceTable::attach
+(
+	const uint64_t* data,
+	const size_t words,
+	const uint32_t N,
+	const uint8_t alphabetSize
+)
+{
+	clear();
+	const size_t blockCount = initLayout(N, alphabetSize);
+	if (words < blockCount * m_blockWords)
+		throw std::invalid_argument("Occurrence table shorter than index");
+	m_data = data;
+}
+
+
+
+
+// release all memory
+void
+occurrenceTable::clear
+(
+	void
+)
+{
+	m_N = 0;
+	m_alphabetSize = 0;
+	m_data = NULL;
+	std::vector<uint64_t>().swap(m_storage);
+}
+
+
+
+
+// begin of blocks
+const uint64_t*
+occurrenceTable::data
+(
+	void
+) const
+{
+	return m_data;
+}
+
+
+
+
+// number of 64 bit words of all blocks
+size_t
+occurrenceTable::words
+(
+	void
+) const
+{
+	return m_data != NULL ? ((static_cast<size_t>(m_N) >> m_blockShift) + 1) * m_blockWords : 0;
+}
+
+
+
+
+// number of rows in table
+uint32_t
+occurrenceTable::size
+(
+	void
+) const
+{
+	return m_N;
+}
+
+
+
+
+// symbols covered by a single block
+uint32_t
+occurrenceTable::symbolsPerBlock
+(
+	void
+) const
+{
+	return m_blockMask + 1;
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// compute block layout, return number of blocks
+size_t
+occurrenceTable::initLayout
+(
+	const uint32_t N,
+	const uint8_t alphabetSize
+)
+{
+	m_N = N;
+	m_alphabetSize = alphabetSize;
+	// bits required for all symbols plus sentinel
+	m_planes = 1;
+	while ((1u << m_planes) <= alphabetSize)
+		m_planes++;
+	// counts as uint32 in front of block, at least one group of 64 symbols per block
+	m_countWords = (alphabetSize + 1) / 2;
+	m_blockWords = CacheLineWords;
+	while (m_blockWords < m_countWords + m_planes)
+		m_blockWords += CacheLineWords;
+	// power of two groups per block for shift based block lookup
+	const uint32_t groups = (m_blockWords - m_countWords) / m_planes;
+	uint32_t groupShift = 0;
+	while ((2u << groupShift) <= groups)
+		groupShift++;
+	m_blockShift = 6 + groupShift;
+	m_blockMask = (1u << m_blockShift) - 1;
+	return (static_cast<size_t>(m_N) >> m_blockShift) + 1;
+}
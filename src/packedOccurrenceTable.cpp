@@ -0,0 +1,392 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class packedOccurrenceTable
+//
+//  DESCRIPTION   :	Occurrence counts of 2-bit packed last bwt column
+//					with exception runs for sentinel and ambiguous bases
+//
+//  RESTRICTIONS  : less than 2^31 occurrences per base
+//
+//  REQUIRES      : popcnt instruction
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+//-- private headers -----------------------------------------------------
+#include "packedOccurrenceTable.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const std::string PackedAlphabet = "ACGT";		// characters with 2-bit code
+const uint32_t CacheLineWords = 8;				// 64 bit words per cache line
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// default constructor
+packedOccurrenceTable::packedOccurrenceTable()
+{
+
+}
+
+
+
+
+// virtual destructor
+packedOccurrenceTable::~packedOccurrenceTable()
+{
+
+}
+
+
+
+
+// pack symbols of last column, extend exception runs starting at row
+void
+packedOccurrenceTable::pack
+(
+	std::string const & bwt,
+	const size_t symbols,
+	const uint32_t row,
+	std::vector<uint8_t>& packed,
+	std::vector<bwtExceptionRun>& exceptions
+)
+{
+	packed.assign((symbols + 3) / 4, 0);
+	uint32_t currentRow = row;
+	for (size_t i = 0; i < symbols; ++i, ++currentRow)
+	{
+		const char chr = bwt[i];
+		const size_t code = PackedAlphabet.find(chr);
+		if (code != std::string::npos)
+		{
+			packed[i >> 2] |= static_cast<uint8_t>(code << (2 * (i & 3)));
+		}
+		else if (!exceptions.empty() && exceptions.back().chr == chr &&
+				 exceptions.back().row + exceptions.back().length == currentRow)
+		{
+			exceptions.back().length++;
+		}
+		else
+		{
+			bwtExceptionRun run;
+			run.row = currentRow;
+			run.length = 1;
+			run.chr = chr;
+			exceptions.push_back(run);
+		}
+	}
+}
+
+
+
+
+// build from packed last column, codes are positions in sorted alphabet
+void
+packedOccurrenceTable::build
+(
+	std::vector<uint8_t> const & packed,
+	const uint32_t N,
+	std::vector<bwtExceptionRun> const & exceptions,
+	std::string const & alphabet
+)
+{
+	clear();
+	if (packed.size() < (static_cast<size_t>(N) + 3) / 4)
+		throw std::invalid_argument("Packed last column shorter than index");
+	initExceptions(N, exceptions, alphabet);
+
+	// allocate with space for cache line alignment
+	const size_t blockCount = N / BlockSymbols + 1;
+	m_storage.assign(blockCount * BlockWords + CacheLineWords, 0);
+	const size_t misalignment = reinterpret_cast<uintptr_t>(m_storage.data()) % (CacheLineWords * sizeof(uint64_t));
+	uint64_t* data = m_storage.data() + (misalignment ? CacheLineWords - misalignment / sizeof(uint64_t) : 0);
+
+	// fill blocks with preceding counts and packed symbols
+	const size_t BlockBytes = BlockSymbols / 4;
+	uint64_t counts[4] = { 0, 0, 0, 0 };
+	auto runIter = m_exceptions.cbegin();
+	for (size_t blockIndex = 0; blockIndex < blockCount; blockIndex++)
+	{
+		uint64_t* block = data + blockIndex * BlockWords;
+		uint32_t* blockCounts = reinterpret_cast<uint32_t*>(block);
+		for (uint32_t i = 0; i < 4; ++i)
+		{
+			if (counts[i] > CountMask)
+				throw std::invalid_argument("Too many occurrences for packed last column");
+			blockCounts[i] = static_cast<uint32_t>(counts[i]);
+		}
+		const size_t blockStart = blockIndex * BlockSymbols;
+		const size_t blockEnd = std::min(blockStart + BlockSymbols, static_cast<size_t>(N));
+		std::memcpy(block + CountWords, packed.data() + blockIndex * BlockBytes,
+					std::min(BlockBytes, packed.size() - std::min(packed.size(), blockIndex * BlockBytes)));
+		// count valid symbols, exceptions are stored as A
+		for (size_t i = blockStart; i < blockEnd; i += 32)
+		{
+			uint64_t word = block[CountWords + (i - blockStart) / 32];
+			const size_t valid = std::min(static_cast<size_t>(32), blockEnd - i);
+			const uint64_t validMask = valid == 32 ? ~0ULL : (1ULL << (2 * valid)) - 1;
+			for (uint8_t code = 0; code < 4; ++code)
+				counts[code] += _mm_popcnt_u64(matchMask(word, code) & validMask);
+		}
+		while (runIter != m_exceptions.cend() && (*runIter).row < blockEnd)
+		{
+			const size_t first = std::max(static_cast<size_t>((*runIter).row), blockStart);
+			const size_t last = std::min(static_cast<size_t>((*runIter).row) + (*runIter).length, blockEnd);
+			counts[0] -= last - first;
+			blockCounts[0] |= ExceptionFlag;
+			if ((*runIter).row + (*runIter).length > blockEnd)
+				break;
+			++runIter;
+		}
+	}
+	m_data = data;
+}
+
+
+
+
+// use blocks in external memory, e.g. a mapped index file
+void
+packedOccurrenceTable::attach
+(
+	const uint64_t* data,
+	const size_t words,
+	const uint32_t N,
+	std::vector<bwtExceptionRun> const & exceptions,
+	std::string const & alphabet
+)
+{
+	clear();
+	initExceptions(N, exceptions, alphabet);
+	if (words < (N / BlockSymbols + 1) * BlockWords)
+		throw std::invalid_argument("Packed occurrence table shorter than index");
+	m_data = data;
+}
+
+
+
+
+// release all memory
+void
+packedOccurrenceTable::clear
+(
+	void
+)
+{
+	m_N = 0;
+	m_data = NULL;
+	m_alphabet.clear();
+	std::vector<uint8_t>().swap(m_packedCode);
+	std::vector<uint8_t>().swap(m_symbolCode);
+	std::vector<exceptionRun>().swap(m_exceptions);
+	std::vector<std::vector<exceptionRun>>().swap(m_symbolExceptions);
+	std::vector<uint64_t>().swap(m_storage);
+}
+
+
+
+
+// number of rows in table
+uint32_t
+packedOccurrenceTable::size
+(
+	void
+) const
+{
+	return m_N;
+}
+
+
+
+
+// begin of blocks
+const uint64_t*
+packedOccurrenceTable::data
+(
+	void
+) const
+{
+	return m_data;
+}
+
+
+
+
+// number of 64 bit words of all blocks
+size_t
+packedOccurrenceTable::words
+(
+	void
+) const
+{
+	return m_data != NULL ? (m_N / BlockSymbols + 1) * BlockWords : 0;
+}
+
+
+
+
+// exception runs with characters
+std::vector<bwtExceptionRun>
+packedOccurrenceTable::getExceptions
+(
+	void
+) const
+{
+	std::vector<bwtExceptionRun> exceptions;
+	for (auto it = m_exceptions.begin(); it != m_exceptions.end(); ++it)
+	{
+		bwtExceptionRun run;
+		run.row = (*it).row;
+		run.length = (*it).length;
+		run.chr = (*it).code < m_alphabet.size() ? m_alphabet[(*it).code] : '$';
+		exceptions.push_back(run);
+	}
+	return exceptions;
+}
+
+
+
+
+// number of exception runs
+size_t
+packedOccurrenceTable::exceptionRuns
+(
+	void
+) const
+{
+	return m_exceptions.size();
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// init symbol codes and exception runs
+void
+packedOccurrenceTable::initExceptions
+(
+	const uint32_t N,
+	std::vector<bwtExceptionRun> const & exceptions,
+	std::string const & alphabet
+)
+{
+	m_N = N;
+	m_alphabet = alphabet;
+	const uint8_t alphabetSize = static_cast<uint8_t>(alphabet.size());
+
+	// translate between symbol codes of the index and 2-bit codes
+	m_packedCode.assign(256, 4);
+	m_symbolCode.assign(4, alphabetSize);
+	for (uint8_t i = 0; i < alphabetSize; ++i)
+	{
+		const size_t code = PackedAlphabet.find(alphabet[i]);
+		if (code != std::string::npos)
+		{
+			m_packedCode[i] = static_cast<uint8_t>(code);
+			m_symbolCode[code] = i;
+		}
+	}
+
+	// exception runs with symbol codes and preceding counts
+	m_symbolExceptions.resize(alphabetSize + 1);
+	uint32_t lastRow = 0;
+	for (auto it = exceptions.begin(); it != exceptions.end(); ++it)
+	{
+		if ((*it).row < lastRow || (*it).length == 0 || static_cast<uint64_t>((*it).row) + (*it).length > N)
+			throw std::invalid_argument("Exception runs of packed last column corrupted");
+		lastRow = (*it).row + (*it).length;
+		const size_t code = alphabet.find((*it).chr);
+		exceptionRun run;
+		run.row = (*it).row;
+		run.length = (*it).length;
+		run.code = code != std::string::npos ? static_cast<uint8_t>(code) : alphabetSize;
+		auto& symbolRuns = m_symbolExceptions[run.code];
+		run.rank = symbolRuns.empty() ? 0 : symbolRuns.back().rank + symbolRuns.back().length;
+		symbolRuns.push_back(run);
+		m_exceptions.push_back(run);
+	}
+}
+
+
+
+
+// count of exception symbol up to and including row
+uint32_t
+packedOccurrenceTable::getExceptionCount
+(
+	const uint8_t code,
+	const uint32_t row
+) const
+{
+	if (code >= m_symbolExceptions.size() - 1)
+		return 0;
+	auto const & symbolRuns = m_symbolExceptions[code];
+	auto it = std::upper_bound(symbolRuns.begin(), symbolRuns.end(), row,
+		[](uint32_t lhs, exceptionRun const & rhs) -> bool{return lhs < rhs.row; });
+	if (it == symbolRuns.begin())
+		return 0;
+	--it;
+	return (*it).rank + std::min((*it).length, row - (*it).row + 1);
+}
+
+
+
+
+// number of exception rows in range [first, last]
+uint32_t
+packedOccurrenceTable::getExceptionOverlap
+(
+	const uint32_t first,
+	const uint32_t last
+) const
+{
+	auto it = std::upper_bound(m_exceptions.begin(), m_exceptions.end(), first,
+		[](uint32_t lhs, exceptionRun const & rhs) -> bool{return lhs < rhs.row; });
+	if (it != m_exceptions.begin())
+		--it;
+	uint32_t overlap = 0;
+	for (; it != m_exceptions.end() && (*it).row <= last; ++it)
+	{
+		const uint64_t runEnd = static_cast<uint64_t>((*it).row) + (*it).length;
+		const uint64_t begin = std::max((*it).row, first);
+		const uint64_t end = std::min(runEnd, static_cast<uint64_t>(last) + 1);
+		if (end > begin)
+			overlap += static_cast<uint32_t>(end - begin);
+	}
+	return overlap;
+}
+
+
+
+
+// symbol code of exception row, A if row is no exception
+uint8_t
+packedOccurrenceTable::getExceptionSymbol
+(
+	const uint32_t row
+) const
+{
+	auto it = std::upper_bound(m_exceptions.begin(), m_exceptions.end(), row,
+		[](uint32_t lhs, exceptionRun const & rhs) -> bool{return lhs < rhs.row; });
+	if (it != m_exceptions.begin())
+	{
+		--it;
+		if (row - (*it).row < (*it).length)
+			return (*it).code;
+	}
+	return m_symbolCode[0];
+}
@@ -0,0 +1,215 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class packedText
+//
+//  DESCRIPTION   :	2-bit packed forward text of the index with exception
+//					runs for sentinel and ambiguous bases
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <algorithm>
+#include <stdexcept>
+
+//-- private headers -----------------------------------------------------
+#include "packedText.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const char PackedCharacters[] = "ACGT";		// characters of 2-bit codes
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// default constructor
+packedText::packedText()
+{
+
+}
+
+
+
+
+// virtual destructor
+packedText::~packedText()
+{
+
+}
+
+
+
+
+// build from packed text
+void
+packedText::build
+(
+	std::vector<uint8_t> const & packed,
+	const uint32_t N,
+	std::vector<bwtExceptionRun> const & exceptions
+)
+{
+	clear();
+	if (packed.size() < (static_cast<size_t>(N) + 3) / 4)
+		throw std::invalid_argument("Packed text shorter than index");
+	initExceptions(N, exceptions);
+	m_storage = packed;
+	m_data = m_storage.data();
+}
+
+
+
+
+// use packed text in external memory, e.g. a mapped index file
+void
+packedText::attach
+(
+	const uint8_t* data,
+	const size_t bytes,
+	const uint32_t N,
+	std::vector<bwtExceptionRun> const & exceptions
+)
+{
+	clear();
+	if (bytes < (static_cast<size_t>(N) + 3) / 4)
+		throw std::invalid_argument("Packed text shorter than index");
+	initExceptions(N, exceptions);
+	m_data = data;
+}
+
+
+
+
+// release all memory
+void
+packedText::clear
+(
+	void
+)
+{
+	m_N = 0;
+	m_data = NULL;
+	std::vector<bwtExceptionRun>().swap(m_exceptions);
+	std::vector<uint8_t>().swap(m_storage);
+}
+
+
+
+
+// begin of packed text
+const uint8_t*
+packedText::data
+(
+	void
+) const
+{
+	return m_data;
+}
+
+
+
+
+// number of bytes of packed text
+size_t
+packedText::bytes
+(
+	void
+) const
+{
+	return m_data == NULL ? 0 : (static_cast<size_t>(m_N) + 3) / 4;
+}
+
+
+
+
+// exception runs with characters
+std::vector<bwtExceptionRun> const &
+packedText::getExceptions
+(
+	void
+) const
+{
+	return m_exceptions;
+}
+
+
+
+
+// number of text positions, 0 if no text is loaded
+uint32_t
+packedText::size
+(
+	void
+) const
+{
+	return m_N;
+}
+
+
+
+
+// substring of text, O(length) plus binary search in exception runs
+std::string
+packedText::getSequence
+(
+	const uint32_t start,
+	const uint32_t length
+) const
+{
+	if (static_cast<uint64_t>(start) + length > m_N)
+		throw std::out_of_range("Requested string out of index range");
+	std::string sequence(length, 'A');
+	for (uint32_t i = 0; i < length; i++)
+	{
+		const uint32_t position = start + i;
+		sequence[i] = PackedCharacters[(m_data[position >> 2] >> (2 * (position & 3))) & 3];
+	}
+	// overwrite positions of exception runs overlapping the substring
+	auto it = std::upper_bound(m_exceptions.begin(), m_exceptions.end(), start,
+		[](const uint32_t position, bwtExceptionRun const & run) -> bool { return position < run.row; });
+	if (it != m_exceptions.begin())
+		--it;
+	for (; it != m_exceptions.end() && (*it).row < start + length; ++it)
+	{
+		const uint32_t first = std::max((*it).row, start);
+		const uint32_t last = std::min((*it).row + (*it).length, start + length);
+		for (uint32_t position = first; position < last; position++)
+			sequence[position - start] = (*it).chr;
+	}
+	return sequence;
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// check and store exception runs
+void
+packedText::initExceptions
+(
+	const uint32_t N,
+	std::vector<bwtExceptionRun> const & exceptions
+)
+{
+	uint32_t lastPosition = 0;
+	for (auto it = exceptions.begin(); it != exceptions.end(); ++it)
+	{
+		if ((*it).row < lastPosition || (*it).length == 0 || static_cast<uint64_t>((*it).row) + (*it).length > N)
+			throw std::invalid_argument("Exception runs of packed text corrupted");
+		lastPosition = (*it).row + (*it).length;
+	}
+	m_N = N;
+	m_exceptions = exceptions;
+}
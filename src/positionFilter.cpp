@@ -1,238 +1,940 @@
-// \MODULE\---------------------------------------------------------------
-//
-//  CONTENTS      : Class positionFilter
-//
-//  DESCRIPTION   :	Decide if estimated position of read matches filter
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-// All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-
-//-- standard headers ----------------------------------------------------
-#include <sstream>
-#include <fstream>
-#include <algorithm>
-#include <cctype>
-#include <stdlib.h>
-
-//-- private headers -----------------------------------------------------
-#include "positionFilter.h"
-
-//-- source control system ID (if needed)---------------------------------
-
-//-- exported global variables - definitions (should be empty) -----------
-
-//-- private constants ---------------------------------------------------
-
-//-- private types -------------------------------------------------------
-typedef struct selector
-{
-public:
-	uint32_t m_start = 0;
-	uint32_t m_stop = 0xFFFFFFFF;
-	std::string m_description = "";
-}selector;
-
-
-//-- private functions --------- declarations ----------------------------
-bool is_number(const std::string& s);
-
-//-- private global variables -- definitions (should be empty) -----------
-
-//-- exported functions -------- definitions -----------------------------
-// constructor
-positionFilter::positionFilter()
-{
-
-}
-
-
-
-
-// virtual destructor
-positionFilter::~positionFilter()
-{
-
-}
-
-
-
-
-// load selectors from stream of csv lines (ref;start[;stop])
-uint32_t 
-positionFilter::addSelectors
-(
-	std::string path2csv
-)
-{
-	std::ifstream selectors(path2csv);
-	if (selectors.good())
-		return addSelectors(selectors);
-	else
-		throw std::invalid_argument("File " + path2csv + " not found");
-}
-
-
-
-
-uint32_t 
-positionFilter::addSelectors
-(
-	std::istream& selectorLines
-)
-{
-	std::string rawLine;
-	uint32_t parsedSelectors = 0;
-	while (std::getline(selectorLines, rawLine))
-	{
-		if (rawLine.size() > 0 && rawLine[0] != '#')
-		{
-			std::istringstream lineStream(rawLine);
-			std::string cell;
-			std::vector<std::string> cols;
-			while (std::getline(lineStream, cell, ';'))
-			{
-				cols.push_back(cell);
-			}
-            if (cols.size() < 1 || cols.size() > 4)
-                continue;
-			selector sel;
-            std::string key = cols[0];
-            try
-            {
-                if (cols.size() > 1)
-                {
-                    if (is_number(cols[1]))
-                        sel.m_start = std::stoi(cols[1]);
-                    else
-                        sel.m_description = cols[1];
-                }
-                if (cols.size() > 2)
-                {
-                    if (is_number(cols[2]))
-                        sel.m_stop = std::stoi(cols[2]);
-                    else
-                    {
-                        sel.m_stop = sel.m_start;
-                        sel.m_description = cols[2];
-                    }
-                }
-            }
-            catch(...)
-            {
-                // no handling, ignore line
-                continue;
-            }
-            if (cols.size() > 3)
-                sel.m_description = cols[3];
-            else if (sel.m_description == "")
-                sel.m_description = key + "_" +
-										std::to_string(sel.m_start) + "_" +
-										std::to_string(sel.m_stop);
-            m_selectors[key].push_back(sel);
-            parsedSelectors++;
-		}
-	}
-	// sort selector map entries by end position
-	for (auto it = m_selectors.begin(); it != m_selectors.end(); ++it)
-	{
-		auto regions = (*it).second;
-		std::sort(regions.begin(), regions.end(),
-			[](selector lhs, selector rhs)
-			-> bool {return lhs.m_stop < rhs.m_stop; });
-	}
-	return parsedSelectors;
-}
-
-
-
-
-// clear all selector definitions
-void 
-positionFilter::clearSelectors
-(
-	void
-)
-{
-	m_selectors.clear();
-}
-
-
-
-
-// get number of active selectors
-uint32_t 
-positionFilter::getActiveSelectorCount(void)
-{
-	return m_selectors.size();
-}
-
-
-
-
-// check if position matches filter
-// return list of match descriptions
-std::vector<std::string> 
-positionFilter::match
-(
-	std::string ref, 
-	uint32_t pos
-)
-{
-	return match(ref, pos, 0);
-}
-
-
-
-
-// check if position matches filter with respect to read length
-// return list of match descriptions
-std::vector<std::string> 
-positionFilter::match
-(
-	std::string ref, 
-	uint32_t pos, 
-	uint32_t length
-)
-{
-	std::vector<std::string> matches;
-	if (m_selectors.count(ref))
-	{
-		auto regions = m_selectors[ref];
-		auto lower = std::lower_bound(regions.begin(), regions.end(), pos,
-			[](selector lhs, uint32_t rhs)
-			-> bool {return lhs.m_stop < rhs; });
-		while (lower != regions.end())
-		{
-			if (pos <= (*lower).m_stop && pos + length >= (*lower).m_start)
-				matches.push_back((*lower).m_description);
-			if (pos > (*lower).m_stop)
-				break;
-			lower++;
-		}
-		return matches;
-	}
-	else
-		return matches;
-}
-
-
-
-
-//-- private functions --------- definitions -----------------------------
-bool 
-is_number
-(
-    const std::string& s
-)
-{
-    // http://ideone.com/OjVJWh
-    return !s.empty() && std::all_of(s.begin(), s.end(), ::isdigit);
-}
-
-
-
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class positionFilter
+//
+//  DESCRIPTION   :	Decide if estimated position of read matches filter
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : mmap
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_set>
+#include <stdlib.h>
+
+//-- private headers -----------------------------------------------------
+#include "positionFilter.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const int32_t ScanLevel = 3;		// subtrees up to this level are scanned linearly
+const char SelectorIndexMagic[8] = { 'S', 'E', 'L', 'S', 'E', 'L', '1', '\0' };	// first bytes of selector index
+const uint32_t SelectorIndexVersion = 1;				// version of selector index layout
+const uint64_t SelectorSectionAlignment = 8;			// alignment of sections in selector index
+const char* const GtfDescriptionKeys[] = { "gene_name", "gene_id", "Name", "ID" };	// by preference
+
+//-- private types -------------------------------------------------------
+// node of interval tree traversal
+typedef struct treeNode
+{
+	int32_t level;
+	int64_t index;
+	bool visited;
+}treeNode;
+
+
+// sections of selector index file
+enum SelectorIndexSection
+{
+	e_selectorReferences = 0,		// name length and name of references
+	e_selectorRanges,				// first interval, count and tree level by reference
+	e_selectorIntervals,			// sorted intervals with subtree maxima
+	e_selectorDescriptionOffsets,	// begin of description by selector, one past last
+	e_selectorDescriptionText,		// concatenated descriptions
+	e_selectorSectionCount
+};
+
+
+// first bytes of selector index, all values in native byte order
+typedef struct SelectorIndexHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t intervalSize;
+	uint64_t referenceCount;
+	uint64_t intervalCount;
+	uint64_t selectorCount;
+	uint64_t offset[e_selectorSectionCount];
+	uint64_t size[e_selectorSectionCount];
+}SelectorIndexHeader;
+
+
+// begin and end of a field in a line
+typedef std::pair<const char*, const char*> lineField;
+
+//-- private functions --------- declarations ----------------------------
+bool is_number(const std::string& s);
+size_t splitFields(std::string const & line, const char* separators, std::vector<lineField>& fields);
+bool parseUnsigned(lineField const & field, uint32_t& value);
+bool gtfAttribute(lineField const & attributes, const char* key, std::string& value);
+std::string chapterName(std::string const & ref, std::unordered_set<std::string> const & chapters);
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor
+positionFilter::positionFilter()
+{
+	m_descriptionOffsetStorage.assign(1, 0);
+	buildIndex();
+}
+
+
+
+
+// virtual destructor
+positionFilter::~positionFilter()
+{
+
+}
+
+
+
+
+// load selectors from compiled selector index, BED (.bed), GTF/GFF (.gtf, .gff, .gff3)
+// or csv lines (ref;start[;stop]), GTF/GFF features of given type only if not empty
+uint32_t
+positionFilter::addSelectors
+(
+	std::string path2csv
+)
+{
+	return addSelectors(path2csv, "");
+}
+
+
+
+
+uint32_t
+positionFilter::addSelectors
+(
+	std::string path,
+	std::string feature
+)
+{
+	if (isIndex(path))
+		return loadIndex(path);
+	std::ifstream selectors(path);
+	if (!selectors.good())
+		throw std::invalid_argument("File " + path + " not found");
+	const size_t dot = path.find_last_of('.');
+	std::string extension = dot == std::string::npos ? "" : path.substr(dot);
+	std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+	if (extension == ".bed")
+		return addBed(selectors);
+	if (extension == ".gtf" || extension == ".gff" || extension == ".gff3")
+		return addGtf(selectors, feature);
+	return addSelectors(selectors);
+}
+
+
+
+
+// load selectors from stream of csv lines (ref;start[;stop])
+uint32_t 
+positionFilter::addSelectors
+(
+	std::istream& selectorLines
+)
+{
+	detachIndex();
+	std::string rawLine;
+	uint32_t parsedSelectors = 0;
+	while (std::getline(selectorLines, rawLine))
+	{
+		if (rawLine.size() > 0 && rawLine[0] != '#')
+		{
+			std::istringstream lineStream(rawLine);
+			std::string cell;
+			std::vector<std::string> cols;
+			while (std::getline(lineStream, cell, ';'))
+			{
+				cols.push_back(cell);
+			}
+            if (cols.size() < 1 || cols.size() > 4)
+                continue;
+			uint32_t start = 0;
+			uint32_t stop = 0xFFFFFFFF;
+			std::string description;
+            std::string key = cols[0];
+            try
+            {
+                if (cols.size() > 1)
+                {
+                    if (is_number(cols[1]))
+                        start = std::stoi(cols[1]);
+                    else
+                        description = cols[1];
+                }
+                if (cols.size() > 2)
+                {
+                    if (is_number(cols[2]))
+                        stop = std::stoi(cols[2]);
+                    else
+                    {
+                        stop = start;
+                        description = cols[2];
+                    }
+                }
+            }
+            catch(...)
+            {
+                // no handling, ignore line
+                continue;
+            }
+            if (cols.size() > 3)
+                description = cols[3];
+            else if (description == "")
+                description = key + "_" +
+										std::to_string(start) + "_" +
+										std::to_string(stop);
+            addInterval(key, start, stop, description);
+            parsedSelectors++;
+		}
+	}
+	buildIndex();
+	return parsedSelectors;
+}
+
+
+
+
+// load BED regions, name column or region as description
+uint32_t
+positionFilter::addBed
+(
+	std::istream& bedLines
+)
+{
+	detachIndex();
+	std::string line;
+	std::string ref;
+	std::string description;
+	std::vector<lineField> fields;
+	uint32_t parsedSelectors = 0;
+	while (std::getline(bedLines, line))
+	{
+		if (line.empty() || line[0] == '#' || line.compare(0, 5, "track") == 0 || line.compare(0, 7, "browser") == 0)
+			continue;
+		uint32_t start = 0;
+		uint32_t end = 0;
+		// names may contain spaces, columns are tab separated only
+		if (splitFields(line, "\t", fields) < 3 || !parseUnsigned(fields[1], start) ||
+			!parseUnsigned(fields[2], end) || end < start || start == UINT32_MAX)
+			continue;
+		ref.assign(fields[0].first, fields[0].second);
+		// zero based half open to one based closed interval, zero length features select position start
+		end = std::max(end, start + 1);
+		if (fields.size() > 3 && fields[3].first != fields[3].second)
+			description.assign(fields[3].first, fields[3].second);
+		else
+			description = ref + "_" + std::to_string(start + 1) + "_" + std::to_string(end);
+		addInterval(ref, start + 1, end, description);
+		parsedSelectors++;
+	}
+	buildIndex();
+	return parsedSelectors;
+}
+
+
+
+
+// load GTF or GFF features, gene name or id as description, all features if empty
+uint32_t
+positionFilter::addGtf
+(
+	std::istream& gtfLines,
+	std::string const & feature
+)
+{
+	detachIndex();
+	std::string line;
+	std::string ref;
+	std::string description;
+	std::vector<lineField> fields;
+	uint32_t parsedSelectors = 0;
+	while (std::getline(gtfLines, line))
+	{
+		if (line.empty() || line[0] == '#')
+			continue;
+		uint32_t start = 0;
+		uint32_t stop = 0;
+		if (splitFields(line, "\t", fields) < 8 || !parseUnsigned(fields[3], start) ||
+			!parseUnsigned(fields[4], stop) || stop < start)
+			continue;
+		if (!feature.empty() && feature.compare(0, std::string::npos, fields[2].first,
+			static_cast<size_t>(fields[2].second - fields[2].first)) != 0)
+			continue;
+		ref.assign(fields[0].first, fields[0].second);
+		bool named = false;
+		for (size_t i = 0; fields.size() > 8 && !named && i < sizeof(GtfDescriptionKeys) / sizeof(GtfDescriptionKeys[0]); i++)
+			named = gtfAttribute(fields[8], GtfDescriptionKeys[i], description);
+		if (!named)
+			description = ref + "_" + std::to_string(start) + "_" + std::to_string(stop);
+		addInterval(ref, start, stop, description);
+		parsedSelectors++;
+	}
+	buildIndex();
+	return parsedSelectors;
+}
+
+
+
+
+// rename references to chapters of index, e.g. 1 to chr1 and MT to chrM,
+// return number of selectors on references not found in chapters
+uint32_t
+positionFilter::resolveReferences
+(
+	std::vector<std::pair<std::string, uint32_t>> const & chapters
+)
+{
+	std::unordered_set<std::string> chapterNames;
+	for (auto it = chapters.begin(); it != chapters.end(); ++it)
+		chapterNames.insert((*it).first);
+	std::unordered_map<std::string, uint32_t> referenceIds;
+	std::vector<std::string> referenceNames;
+	std::vector<uint32_t> remap(m_referenceNames.size());
+	uint32_t unresolved = 0;
+	bool merged = false;
+	for (size_t i = 0; i < m_referenceNames.size(); i++)
+	{
+		std::string name = chapterName(m_referenceNames[i], chapterNames);
+		if (name.empty())
+		{
+			name = m_referenceNames[i];
+			unresolved += m_references[i].count;
+		}
+		auto it = referenceIds.find(name);
+		if (it == referenceIds.end())
+		{
+			it = referenceIds.insert(std::make_pair(name, static_cast<uint32_t>(referenceNames.size()))).first;
+			referenceNames.push_back(name);
+		}
+		remap[i] = (*it).second;
+		merged |= remap[i] != i;
+	}
+	// references resolving to the same chapter are merged into one tree
+	if (merged)
+	{
+		detachIndex();
+		for (auto it = m_intervals.begin(); it != m_intervals.end(); ++it)
+			(*it).referenceId = remap[(*it).referenceId];
+	}
+	m_referenceNames.swap(referenceNames);
+	m_referenceIds.swap(referenceIds);
+	if (merged)
+		buildIndex();
+	return unresolved;
+}
+
+
+
+
+// write compiled selector index
+void
+positionFilter::saveIndex
+(
+	std::string path
+) const
+{
+	// serialize references, intervals and descriptions are written in place
+	std::string references;
+	for (auto it = m_referenceNames.begin(); it != m_referenceNames.end(); ++it)
+	{
+		const uint32_t length = static_cast<uint32_t>((*it).size());
+		references.append(reinterpret_cast<const char*>(&length), sizeof(length));
+		references.append(*it);
+	}
+	std::vector<std::pair<const char*, uint64_t>> sections(e_selectorSectionCount);
+	sections[e_selectorReferences] = std::make_pair(references.data(), references.size());
+	sections[e_selectorRanges] = std::make_pair(reinterpret_cast<const char*>(m_references.data()), m_references.size() * sizeof(referenceRange));
+	sections[e_selectorIntervals] = std::make_pair(reinterpret_cast<const char*>(m_intervalData), m_intervalCount * sizeof(selectorInterval));
+	sections[e_selectorDescriptionOffsets] = std::make_pair(reinterpret_cast<const char*>(m_descriptionOffsets), (m_selectorCount + 1) * sizeof(uint32_t));
+	sections[e_selectorDescriptionText] = std::make_pair(m_descriptionText, static_cast<uint64_t>(m_descriptionOffsets[m_selectorCount]));
+
+	// header first, sections start at following aligned offsets
+	SelectorIndexHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, SelectorIndexMagic, sizeof(SelectorIndexMagic));
+	header.version = SelectorIndexVersion;
+	header.intervalSize = sizeof(selectorInterval);
+	header.referenceCount = m_referenceNames.size();
+	header.intervalCount = m_intervalCount;
+	header.selectorCount = m_selectorCount;
+	uint64_t offset = (sizeof(header) + SelectorSectionAlignment - 1) / SelectorSectionAlignment * SelectorSectionAlignment;
+	for (size_t i = 0; i < sections.size(); i++)
+	{
+		header.offset[i] = offset;
+		header.size[i] = sections[i].second;
+		offset += (sections[i].second + SelectorSectionAlignment - 1) / SelectorSectionAlignment * SelectorSectionAlignment;
+	}
+
+	// write sections with zero padding
+	std::ofstream outputStream(path, std::ios::binary | std::ios::trunc);
+	if (!outputStream.is_open())
+		throw std::invalid_argument("Could not open " + path + " for writing");
+	const char padding[SelectorSectionAlignment] = { 0 };
+	outputStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	uint64_t position = sizeof(header);
+	for (size_t i = 0; i < sections.size(); i++)
+	{
+		outputStream.write(padding, header.offset[i] - position);
+		outputStream.write(sections[i].first, sections[i].second);
+		position = header.offset[i] + sections[i].second;
+	}
+	outputStream.close();
+	if (outputStream.fail())
+		throw std::invalid_argument("Failed to write selector index " + path);
+}
+
+
+
+
+// true if file is a compiled selector index
+bool
+positionFilter::isIndex
+(
+	std::string path
+)
+{
+	std::ifstream inputStream(path, std::ios::binary);
+	char magic[sizeof(SelectorIndexMagic)];
+	inputStream.read(magic, sizeof(magic));
+	return inputStream.gcount() == sizeof(magic) && std::memcmp(magic, SelectorIndexMagic, sizeof(magic)) == 0;
+}
+
+
+
+
+// clear all selector definitions
+void 
+positionFilter::clearSelectors
+(
+	void
+)
+{
+	m_referenceIds.clear();
+	m_referenceNames.clear();
+	m_selectorIds.clear();
+	m_intervals.clear();
+	m_descriptionOffsetStorage.assign(1, 0);
+	m_descriptionTextStorage.clear();
+	m_mappedIndex.close();
+	buildIndex();
+}
+
+
+
+
+// get number of active selectors
+uint32_t 
+positionFilter::getActiveSelectorCount(void) const
+{
+	return static_cast<uint32_t>(m_intervalCount);
+}
+
+
+
+
+// id of reference name, -1 if no selector is defined on reference
+int32_t
+positionFilter::getReferenceId
+(
+	std::string const & ref
+) const
+{
+	auto it = m_referenceIds.find(ref);
+	return it != m_referenceIds.end() ? static_cast<int32_t>((*it).second) : -1;
+}
+
+
+
+
+// description of selector returned by match
+std::string
+positionFilter::getDescription
+(
+	uint32_t selector
+) const
+{
+	if (selector >= m_selectorCount)
+		throw std::out_of_range("Selector " + std::to_string(selector) + " not defined");
+	return std::string(m_descriptionText + m_descriptionOffsets[selector],
+		m_descriptionOffsets[selector + 1] - m_descriptionOffsets[selector]);
+}
+
+
+
+
+// check if position matches filter
+// return list of match descriptions
+std::vector<std::string> 
+positionFilter::match
+(
+	std::string ref, 
+	uint32_t pos
+) const
+{
+	return match(ref, pos, 0);
+}
+
+
+
+
+// check if position matches filter with respect to read length
+// return list of match descriptions
+std::vector<std::string> 
+positionFilter::match
+(
+	std::string ref, 
+	uint32_t pos, 
+	uint32_t length
+) const
+{
+	std::vector<uint32_t> selectors;
+	match(getReferenceId(ref), pos, length, selectors);
+	std::vector<std::string> matches;
+	for (auto it = selectors.begin(); it != selectors.end(); ++it)
+		matches.push_back(getDescription(*it));
+	return matches;
+}
+
+
+
+
+// replace selectors by those overlapping [pos, pos + length] on reference id
+void
+positionFilter::match
+(
+	int32_t referenceId,
+	uint32_t pos,
+	uint32_t length,
+	std::vector<uint32_t>& selectors
+) const
+{
+	selectors.clear();
+	if (referenceId < 0 || static_cast<size_t>(referenceId) >= m_references.size())
+		return;
+	auto const & range = m_references[referenceId];
+	const selectorInterval* intervals = m_intervalData + range.offset;
+	const int64_t n = range.count;
+	const uint64_t queryEnd = static_cast<uint64_t>(pos) + length;
+	// depth first traversal, left subtree is skipped if no stop reaches pos
+	treeNode stack[64];
+	int32_t top = 0;
+	if (range.maxLevel >= 0)
+		stack[top++] = treeNode{ range.maxLevel, (int64_t(1) << range.maxLevel) - 1, false };
+	while (top > 0)
+	{
+		const treeNode node = stack[--top];
+		if (node.level <= ScanLevel)
+		{
+			const int64_t first = node.index >> node.level << node.level;
+			const int64_t last = std::min(first + (int64_t(1) << (node.level + 1)) - 1, n);
+			for (int64_t i = first; i < last && intervals[i].start <= queryEnd; i++)
+			{
+				if (pos <= intervals[i].stop)
+					selectors.push_back(intervals[i].selector);
+			}
+		}
+		else if (!node.visited)
+		{
+			// nodes beyond the array may still have existing left descendants
+			const int64_t left = node.index - (int64_t(1) << (node.level - 1));
+			stack[top++] = treeNode{ node.level, node.index, true };
+			if (left >= n || intervals[left].maxStop >= pos)
+				stack[top++] = treeNode{ node.level - 1, left, false };
+		}
+		else if (node.index < n && intervals[node.index].start <= queryEnd)
+		{
+			if (pos <= intervals[node.index].stop)
+				selectors.push_back(intervals[node.index].selector);
+			stack[top++] = treeNode{ node.level - 1, node.index + (int64_t(1) << (node.level - 1)), false };
+		}
+	}
+	// intervals sharing a description report the selector once
+	if (selectors.size() > 1)
+	{
+		std::sort(selectors.begin(), selectors.end());
+		selectors.erase(std::unique(selectors.begin(), selectors.end()), selectors.end());
+	}
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// map compiled selector index, merged if selectors exist
+uint32_t
+positionFilter::loadIndex
+(
+	std::string path
+)
+{
+	const bool merge = m_intervalCount > 0 || !m_referenceNames.empty();
+	mappedFile mergedIndex;
+	mappedFile& index = merge ? mergedIndex : m_mappedIndex;
+	index.open(path);
+	const char* base = index.data();
+	const uint64_t fileSize = index.size();
+	SelectorIndexHeader header;
+	if (fileSize < sizeof(header))
+		throw std::invalid_argument("Selector index " + path + " corrupted");
+	std::memcpy(&header, base, sizeof(header));
+	if (header.version != SelectorIndexVersion || header.intervalSize != sizeof(selectorInterval))
+		throw std::invalid_argument("Selector index " + path + " has unsupported version " + std::to_string(header.version));
+	for (size_t i = 0; i < e_selectorSectionCount; i++)
+	{
+		if (header.offset[i] % SelectorSectionAlignment != 0 || header.offset[i] > fileSize ||
+			header.size[i] > fileSize - header.offset[i])
+			throw std::invalid_argument("Selector index " + path + " corrupted");
+	}
+	if (header.size[e_selectorRanges] != header.referenceCount * sizeof(referenceRange) ||
+		header.size[e_selectorIntervals] != header.intervalCount * sizeof(selectorInterval) ||
+		header.size[e_selectorDescriptionOffsets] != (header.selectorCount + 1) * sizeof(uint32_t))
+		throw std::invalid_argument("Selector index " + path + " corrupted");
+	const referenceRange* ranges = reinterpret_cast<const referenceRange*>(base + header.offset[e_selectorRanges]);
+	const selectorInterval* intervals = reinterpret_cast<const selectorInterval*>(base + header.offset[e_selectorIntervals]);
+	const uint32_t* descriptionOffsets = reinterpret_cast<const uint32_t*>(base + header.offset[e_selectorDescriptionOffsets]);
+	const char* descriptionText = base + header.offset[e_selectorDescriptionText];
+	if (descriptionOffsets[header.selectorCount] != header.size[e_selectorDescriptionText])
+		throw std::invalid_argument("Selector index " + path + " corrupted");
+	// mapped and merged index are both accessed without further checks
+	for (uint64_t i = 0; i < header.referenceCount; i++)
+	{
+		if (static_cast<uint64_t>(ranges[i].offset) + ranges[i].count > header.intervalCount ||
+			ranges[i].maxLevel < -1 || ranges[i].maxLevel >= 32)
+			throw std::invalid_argument("Selector index " + path + " corrupted");
+	}
+	for (uint64_t i = 0; i < header.selectorCount; i++)
+	{
+		if (descriptionOffsets[i] > descriptionOffsets[i + 1])
+			throw std::invalid_argument("Selector index " + path + " corrupted");
+	}
+	for (uint64_t i = 0; i < header.intervalCount; i++)
+	{
+		if (intervals[i].referenceId >= header.referenceCount || intervals[i].selector >= header.selectorCount)
+			throw std::invalid_argument("Selector index " + path + " corrupted");
+	}
+
+	// read reference names
+	std::vector<std::string> referenceNames;
+	const char* section = base + header.offset[e_selectorReferences];
+	for (uint64_t pos = 0; pos < header.size[e_selectorReferences];)
+	{
+		uint32_t length = 0;
+		if (header.size[e_selectorReferences] - pos < sizeof(length))
+			throw std::invalid_argument("Selector index " + path + " corrupted");
+		std::memcpy(&length, section + pos, sizeof(length));
+		pos += sizeof(length);
+		if (header.size[e_selectorReferences] - pos < length)
+			throw std::invalid_argument("Selector index " + path + " corrupted");
+		referenceNames.push_back(std::string(section + pos, length));
+		pos += length;
+	}
+	if (referenceNames.size() != header.referenceCount)
+		throw std::invalid_argument("Selector index " + path + " corrupted");
+
+	// selectors exist already, intervals of index are added
+	if (merge)
+	{
+		detachIndex();
+		for (uint64_t i = 0; i < header.intervalCount; i++)
+		{
+			const uint32_t selector = intervals[i].selector;
+			addInterval(referenceNames[intervals[i].referenceId], intervals[i].start, intervals[i].stop,
+				std::string(descriptionText + descriptionOffsets[selector], descriptionOffsets[selector + 1] - descriptionOffsets[selector]));
+		}
+		buildIndex();
+		return static_cast<uint32_t>(header.intervalCount);
+	}
+	m_referenceNames.swap(referenceNames);
+	m_referenceIds.clear();
+	for (size_t i = 0; i < m_referenceNames.size(); i++)
+		m_referenceIds[m_referenceNames[i]] = static_cast<uint32_t>(i);
+	m_references.assign(ranges, ranges + header.referenceCount);
+	m_intervalData = intervals;
+	m_intervalCount = header.intervalCount;
+	m_descriptionOffsets = descriptionOffsets;
+	m_descriptionText = descriptionText;
+	m_selectorCount = header.selectorCount;
+	return static_cast<uint32_t>(header.intervalCount);
+}
+
+
+
+
+// copy mapped intervals to memory before selectors are added
+void
+positionFilter::detachIndex
+(
+	void
+)
+{
+	if (!m_mappedIndex.isOpen())
+		return;
+	m_intervals.assign(m_intervalData, m_intervalData + m_intervalCount);
+	m_descriptionOffsetStorage.assign(m_descriptionOffsets, m_descriptionOffsets + m_selectorCount + 1);
+	m_descriptionTextStorage.assign(m_descriptionText, m_descriptionOffsets[m_selectorCount]);
+	m_selectorIds.clear();
+	for (size_t i = 0; i < m_selectorCount; i++)
+		m_selectorIds[getDescription(static_cast<uint32_t>(i))] = static_cast<uint32_t>(i);
+	m_mappedIndex.close();
+	buildIndex();
+}
+
+
+
+
+// add selector on reference, stop inclusive
+void
+positionFilter::addInterval
+(
+	std::string const & ref,
+	uint32_t start,
+	uint32_t stop,
+	std::string const & description
+)
+{
+	selectorInterval interval;
+	interval.start = start;
+	interval.stop = stop;
+	interval.referenceId = internReference(ref);
+	// selectors with equal description share one id
+	auto it = m_selectorIds.find(description);
+	if (it == m_selectorIds.end())
+	{
+		it = m_selectorIds.insert(std::make_pair(description, static_cast<uint32_t>(m_descriptionOffsetStorage.size() - 1))).first;
+		m_descriptionTextStorage.append(description);
+		m_descriptionOffsetStorage.push_back(static_cast<uint32_t>(m_descriptionTextStorage.size()));
+	}
+	interval.selector = (*it).second;
+	m_intervals.push_back(interval);
+}
+
+
+
+
+// sort intervals and build interval trees of all references
+void
+positionFilter::buildIndex
+(
+	void
+)
+{
+	std::sort(m_intervals.begin(), m_intervals.end(),
+		[](selectorInterval const & lhs, selectorInterval const & rhs)
+		-> bool { return lhs.referenceId < rhs.referenceId ||
+			(lhs.referenceId == rhs.referenceId && lhs.start < rhs.start); });
+	m_references.assign(m_referenceNames.size(), referenceRange());
+	for (size_t i = 0; i < m_intervals.size(); i++)
+	{
+		auto& range = m_references[m_intervals[i].referenceId];
+		if (range.count == 0)
+			range.offset = static_cast<uint32_t>(i);
+		range.count++;
+	}
+	// implicit tree in sorted order, leaves at even indices, node i on level
+	// k has children i - 2^(k-1) and i + 2^(k-1)
+	for (auto it = m_references.begin(); it != m_references.end(); ++it)
+	{
+		selectorInterval* intervals = m_intervals.data() + (*it).offset;
+		const int64_t n = (*it).count;
+		if (n == 0)
+			continue;
+		int64_t lastIndex = 0;
+		for (int64_t i = 0; i < n; i += 2)
+		{
+			lastIndex = i;
+			intervals[i].maxStop = intervals[i].stop;
+		}
+		uint32_t lastMax = intervals[lastIndex].maxStop;
+		int32_t level = 1;
+		for (; (int64_t(1) << level) <= n; level++)
+		{
+			const int64_t offset = int64_t(1) << (level - 1);
+			for (int64_t i = (offset << 1) - 1; i < n; i += offset << 2)
+			{
+				// right subtree may be incomplete, its maximum is then carried by the last node
+				const uint32_t leftMax = intervals[i - offset].maxStop;
+				const uint32_t rightMax = i + offset < n ? intervals[i + offset].maxStop : lastMax;
+				intervals[i].maxStop = std::max(intervals[i].stop, std::max(leftMax, rightMax));
+			}
+			lastIndex = (lastIndex >> level & 1) ? lastIndex - offset : lastIndex + offset;
+			if (lastIndex < n)
+				lastMax = std::max(lastMax, intervals[lastIndex].maxStop);
+		}
+		(*it).maxLevel = level - 1;
+	}
+	m_intervalData = m_intervals.data();
+	m_intervalCount = m_intervals.size();
+	m_descriptionOffsets = m_descriptionOffsetStorage.data();
+	m_descriptionText = m_descriptionTextStorage.data();
+	m_selectorCount = m_descriptionOffsetStorage.size() - 1;
+}
+
+
+
+
+// id of reference name, added if not existing
+uint32_t
+positionFilter::internReference
+(
+	std::string const & ref
+)
+{
+	auto it = m_referenceIds.find(ref);
+	if (it != m_referenceIds.end())
+		return (*it).second;
+	const uint32_t referenceId = static_cast<uint32_t>(m_referenceNames.size());
+	m_referenceIds[ref] = referenceId;
+	m_referenceNames.push_back(ref);
+	return referenceId;
+}
+
+
+
+
+bool 
+is_number
+(
+    const std::string& s
+)
+{
+    // http://ideone.com/OjVJWh
+    return !s.empty() && std::all_of(s.begin(), s.end(), ::isdigit);
+}
+
+
+
+
+// replace fields by begin and end of fields separated by any of separators
+size_t
+splitFields
+(
+	std::string const & line,
+	const char* separators,
+	std::vector<lineField>& fields
+)
+{
+	fields.clear();
+	const char* begin = line.data();
+	const char* end = begin + line.size();
+	// carriage return of windows line endings
+	if (begin != end && end[-1] == '\r')
+		end--;
+	const char* field = begin;
+	for (const char* it = begin; it != end; ++it)
+	{
+		if (std::strchr(separators, *it) != NULL)
+		{
+			fields.push_back(lineField(field, it));
+			field = it + 1;
+		}
+	}
+	fields.push_back(lineField(field, end));
+	return fields.size();
+}
+
+
+
+
+// unsigned decimal of field, false if empty, not a number or out of range
+bool
+parseUnsigned
+(
+	lineField const & field,
+	uint32_t& value
+)
+{
+	if (field.first == field.second)
+		return false;
+	uint64_t result = 0;
+	for (const char* it = field.first; it != field.second; ++it)
+	{
+		if (*it < '0' || *it > '9')
+			return false;
+		result = result * 10 + static_cast<uint64_t>(*it - '0');
+		if (result > 0xFFFFFFFF)
+			return false;
+	}
+	value = static_cast<uint32_t>(result);
+	return true;
+}
+
+
+
+
+// value of attribute in GTF (key "value";) or GFF (key=value;) format
+bool
+gtfAttribute
+(
+	lineField const & attributes,
+	const char* key,
+	std::string& value
+)
+{
+	const size_t keyLength = std::strlen(key);
+	const char* it = attributes.first;
+	while (it < attributes.second)
+	{
+		while (it < attributes.second && (*it == ' ' || *it == ';'))
+			++it;
+		const char* end = std::find(it, attributes.second, ';');
+		if (static_cast<size_t>(end - it) > keyLength && std::strncmp(it, key, keyLength) == 0 &&
+			(it[keyLength] == ' ' || it[keyLength] == '='))
+		{
+			const char* first = it + keyLength + 1;
+			const char* last = end;
+			while (first < last && (*first == ' ' || *first == '"'))
+				++first;
+			while (last > first && (last[-1] == ' ' || last[-1] == '"'))
+				--last;
+			if (first == last)
+				return false;
+			value.assign(first, last);
+			return true;
+		}
+		it = end;
+	}
+	return false;
+}
+
+
+
+
+// chapter matching reference with or without chr prefix, empty if none
+std::string
+chapterName
+(
+	std::string const & ref,
+	std::unordered_set<std::string> const & chapters
+)
+{
+	std::vector<std::string> candidates;
+	candidates.push_back(ref);
+	if (ref.compare(0, 3, "chr") == 0)
+		candidates.push_back(ref == "chrM" ? "MT" : ref.substr(3));
+	else
+		candidates.push_back(ref == "MT" ? "chrM" : "chr" + ref);
+	for (auto it = candidates.begin(); it != candidates.end(); ++it)
+	{
+		if (chapters.count(*it))
+			return *it;
+	}
+	return "";
+}
@@ -1,445 +1,513 @@
-// \MODULE\---------------------------------------------------------------
-//
-//  CONTENTS      : Class pseudoAligner
-//
-//  DESCRIPTION   :	Estimated position of sequence based on kmer matches
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-// All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-
-//-- standard headers ----------------------------------------------------
-#include <random>
-#include <vector>
-#include <map>
-#include <list>
-#include <algorithm>
-#include <chrono>
-#include <cmath>
-#include <climits>
-#include <iostream>
-
-//-- private headers -----------------------------------------------------
-#include "pseudoAligner.h"
-#include "fileSAM.h"
-#include "bio.h"
-#include "fmIndex.h"
-
-//-- source control system ID (if needed)---------------------------------
-
-//-- exported global variables - definitions (should be empty) -----------
-
-//-- private constants ---------------------------------------------------
-const uint32_t WindowSize = 100;				// lcs window
-const uint32_t WindowShift = 80;				// lcs window shift
-const uint32_t maxSeedsPerRow = 100;
-
-//-- private types -------------------------------------------------------
-struct seedType
-{
-	uint32_t row = 0;				// offset in read
-	uint32_t col = 0;				// offset in reference
-	uint32_t length = 0;			// length of exact match
-	int64_t magnitude;				// distance to origin
-};
-
-//-- private functions --------- declarations ----------------------------
-// check if seed is homopolymer
-bool isHomoPolymer(std::string& str);
-// project seeds to main diagonal of dotplot matrix
-void orthogonalProject2Line(std::vector<seedType>& seeds);
-// project seeds to line specified by row/column direction vector
-void orthogonalProject2Line(std::vector<seedType>& seeds, const std::pair<int64_t, int64_t> direction);
-// cluster seeds to find best region
-std::list<seedType> clusterProjectedSeeds(std::vector<seedType>& seeds);
-// revise for overlapping seeds and invalid paths
-void reviseSeedPath(std::list<seedType>& path);
-// construct alignment cigar from path
-std::string path2alignmentCigar(std::list<seedType>const & path, uint32_t readLength);
-
-//-- private global variables -- definitions (should be empty) -----------
-
-//-- exported functions -------- definitions -----------------------------
-// constructor
-pseudoAligner::pseudoAligner
-(
-	pseudoAligner_settings& settings,
-	fmIndex& index
-) : m_settings(settings),
-	m_index(index)
-{
-
-}
-
-
-
-
-// virtual destructor
-pseudoAligner::~pseudoAligner()
-{
-
-}
-
-
-
-
-// get most likely position of flawed string
-samRecord 
-pseudoAligner::estimatePosition
-(
-	const std::string str
-)
-{
-	std::vector<seedType> forwardMatches, reverseMatches;
-	const uint32_t scanMax = str.size() >= m_settings.m_scanPrefix ? m_settings.m_scanPrefix : static_cast<uint32_t>(str.size());
-	auto fStr = std::string(str.begin(), str.begin() + scanMax);
-	auto rStr = complement(std::string(str.rbegin(), str.rbegin() + scanMax));
-	auto strBegin = fStr.begin();
-	auto rStrBegin = rStr.begin();
-	size_t windowStart = 0;
-	// get longest common substrings of overlapping parts of the read and the reference in the index
-	// store organized like main diagonals of a dot-plot matrix (diagonal, offset, length of lcs)
-	while (windowStart + WindowSize < scanMax)
-	{
-		auto const & fMatch = m_index.getLongestCommonSubsequence(std::string(strBegin, strBegin + WindowSize));
-		auto const & rMatch = m_index.getLongestCommonSubsequence(std::string(rStrBegin, rStrBegin + WindowSize));
-		for (auto it = fMatch.begin(); it != fMatch.end(); ++it)
-		{
-			seedType match;
-			match.col = (*it).indexStart;
-			match.row = (*it).strStart + windowStart;
-			match.length = (*it).lcsLength;
-			forwardMatches.push_back(match);
-		}
-		for (auto it = rMatch.begin(); it != rMatch.end(); ++it)
-		{
-			seedType match;
-			match.col = (*it).indexStart;
-			match.row = (*it).strStart + windowStart;
-			match.length = (*it).lcsLength;
-			reverseMatches.push_back(match);
-		}
-		strBegin += WindowShift;
-		rStrBegin += WindowShift;
-		windowStart += WindowShift;
-	}
-	// group exact matches
-	// const std::pair<int64_t, int64_t> projection = std::make_pair(-1, 1);
-	orthogonalProject2Line(forwardMatches);
-	orthogonalProject2Line(reverseMatches);
-	auto fwdPath = clusterProjectedSeeds(forwardMatches);
-	auto bwdPath = clusterProjectedSeeds(reverseMatches);
-	// compute coverage of path
-	uint32_t fwdHits = 0, bwdHits = 0;
-	for (auto it = fwdPath.begin(); it != fwdPath.end(); ++it)
-		fwdHits += (*it).length;
-	for (auto it = bwdPath.begin(); it != bwdPath.end(); ++it)
-		bwdHits += (*it).length;
-	// return position on strand with more exact matches
-	samRecord result;
-	if (fwdHits > bwdHits)
-	{
-		double matchRatio = static_cast<double>(fwdHits) / bwdHits;
-		result.FLAG = 0;
-		auto relativePosition = m_index.getRelativePosition((*fwdPath.begin()).col);
-		result.RNAME = relativePosition.first;
-		result.POS = relativePosition.second + 1;
-		result.MAPQ = std::round(10 * std::log2(matchRatio));
-	}
-	else
-	{
-		double matchRatio = static_cast<double>(bwdHits) / fwdHits;
-		result.FLAG = samFlag::e_reverseComplement;		
-		auto relativePosition = m_index.getRelativePosition((*bwdPath.begin()).col);
-		result.RNAME = relativePosition.first;
-		result.POS = relativePosition.second + 1;
-		result.MAPQ = std::round(10 * std::log2(matchRatio));
-	}
-	return result;
-}
-
-
-
-
-// get alignment at distributed seeds
-samRecord 
-pseudoAligner::seedAlign
-(
-	const std::string str
-)
-{
-	const uint32_t seedLength = m_settings.m_seedLength;
-	const uint32_t seedDistance = m_settings.m_seedDistance;
-	samRecord result;
-	if(str.size() < seedLength)
-	{
-		result.FLAG = samFlag::e_unmapped;
-		return result;
-	}
-	// extract seeds from read sequence
-	std::vector<std::string> seedStrings;
-	for (uint32_t i = 0; i < str.size() - seedLength; i += seedDistance)
-	{
-		std::string seed = std::string(str.begin() + i, str.begin() + i + seedLength);
-		if (!isHomoPolymer(seed))
-			seedStrings.push_back(seed);
-	}
-		
-	// compute most likely path for template read
-	const std::pair<int64_t, int64_t> projection = std::make_pair(-1, 1);
-	auto seeds = getSeedPositions(seedStrings, seedDistance);
-	orthogonalProject2Line(seeds, projection);
-	auto fwdPath = clusterProjectedSeeds(seeds);
-	reviseSeedPath(fwdPath);
-	
-	// compute most likely path for complement read
-	std::reverse(seedStrings.begin(), seedStrings.end());
-	for (auto it = seedStrings.begin(); it != seedStrings.end(); ++it)
-		(*it) = reverseComplement(*it);
-	seeds = getSeedPositions(seedStrings, seedDistance);
-	orthogonalProject2Line(seeds, projection);
-	auto bwdPath = clusterProjectedSeeds(seeds);
-	reviseSeedPath(bwdPath);
-	
-	// concatenate result
-	if (fwdPath.size() > bwdPath.size())
-	{
-		result.FLAG = 0;
-		result.CIGAR = path2alignmentCigar(fwdPath, str.size());
-		std::tie(result.RNAME, result.POS) = m_index.getRelativePosition((*fwdPath.begin()).col);
-		result.POS++;
-		result.MAPQ = std::round(-10 * std::log2(static_cast<double>(fwdPath.size()) / seedStrings.size()));
-		result.SEQ = str;
-	}
-	else
-	{
-		result.FLAG = samFlag::e_reverseComplement;
-		result.CIGAR = path2alignmentCigar(bwdPath, str.size());
-		std::tie(result.RNAME, result.POS) = m_index.getRelativePosition((*bwdPath.begin()).col);
-		result.POS++;
-		result.MAPQ = std::round(-10 * std::log2(static_cast<double>(bwdPath.size()) / seedStrings.size()));
-		result.SEQ = reverseComplement(str);
-	}
-	return result;
-}
-
-
-
-
-//-- private functions --------- definitions -----------------------------
-// get positions for seeds
-std::vector<seedType> 
-pseudoAligner::getSeedPositions
-(
-	std::vector<std::string>& seeds,
-	uint32_t seedDistance
-)
-{
-	std::vector<seedType> positions;
-	uint32_t seedRow = 0;
-	for (auto it = seeds.cbegin(); it != seeds.cend(); ++it)
-	{
-		auto const & pos = m_index.getMatchingPositions((*it), maxSeedsPerRow);
-		positions.reserve(positions.size() + pos.size());
-		for (auto it2 = pos.cbegin(); it2 != pos.cend(); ++it2)
-		{
-			seedType seed;
-			seed.col = *it2;
-			seed.row = seedRow;
-			seed.length = (*it).size();
-			positions.push_back(seed);
-		}
-		seedRow += seedDistance;
-	}
-	return positions;
-}
-
-
-
-
-// check if seed is homopolymer
-bool isHomoPolymer
-(
-	std::string& str
-)
-{
-	if (str.size() > 1)
-	{
-		const char first = *str.begin();
-		for (auto it = str.begin() + 1; it != str.end(); ++it)
-			if ((*it) != first)
-				return false;
-	}
-	return true;
-}
-
-
-
-
-// project seeds to main diagonal of dotplot matrix
-void 
-orthogonalProject2Line
-(
-	std::vector<seedType>& seeds
-)
-{
-	for (auto it = seeds.begin(); it != seeds.end(); ++it)
-	{
-		(*it).magnitude = static_cast<int64_t>((*it).col - (*it).row);
-	}
-}
-
-
-
-
-// project seeds to line specified by row/column direction vector
-void 
-orthogonalProject2Line
-(
-	std::vector<seedType>& seeds,
-	const std::pair<int64_t, int64_t> direction
-)
-{
-	const int64_t scalar_direction = direction.first * direction.first + direction.second * direction.second;
-	if (scalar_direction == 0)
-		throw std::invalid_argument("Projection to 0");
-	for (auto it = seeds.begin(); it != seeds.end(); ++it)
-	{
-		int64_t scalar_seed = (*it).row * direction.first + (*it).col * direction.second;
-		double scale = static_cast<double>(scalar_seed) / scalar_direction;
-		auto row = scale * direction.first;
-		auto col = scale * direction.second;
-		if (row <= 0)
-			(*it).magnitude = static_cast<int64_t>(std::round(std::sqrt(row*row + col*col)));
-		else
-			(*it).magnitude = static_cast<int64_t>(std::round(-std::sqrt(row*row + col*col)));
-	}
-}
-
-
-
-
-// cluster seeds to find best path
-std::list<seedType>
-clusterProjectedSeeds
-(
-	std::vector<seedType>& seeds
-)
-{
-	if (seeds.size() < 2)
-		return std::list<seedType>();
-	// sort seeds by distance to origin
-	std::sort(seeds.begin(), seeds.end(),
-		[](seedType lhs, seedType rhs) -> bool {return lhs.magnitude < rhs.magnitude; });
-
-	// sliding window to find most dense region of seeds
-	const int64_t clusterSize = 1000;
-	auto lowerBound = seeds.begin();
-	auto upperBound = std::upper_bound(seeds.begin(), seeds.end(), (*lowerBound).magnitude + clusterSize,
-		[](int64_t lhs, seedType rhs) -> bool {return lhs < rhs.magnitude; });
-
-	typedef std::pair<std::vector<seedType>::iterator, int64_t> clusterType;
-	std::vector<clusterType> cluster;
-	cluster.push_back(std::make_pair(lowerBound, std::distance(lowerBound, upperBound)));
-	while (upperBound != seeds.end())
-	{
-		// step forward
-		lowerBound++;
-		while (upperBound != seeds.end() && (*upperBound).magnitude <= (*lowerBound).magnitude + clusterSize)
-			upperBound++;
-		cluster.push_back(std::make_pair(lowerBound, std::distance(lowerBound, upperBound)));
-	}
-
-	// get seeds from highest scoring window
-	std::list<seedType> path;
-	std::sort(cluster.begin(), cluster.end(), 
-		[](clusterType lhs, clusterType rhs) -> bool {return lhs.second < rhs.second; });
-	auto maxCluster = *cluster.rbegin();
-	for (int64_t i = 0; i < maxCluster.second; ++i)
-		path.push_back(*maxCluster.first++);
-	
-	return path;
-}
-
-
-
-
-// revise for overlapping seeds and invalid paths
-void 
-reviseSeedPath
-(
-	std::list<seedType>& path
-)
-{
-	// check for overlapping seeds
-	if (path.size() < 2)
-		return;
-	path.sort([](seedType lhs, seedType rhs) -> bool { return lhs.magnitude < rhs.magnitude; });
-	auto pathMid = path.begin();
-	std::advance(pathMid, path.size() / 2);
-	const auto medianMagnitude = (*pathMid).magnitude;
-	// reset magnitude to distance from read begin
-	for (auto it = path.begin(); it != path.end(); ++it)
-		(*it).magnitude = (*it).row + (*it).magnitude - medianMagnitude;
-	path.sort([](seedType lhs, seedType rhs) -> bool { return lhs.magnitude < rhs.magnitude; });
-	// TODO do not overwrite magnitude for later comparison
-}
-
-
-
-
-// construct alignment cigar from path
-std::string 
-path2alignmentCigar
-(
-	std::list<seedType> const & path,
-	uint32_t readLength
-)
-{
-	if (path.size() == 0)
-		return std::to_string(readLength) + "S";
-	std::string cigar;
-	if ((*path.begin()).row > 0)
-	{
-		cigar += std::to_string((*path.begin()).row) + "S";
-	}
-	for (auto it = path.cbegin(); it != path.cend(); ++it)
-	{
-		auto it_next = std::next(it);
-		if (it_next != path.cend())
-		{
-			const uint32_t rows = (*it_next).row - (*it).row;
-			const uint32_t cols = (*it_next).col - (*it).col;
-			if (rows > cols)
-			{
-				// match + insertion
-				cigar += std::to_string(cols) + "M";
-				cigar += std::to_string(rows - cols) + "I";
-			}
-			else if (cols > rows)
-			{
-				// match + deletion
-				cigar += std::to_string(rows) + "M";
-				cigar += std::to_string(cols - rows) + "D";
-			}
-			else
-			{
-				// match
-				cigar += std::to_string(rows) + "M";
-			}
-		}
-		else
-		{
-			if (static_cast<int64_t>(readLength)-(*it).row > 0)
-				cigar += std::to_string(readLength - (*it).row) + "M";
-		}
-	}
-	return cigar;
-}
-
-
-
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class pseudoAligner
+//
+//  DESCRIPTION   :	Estimated position of sequence based on kmer matches
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <random>
+#include <vector>
+#include <map>
+#include <list>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <climits>
+#include <iostream>
+
+//-- private headers -----------------------------------------------------
+#include "pseudoAligner.h"
+#include "fileSAM.h"
+#include "bio.h"
+#include "fmIndex.h"
+#include "seedDistance.h"
+#include "seedMinimizer.h"
+#include "bandedAlignment.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const uint32_t WindowSize = 100;				// lcs window
+const uint32_t WindowShift = 80;				// lcs window shift
+const uint32_t maxSeedsPerRow = 100;
+const uint32_t MinDecisionWindows = 2;			// lcs windows before early decision
+const uint32_t GiveUpWindows = 3;				// lcs windows without hit before giving up
+const size_t MaxChains = 4;						// chains per strand for mapping quality
+const uint32_t RefineBandWidth = 16;			// diagonals beside gap of banded alignment
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+// best score of chains other than the best chain of selected strand
+double alternativeScore(std::vector<seedChain> const & fwdChains, std::vector<seedChain> const & bwdChains, bool forward);
+// construct alignment cigar from path
+std::string path2alignmentCigar(std::vector<seedType>const & path, uint32_t readLength);
+// construct alignment cigar from path with banded alignment of gaps between seeds
+std::string path2refinedCigar(std::vector<seedType>const & path, std::string const & sequence, std::string const & reference);
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor
+pseudoAligner::pseudoAligner
+(
+	pseudoAligner_settings& settings,
+	fmIndex& index
+) : m_settings(settings),
+	m_index(index)
+{
+	// longest match of window expected by chance, log4 of possible placements
+	const double placements = std::max<double>(m_index.getLength(), 1) * WindowSize;
+	m_minHitLength = static_cast<uint32_t>(std::ceil(std::log2(placements) / 2));
+	if (m_settings.m_seedEngine == e_seedMinimizer)
+		m_seedEngine.reset(new seedMinimizer(m_settings.m_seedLength, m_settings.m_minimizerWindow));
+	else
+		m_seedEngine.reset(new seedDistance(m_settings.m_seedLength, m_settings.m_seedDistance));
+}
+
+
+
+
+// virtual destructor
+pseudoAligner::~pseudoAligner()
+{
+
+}
+
+
+
+
+// get most likely position of flawed string
+samRecord 
+pseudoAligner::estimatePosition
+(
+	const std::string str
+)
+{
+	std::vector<seedType> forwardMatches, reverseMatches;
+	const uint32_t scanMax = str.size() >= m_settings.m_scanPrefix ? m_settings.m_scanPrefix : static_cast<uint32_t>(str.size());
+	auto fStr = std::string(str.begin(), str.begin() + scanMax);
+	auto rStr = complement(std::string(str.rbegin(), str.rbegin() + scanMax));
+	auto strBegin = fStr.begin();
+	auto rStrBegin = rStr.begin();
+	size_t windowStart = 0;
+	uint32_t windows = 0;
+	uint32_t maxLength = 0;
+	// get longest common substrings of overlapping parts of the read and the reference in the index
+	while (windowStart + WindowSize < scanMax)
+	{
+		auto const & fMatch = m_index.getLongestCommonSubsequence(std::string(strBegin, strBegin + WindowSize));
+		auto const & rMatch = m_index.getLongestCommonSubsequence(std::string(rStrBegin, rStrBegin + WindowSize));
+		for (auto it = fMatch.begin(); it != fMatch.end(); ++it)
+		{
+			seedType match;
+			match.col = (*it).indexStart;
+			match.row = (*it).strStart + windowStart;
+			match.length = (*it).lcsLength;
+			maxLength = std::max(maxLength, match.length);
+			forwardMatches.push_back(match);
+		}
+		for (auto it = rMatch.begin(); it != rMatch.end(); ++it)
+		{
+			seedType match;
+			match.col = (*it).indexStart;
+			match.row = (*it).strStart + windowStart;
+			match.length = (*it).lcsLength;
+			maxLength = std::max(maxLength, match.length);
+			reverseMatches.push_back(match);
+		}
+		strBegin += WindowShift;
+		rStrBegin += WindowShift;
+		windowStart += WindowShift;
+		windows++;
+		if (m_settings.m_earlyStopQuality == 0)
+			continue;
+		// adaptive scan gives up on reads without any match longer than chance
+		if (windows >= GiveUpWindows && maxLength < m_minHitLength)
+		{
+			samRecord result;
+			result.FLAG = samFlag::e_unmapped;
+			return result;
+		}
+		// and chains after every window
+		if (windows >= MinDecisionWindows)
+		{
+			auto result = strandEstimate(chainSeeds(forwardMatches, m_settings.m_maxChainGap, MaxChains),
+										 chainSeeds(reverseMatches, m_settings.m_maxChainGap, MaxChains));
+			if (!(result.FLAG & samFlag::e_unmapped) && result.MAPQ >= m_settings.m_earlyStopQuality)
+				return result;
+		}
+	}
+	// chain exact matches of both strands
+	return strandEstimate(chainSeeds(forwardMatches, m_settings.m_maxChainGap, MaxChains),
+						  chainSeeds(reverseMatches, m_settings.m_maxChainGap, MaxChains));
+}
+
+
+
+
+// get alignment at distributed seeds
+samRecord 
+pseudoAligner::seedAlign
+(
+	const std::string str
+)
+{
+	samRecord result;
+	// extract seeds from read sequence
+	auto readSeeds = m_seedEngine->getSeeds(str);
+	std::vector<std::string> seedStrings;
+	std::vector<uint32_t> seedRows;
+	seedStrings.reserve(readSeeds.size());
+	seedRows.reserve(readSeeds.size());
+	for (auto it = readSeeds.begin(); it != readSeeds.end(); ++it)
+	{
+		seedStrings.push_back((*it).sequence);
+		seedRows.push_back((*it).offset);
+	}
+		
+	// compute best chains for template read
+	auto fwdChains = chainSeeds(getSeedPositions(seedStrings, seedRows), m_settings.m_maxChainGap, MaxChains);
+	
+	// compute best chains for complement read, rows in reverse complement
+	for (size_t i = 0; i < seedStrings.size(); i++)
+	{
+		seedStrings[i] = reverseComplement(seedStrings[i]);
+		seedRows[i] = static_cast<uint32_t>(str.size() - seedRows[i] - seedStrings[i].size());
+	}
+	auto bwdChains = chainSeeds(getSeedPositions(seedStrings, seedRows), m_settings.m_maxChainGap, MaxChains);
+	
+	// concatenate result
+	if (fwdChains.empty() && bwdChains.empty())
+	{
+		result.FLAG = samFlag::e_unmapped;
+		return result;
+	}
+	const bool forward = !fwdChains.empty() && (bwdChains.empty() || fwdChains.front().score > bwdChains.front().score);
+	auto const & chains = forward ? fwdChains : bwdChains;
+	auto const & path = chains.front().seeds;
+	result.FLAG = forward ? 0 : samFlag::e_reverseComplement;
+	result.SEQ = forward ? str : reverseComplement(str);
+	// reference between first and last seed is fetched once per read
+	const uint32_t referenceLength = path.back().col + path.back().length - path.front().col;
+	if (m_settings.m_refineAlignment && path.front().col + referenceLength < m_index.getLength())
+		result.CIGAR = path2refinedCigar(path, result.SEQ, m_index.getIndexSequence(path.front().col, referenceLength));
+	else
+		result.CIGAR = path2alignmentCigar(path, str.size());
+	std::tie(result.RNAME, result.POS) = m_index.getRelativePosition(path.front().col);
+	result.POS++;
+	result.MAPQ = chainMappingQuality(chains.front(), alternativeScore(fwdChains, bwdChains, forward));
+	return result;
+}
+
+
+
+
+// constructor, decision is final once mapping quality reaches threshold
+alignmentSession::alignmentSession
+(
+	pseudoAligner& aligner,
+	uint32_t qualityThreshold
+) : m_aligner(aligner),
+	m_qualityThreshold(qualityThreshold)
+{
+	m_result.FLAG = samFlag::e_unmapped;
+}
+
+
+
+
+// virtual destructor
+alignmentSession::~alignmentSession()
+{
+
+}
+
+
+
+
+// add next chunk of sequence, true if decision is available
+bool
+alignmentSession::append
+(
+	std::string const & chunk
+)
+{
+	m_size += chunk.size();
+	if (m_decided)
+		return true;
+	const size_t scanPrefix = m_aligner.m_settings.get_m_scanPrefix();
+	if (m_sequence.size() < scanPrefix)
+		m_sequence.append(chunk, 0, scanPrefix - m_sequence.size());
+	// windows of earlier chunks are not queried again
+	bool updated = false;
+	while (m_windowStart + WindowSize <= m_sequence.size() && m_windowStart + WindowSize < scanPrefix)
+	{
+		const std::string window = m_sequence.substr(m_windowStart, WindowSize);
+		auto const & fMatch = m_aligner.m_index.getLongestCommonSubsequence(window);
+		auto const & rMatch = m_aligner.m_index.getLongestCommonSubsequence(reverseComplement(window));
+		for (auto it = fMatch.begin(); it != fMatch.end(); ++it)
+		{
+			seedType match;
+			match.col = (*it).indexStart;
+			match.row = static_cast<uint32_t>((*it).strStart + m_windowStart);
+			match.length = (*it).lcsLength;
+			m_forwardMatches.push_back(match);
+		}
+		// reverse matches keep their start in the read, the read end is unknown
+		for (auto it = rMatch.begin(); it != rMatch.end(); ++it)
+		{
+			seedType match;
+			match.col = (*it).indexStart;
+			match.row = static_cast<uint32_t>(m_windowStart + WindowSize - (*it).strStart - (*it).lcsLength);
+			match.length = (*it).lcsLength;
+			m_reverseMatches.push_back(match);
+		}
+		m_windowStart += WindowShift;
+		updated = true;
+	}
+	if (updated)
+	{
+		// reverse matches are chained in the reverse complement of the received bases,
+		// the estimate is the leftmost reference position of the received bases
+		const uint32_t received = static_cast<uint32_t>(m_windowStart - WindowShift + WindowSize);
+		auto reverseMatches = m_reverseMatches;
+		for (auto it = reverseMatches.begin(); it != reverseMatches.end(); ++it)
+			(*it).row = received - (*it).row - (*it).length;
+		const uint32_t maxGap = m_aligner.m_settings.get_m_maxChainGap();
+		m_result = m_aligner.strandEstimate(chainSeeds(m_forwardMatches, maxGap, MaxChains),
+											chainSeeds(reverseMatches, maxGap, MaxChains));
+		m_decided = !(m_result.FLAG & samFlag::e_unmapped) && m_result.MAPQ >= m_qualityThreshold &&
+					m_windowStart >= MinDecisionWindows * WindowShift;
+	}
+	if (m_windowStart + WindowSize >= scanPrefix)
+		m_decided = true;
+	return m_decided;
+}
+
+
+
+
+// true if quality threshold is reached or scan prefix is consumed
+bool
+alignmentSession::decided
+(
+	void
+)
+const
+{
+	return m_decided;
+}
+
+
+
+
+// current estimate, unmapped while no matches are found
+samRecord
+alignmentSession::result
+(
+	void
+)
+const
+{
+	return m_result;
+}
+
+
+
+
+// number of bases received
+size_t
+alignmentSession::size
+(
+	void
+)
+const
+{
+	return m_size;
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// start of best chain on strand with higher chain score
+samRecord
+pseudoAligner::strandEstimate
+(
+	std::vector<seedChain> const & fwdChains,
+	std::vector<seedChain> const & bwdChains
+)
+{
+	samRecord result;
+	if (fwdChains.empty() && bwdChains.empty())
+	{
+		result.FLAG = samFlag::e_unmapped;
+		return result;
+	}
+	const bool forward = !fwdChains.empty() && (bwdChains.empty() || fwdChains.front().score > bwdChains.front().score);
+	auto const & best = forward ? fwdChains.front() : bwdChains.front();
+	// reference position of first read base, ignoring indels before first seed
+	auto const & first = best.seeds.front();
+	const uint32_t start = first.col > first.row ? first.col - first.row : 0;
+	auto relativePosition = m_index.getRelativePosition(start);
+	result.FLAG = forward ? 0 : samFlag::e_reverseComplement;
+	result.RNAME = relativePosition.first;
+	result.POS = relativePosition.second + 1;
+	result.MAPQ = chainMappingQuality(best, alternativeScore(fwdChains, bwdChains, forward));
+	return result;
+}
+
+
+
+
+// get positions for seeds at given rows of read
+std::vector<seedType> 
+pseudoAligner::getSeedPositions
+(
+	std::vector<std::string>& seeds,
+	std::vector<uint32_t> const & rows
+)
+{
+	std::vector<seedType> positions;
+	auto const & seedPositions = m_index.getMatchingPositions(seeds, maxSeedsPerRow);
+	for (size_t i = 0; i < seeds.size(); i++)
+	{
+		auto const & pos = seedPositions[i];
+		positions.reserve(positions.size() + pos.size());
+		for (auto it2 = pos.cbegin(); it2 != pos.cend(); ++it2)
+		{
+			seedType seed;
+			seed.col = *it2;
+			seed.row = rows[i];
+			seed.length = seeds[i].size();
+			positions.push_back(seed);
+		}
+	}
+	return positions;
+}
+
+
+
+
+// best score of chains other than the best chain of selected strand
+double
+alternativeScore
+(
+	std::vector<seedChain> const & fwdChains,
+	std::vector<seedChain> const & bwdChains,
+	bool forward
+)
+{
+	auto const & chains = forward ? fwdChains : bwdChains;
+	auto const & other = forward ? bwdChains : fwdChains;
+	double score = chains.size() > 1 ? chains[1].score : 0;
+	if (!other.empty())
+		score = std::max(score, other.front().score);
+	return score;
+}
+
+
+
+
+// construct alignment cigar from path
+std::string 
+path2alignmentCigar
+(
+	std::vector<seedType> const & path,
+	uint32_t readLength
+)
+{
+	if (path.size() == 0)
+		return std::to_string(readLength) + "S";
+	std::string cigar;
+	if ((*path.begin()).row > 0)
+	{
+		cigar += std::to_string((*path.begin()).row) + "S";
+	}
+	for (auto it = path.cbegin(); it != path.cend(); ++it)
+	{
+		auto it_next = std::next(it);
+		if (it_next != path.cend())
+		{
+			const uint32_t rows = (*it_next).row - (*it).row;
+			const uint32_t cols = (*it_next).col - (*it).col;
+			if (rows > cols)
+			{
+				// match + insertion
+				cigar += std::to_string(cols) + "M";
+				cigar += std::to_string(rows - cols) + "I";
+			}
+			else if (cols > rows)
+			{
+				// match + deletion
+				cigar += std::to_string(rows) + "M";
+				cigar += std::to_string(cols - rows) + "D";
+			}
+			else
+			{
+				// match
+				cigar += std::to_string(rows) + "M";
+			}
+		}
+		else
+		{
+			if (static_cast<int64_t>(readLength)-(*it).row > 0)
+				cigar += std::to_string(readLength - (*it).row) + "M";
+		}
+	}
+	return cigar;
+}
+
+
+
+
+// construct alignment cigar from path with banded alignment of gaps between seeds
+std::string
+path2refinedCigar
+(
+	std::vector<seedType> const & path,
+	std::string const & sequence,
+	std::string const & reference
+)
+{
+	if (path.size() == 0)
+		return std::to_string(sequence.size()) + "S";
+	const uint32_t referenceStart = path.front().col;
+	std::vector<cigarOperation> cigar;
+	appendCigar(cigar, 'S', path.front().row);
+	for (auto it = path.cbegin(); it != path.cend(); ++it)
+	{
+		auto it_next = std::next(it);
+		if (it_next != path.cend())
+		{
+			// exact match up to next seed, gap is aligned within band
+			const uint32_t rows = (*it_next).row - (*it).row;
+			const uint32_t cols = (*it_next).col - (*it).col;
+			const uint32_t exact = std::min((*it).length, std::min(rows, cols));
+			appendCigar(cigar, 'M', exact);
+			bandedGlobalAlignment(sequence.substr((*it).row + exact, rows - exact),
+								  reference.substr((*it).col + exact - referenceStart, cols - exact),
+								  RefineBandWidth, cigar);
+		}
+		else
+		{
+			if (sequence.size() > (*it).row)
+				appendCigar(cigar, 'M', static_cast<uint32_t>(sequence.size() - (*it).row));
+		}
+	}
+	return cigarString(cigar);
+}
+
+
+
@@ -1,85 +1,175 @@
-// \MODULE\---------------------------------------------------------------
-//
-//  CONTENTS      : Class fmIndex_settings
-//
-//  DESCRIPTION   :	Settings for fmIndex
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-// All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-
-//-- standard headers ----------------------------------------------------
-
-//-- private headers -----------------------------------------------------
-#include "pseudoAligner_settings.h"
-
-//-- source control system ID (if needed)---------------------------------
-
-//-- exported global variables - definitions (should be empty) -----------
-
-//-- private constants ---------------------------------------------------
-
-//-- private types -------------------------------------------------------
-
-//-- private functions --------- declarations ----------------------------
-
-//-- private global variables -- definitions (should be empty) -----------
-
-//-- exported functions -------- definitions -----------------------------
-// constructor
-pseudoAligner_settings::pseudoAligner_settings()
-{
-
-}
-
-
-
-
-// virtual destructor
-pseudoAligner_settings::~pseudoAligner_settings()
-{
-
-}
-
-
-
-
-// setter
-void 
-pseudoAligner_settings::set_m_scanPrefix(uint32_t value)
-{
-	value > 0 ? m_scanPrefix = value : m_scanPrefix = 1;
-}
-
-
-
-
-void
-pseudoAligner_settings::set_m_seedLength(uint32_t value)
-{
-	value > 1 ? m_seedLength = value : m_seedLength = 2;
-}
-
-
-
-
-// getter
-uint32_t 
-pseudoAligner_settings::get_m_scanPrefix(void)
-{
-	return m_scanPrefix;
-}
-
-
-
-
-uint32_t
-pseudoAligner_settings::get_m_seedLength(void)
-{
-	return m_seedLength;
-}
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class fmIndex_settings
+//
+//  DESCRIPTION   :	Settings for fmIndex
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+
+//-- private headers -----------------------------------------------------
+#include "pseudoAligner_settings.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor
+pseudoAligner_settings::pseudoAligner_settings()
+{
+
+}
+
+
+
+
+// virtual destructor
+pseudoAligner_settings::~pseudoAligner_settings()
+{
+
+}
+
+
+
+
+// setter
+void 
+pseudoAligner_settings::set_m_scanPrefix(uint32_t value)
+{
+	value > 0 ? m_scanPrefix = value : m_scanPrefix = 1;
+}
+
+
+
+
+void
+pseudoAligner_settings::set_m_seedLength(uint32_t value)
+{
+	value > 1 ? m_seedLength = value : m_seedLength = 2;
+}
+
+
+
+
+void
+pseudoAligner_settings::set_m_earlyStopQuality(uint32_t value)
+{
+	m_earlyStopQuality = value;
+}
+
+
+
+
+void
+pseudoAligner_settings::set_m_seedEngine(SeedEngine value)
+{
+	m_seedEngine = value;
+}
+
+
+
+
+void
+pseudoAligner_settings::set_m_minimizerWindow(uint32_t value)
+{
+	value > 0 ? m_minimizerWindow = value : m_minimizerWindow = 1;
+}
+
+
+
+
+void
+pseudoAligner_settings::set_m_maxChainGap(uint32_t value)
+{
+	m_maxChainGap = value;
+}
+
+
+
+
+void
+pseudoAligner_settings::set_m_refineAlignment(bool value)
+{
+	m_refineAlignment = value;
+}
+
+
+
+
+// getter
+uint32_t 
+pseudoAligner_settings::get_m_scanPrefix(void)
+{
+	return m_scanPrefix;
+}
+
+
+
+
+uint32_t
+pseudoAligner_settings::get_m_seedLength(void)
+{
+	return m_seedLength;
+}
+
+
+
+
+uint32_t
+pseudoAligner_settings::get_m_earlyStopQuality(void)
+{
+	return m_earlyStopQuality;
+}
+
+
+
+
+SeedEngine
+pseudoAligner_settings::get_m_seedEngine(void)
+{
+	return m_seedEngine;
+}
+
+
+
+
+uint32_t
+pseudoAligner_settings::get_m_minimizerWindow(void)
+{
+	return m_minimizerWindow;
+}
+
+
+
+
+uint32_t
+pseudoAligner_settings::get_m_maxChainGap(void)
+{
+	return m_maxChainGap;
+}
+
+
+
+
+bool
+pseudoAligner_settings::get_m_refineAlignment(void)
+{
+	return m_refineAlignment;
+}
 //-- private functions --------- definitions -----------------------------
\ No newline at end of file
@@ -0,0 +1,167 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class rankBitvector
+//
+//  DESCRIPTION   :	Bitvector with constant time rank queries
+//
+//  RESTRICTIONS  : less than 2^32 bits
+//
+//  REQUIRES      : popcnt instruction
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <stdexcept>
+
+//-- private headers -----------------------------------------------------
+#include "rankBitvector.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const uint32_t CacheLineWords = 8;			// 64 bit words per cache line
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// default constructor
+rankBitvector::rankBitvector()
+{
+
+}
+
+
+
+
+// virtual destructor
+rankBitvector::~rankBitvector()
+{
+
+}
+
+
+
+
+// build from sorted positions of set bits
+void
+rankBitvector::build
+(
+	std::vector<uint32_t> const & positions,
+	const uint32_t N
+)
+{
+	clear();
+	m_N = N;
+	// allocate with space for cache line alignment
+	const size_t blockCount = N / BlockBits + 1;
+	m_storage.assign(blockCount * BlockWords + CacheLineWords, 0);
+	const size_t misalignment = reinterpret_cast<uintptr_t>(m_storage.data()) % (CacheLineWords * sizeof(uint64_t));
+	uint64_t* data = m_storage.data() + (misalignment ? CacheLineWords - misalignment / sizeof(uint64_t) : 0);
+
+	// set bits and count per block
+	uint32_t lastPosition = 0;
+	for (auto it = positions.begin(); it != positions.end(); ++it)
+	{
+		if ((*it) >= N || (it != positions.begin() && (*it) <= lastPosition))
+			throw std::invalid_argument("Positions of bitvector not sorted or out of range");
+		lastPosition = *it;
+		uint64_t* block = data + static_cast<size_t>(*it / BlockBits) * BlockWords;
+		const uint32_t offset = *it % BlockBits;
+		block[1 + (offset >> 6)] |= 1ULL << (offset & 63);
+	}
+	uint64_t count = 0;
+	for (size_t blockIndex = 0; blockIndex < blockCount; blockIndex++)
+	{
+		uint64_t* block = data + blockIndex * BlockWords;
+		block[0] = count;
+		for (uint32_t i = 1; i < BlockWords; ++i)
+			count += _mm_popcnt_u64(block[i]);
+	}
+	m_data = data;
+}
+
+
+
+
+// use blocks in external memory, e.g. a mapped index file
+void
+rankBitvector::attach
+(
+	const uint64_t* data,
+	const size_t words,
+	const uint32_t N
+)
+{
+	clear();
+	if (words < (N / BlockBits + 1) * BlockWords)
+		throw std::invalid_argument("Bitvector shorter than expected");
+	m_N = N;
+	m_data = data;
+}
+
+
+
+
+// release all memory
+void
+rankBitvector::clear
+(
+	void
+)
+{
+	m_N = 0;
+	m_data = NULL;
+	std::vector<uint64_t>().swap(m_storage);
+}
+
+
+
+
+// begin of blocks
+const uint64_t*
+rankBitvector::data
+(
+	void
+) const
+{
+	return m_data;
+}
+
+
+
+
+// number of 64 bit words of all blocks
+size_t
+rankBitvector::words
+(
+	void
+) const
+{
+	return m_data != NULL ? (m_N / BlockBits + 1) * BlockWords : 0;
+}
+
+
+
+
+// number of bits
+uint32_t
+rankBitvector::size
+(
+	void
+) const
+{
+	return m_N;
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
@@ -0,0 +1,202 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : co-linear chaining of seeds
+//
+//  DESCRIPTION   :	Chains of seeds increasing in read and reference
+//					position by max-gap bounded dynamic programming
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <climits>
+
+//-- private headers -----------------------------------------------------
+#include "seedChain.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+// The gap between two seeds costs (read gap + reference gap) / GapDivisor
+// matched bases. The cost is separable into terms of either seed, the best
+// predecessor is therefore found by a single range maximum query.
+const int64_t GapDivisor = 200;
+const int64_t NoScore = INT64_MIN / 2;
+const uint32_t MaxChainQuality = 60;
+
+//-- private types -------------------------------------------------------
+// range maximum over seeds in order of read position, point updates
+class rangeMax
+{
+public:
+	rangeMax(size_t size) : m_leaves(1)
+	{
+		while (m_leaves < size)
+			m_leaves <<= 1;
+		m_tree.assign(2 * m_leaves, std::make_pair(NoScore, -1));
+	}
+
+	void set(size_t leaf, int64_t value, int64_t index)
+	{
+		size_t node = leaf + m_leaves;
+		m_tree[node] = std::make_pair(value, index);
+		for (node >>= 1; node > 0; node >>= 1)
+			m_tree[node] = std::max(m_tree[2 * node], m_tree[2 * node + 1]);
+	}
+
+	// maximum of leaves in [begin, end)
+	std::pair<int64_t, int64_t> query(size_t begin, size_t end) const
+	{
+		auto result = std::make_pair(NoScore, static_cast<int64_t>(-1));
+		for (begin += m_leaves, end += m_leaves; begin < end; begin >>= 1, end >>= 1)
+		{
+			if (begin & 1)
+				result = std::max(result, m_tree[begin++]);
+			if (end & 1)
+				result = std::max(result, m_tree[--end]);
+		}
+		return result;
+	}
+
+private:
+	size_t m_leaves;
+	std::vector<std::pair<int64_t, int64_t>> m_tree;
+};
+
+//-- private functions --------- declarations ----------------------------
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// best chain and alternative chains not sharing seeds, decreasing score
+std::vector<seedChain>
+chainSeeds
+(
+	std::vector<seedType> const & seeds,
+	uint32_t maxGap,
+	size_t maxChains
+)
+{
+	std::vector<seedChain> chains;
+	const size_t n = seeds.size();
+	if (n == 0 || maxChains == 0)
+		return chains;
+	// seeds are processed in order of reference position
+	std::vector<size_t> byCol(n), byRow(n);
+	std::iota(byCol.begin(), byCol.end(), 0);
+	std::iota(byRow.begin(), byRow.end(), 0);
+	std::sort(byCol.begin(), byCol.end(), [&seeds](size_t lhs, size_t rhs) -> bool
+		{ return seeds[lhs].col < seeds[rhs].col || (seeds[lhs].col == seeds[rhs].col && seeds[lhs].row < seeds[rhs].row); });
+	// and stored in the range maximum structure in order of read position
+	std::sort(byRow.begin(), byRow.end(), [&seeds](size_t lhs, size_t rhs) -> bool
+		{ return seeds[lhs].row < seeds[rhs].row || (seeds[lhs].row == seeds[rhs].row && seeds[lhs].col < seeds[rhs].col); });
+	std::vector<size_t> leaf(n);
+	std::vector<uint32_t> rows(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		leaf[byRow[i]] = i;
+		rows[i] = seeds[byRow[i]].row;
+	}
+	rangeMax predecessors(n);
+	std::vector<int64_t> score(n);
+	std::vector<int64_t> parent(n, -1);
+	size_t inserted = 0, expired = 0;
+	for (size_t k = 0; k < n; k++)
+	{
+		const size_t i = byCol[k];
+		auto const & seed = seeds[i];
+		// predecessors start strictly before seed on reference and at most maxGap before
+		while (inserted < k && seeds[byCol[inserted]].col < seed.col)
+		{
+			const size_t j = byCol[inserted++];
+			predecessors.set(leaf[j], score[j] + seeds[j].col + seeds[j].row, j);
+		}
+		while (expired < inserted && static_cast<uint64_t>(seeds[byCol[expired]].col) + maxGap < seed.col)
+		{
+			const size_t j = byCol[expired++];
+			predecessors.set(leaf[j], NoScore, -1);
+		}
+		const uint32_t minRow = seed.row > maxGap ? seed.row - maxGap : 0;
+		const size_t begin = std::lower_bound(rows.begin(), rows.end(), minRow) - rows.begin();
+		const size_t end = std::lower_bound(rows.begin(), rows.end(), seed.row) - rows.begin();
+		score[i] = GapDivisor * seed.length;
+		if (begin < end)
+		{
+			auto const best = predecessors.query(begin, end);
+			if (best.second >= 0)
+			{
+				// bases shared with an overlapping predecessor are counted once
+				auto const & previous = seeds[best.second];
+				const uint32_t overlap = seed.length - std::min(seed.length,
+					std::min(seed.row - previous.row, seed.col - previous.col));
+				const int64_t extension = best.first - seed.col - seed.row - GapDivisor * overlap;
+				if (extension > 0)
+				{
+					score[i] += extension;
+					parent[i] = best.second;
+				}
+			}
+		}
+	}
+	// backtrack from best ends, alternative chains stop at seeds of better chains
+	std::vector<size_t> ends(n);
+	std::iota(ends.begin(), ends.end(), 0);
+	std::sort(ends.begin(), ends.end(), [&score](size_t lhs, size_t rhs) -> bool { return score[lhs] > score[rhs]; });
+	std::vector<bool> used(n, false);
+	for (auto it = ends.begin(); it != ends.end(); ++it)
+	{
+		if (used[*it])
+			continue;
+		seedChain chain;
+		int64_t i = *it;
+		while (i >= 0 && !used[i])
+		{
+			used[i] = true;
+			chain.seeds.push_back(seeds[i]);
+			i = parent[i];
+		}
+		chain.score = static_cast<double>(score[*it] - (i >= 0 ? score[i] : 0)) / GapDivisor;
+		std::reverse(chain.seeds.begin(), chain.seeds.end());
+		chains.push_back(chain);
+	}
+	std::stable_sort(chains.begin(), chains.end(), [](seedChain const & lhs, seedChain const & rhs) -> bool
+		{ return lhs.score > rhs.score; });
+	if (chains.size() > maxChains)
+		chains.resize(maxChains);
+	return chains;
+}
+
+
+
+
+// mapping quality of best chain given the best alternative score
+uint32_t
+chainMappingQuality
+(
+	seedChain const & best,
+	double alternativeScore
+)
+{
+	if (best.score <= 1)
+		return 0;
+	// uniqueness scaled by support of chain, chains of five and more seeds are fully trusted
+	const double uniqueness = 1.0 - std::min(alternativeScore, best.score) / best.score;
+	const double support = std::min(1.0, best.seeds.size() / 5.0);
+	const double quality = 40.0 * uniqueness * support * std::log(best.score);
+	return static_cast<uint32_t>(std::round(std::min<double>(quality, MaxChainQuality)));
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
@@ -0,0 +1,78 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class seedDistance
+//
+//  DESCRIPTION   :	Seeds of fixed length at fixed distance in read
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+
+//-- private headers -----------------------------------------------------
+#include "seedDistance.h"
+#include "bio.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor
+seedDistance::seedDistance
+(
+	uint32_t seedLength,
+	uint32_t seedDistance
+) :m_seedLength(seedLength), m_seedDistance(seedDistance)
+{
+
+}
+
+
+
+
+// virtual destructor
+seedDistance::~seedDistance()
+{
+
+}
+
+
+
+
+// seeds of read in order of offset, homopolymers are skipped
+std::vector<readSeed>
+seedDistance::getSeeds
+(
+	std::string const & sequence
+)
+{
+	std::vector<readSeed> seeds;
+	for (size_t i = 0; i + m_seedLength < sequence.size(); i += m_seedDistance)
+	{
+		readSeed seed;
+		seed.offset = static_cast<uint32_t>(i);
+		seed.sequence = sequence.substr(i, m_seedLength);
+		if (!isHomoPolymer(seed.sequence))
+			seeds.push_back(seed);
+	}
+	return seeds;
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
@@ -0,0 +1,169 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class seedMinimizer
+//
+//  DESCRIPTION   :	(w,k)-minimizers of read as seeds, k-mer of smallest
+//					hash in each window of w consecutive k-mers
+//
+//  RESTRICTIONS  : k <= 32, k-mers containing other bases than ACGT are
+//					skipped
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+
+//-- private headers -----------------------------------------------------
+#include "seedMinimizer.h"
+#include "bio.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+
+//-- private types -------------------------------------------------------
+// hash and start of k-mer in sliding window
+typedef struct minimizerCandidate
+{
+	uint64_t hash;
+	uint32_t offset;
+}minimizerCandidate;
+
+//-- private functions --------- declarations ----------------------------
+// invertible integer hash of k-mer, avoids poly-A as smallest k-mer
+uint64_t kmerHash(uint64_t key, uint64_t mask);
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor
+seedMinimizer::seedMinimizer
+(
+	uint32_t k,
+	uint32_t w
+) :m_k(k), m_w(w)
+{
+	if (m_k == 0 || m_k > 32)
+		throw std::invalid_argument("Minimizer length must be in range 1 - 32");
+	if (m_w == 0)
+		throw std::invalid_argument("Minimizer window must not be empty");
+	m_mask = m_k < 32 ? (1ULL << (2 * m_k)) - 1 : ~0ULL;
+	// table lookup avoids unpredictable branches on random bases
+	std::fill(m_baseCode, m_baseCode + 256, 4);
+	m_baseCode[static_cast<uint8_t>('A')] = 0;
+	m_baseCode[static_cast<uint8_t>('C')] = 1;
+	m_baseCode[static_cast<uint8_t>('G')] = 2;
+	m_baseCode[static_cast<uint8_t>('T')] = 3;
+}
+
+
+
+
+// virtual destructor
+seedMinimizer::~seedMinimizer()
+{
+
+}
+
+
+
+
+// seeds of read in order of offset, homopolymers are skipped
+std::vector<readSeed>
+seedMinimizer::getSeeds
+(
+	std::string const & sequence
+)
+{
+	std::vector<readSeed> seeds;
+	// last w k-mers, minimum is searched again only when it leaves the window
+	std::vector<minimizerCandidate> window(m_w);
+	minimizerCandidate minimum;
+	minimum.hash = UINT64_MAX;
+	minimum.offset = 0;
+	uint32_t slot = 0;				// position of newest k-mer in window
+	uint64_t kmer = 0;
+	uint32_t valid = 0;				// consecutive ACGT bases
+	int64_t lastOffset = -1;
+	uint64_t lastHash = 0;
+	for (uint32_t i = 0; i < sequence.size(); i++)
+	{
+		const uint64_t code = m_baseCode[static_cast<uint8_t>(sequence[i])];
+		if (code > 3)
+		{
+			// windows never span other bases
+			valid = 0;
+			kmer = 0;
+			minimum.hash = UINT64_MAX;
+			continue;
+		}
+		kmer = ((kmer << 2) | code) & m_mask;
+		if (++valid < m_k)
+			continue;
+		minimizerCandidate candidate;
+		candidate.hash = kmerHash(kmer, m_mask);
+		candidate.offset = i + 1 - m_k;
+		const uint32_t kmers = valid - m_k + 1;
+		slot = slot + 1 < m_w ? slot + 1 : 0;
+		window[slot] = candidate;
+		// leftmost k-mer is kept on equal hashes
+		if (candidate.hash < minimum.hash)
+			minimum = candidate;
+		else if (minimum.offset + m_w <= candidate.offset)
+		{
+			// oldest to newest k-mer
+			minimum.hash = UINT64_MAX;
+			for (uint32_t j = slot + 1; j < m_w; j++)
+				if (window[j].hash < minimum.hash)
+					minimum = window[j];
+			for (uint32_t j = 0; j <= slot; j++)
+				if (window[j].hash < minimum.hash)
+					minimum = window[j];
+		}
+		if (kmers < m_w || minimum.offset == lastOffset)
+			continue;
+		// consecutive windows mostly share their minimizer, copies of the
+		// same k-mer in tandem repeats are looked up once
+		const bool repeated = lastOffset >= 0 && minimum.hash == lastHash;
+		lastOffset = minimum.offset;
+		lastHash = minimum.hash;
+		if (repeated)
+			continue;
+		readSeed seed;
+		seed.offset = minimum.offset;
+		seed.sequence = sequence.substr(seed.offset, m_k);
+		if (!isHomoPolymer(seed.sequence))
+			seeds.push_back(seed);
+	}
+	return seeds;
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// invertible integer hash of k-mer, avoids poly-A as smallest k-mer
+uint64_t
+kmerHash
+(
+	uint64_t key,
+	uint64_t mask
+)
+{
+	key = (~key + (key << 21)) & mask;
+	key = key ^ key >> 24;
+	key = ((key + (key << 3)) + (key << 8)) & mask;
+	key = key ^ key >> 14;
+	key = ((key + (key << 2)) + (key << 4)) & mask;
+	key = key ^ key >> 28;
+	key = (key + (key << 31)) & mask;
+	return key;
+}
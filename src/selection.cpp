@@ -1,326 +1,534 @@
-// \MODULE\---------------------------------------------------------------
-//
-//  CONTENTS      : Class selectION
-//
-//  DESCRIPTION   :	Use pseudo-alignment to filter reads from fastq files
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-// All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-
-//-- standard headers ----------------------------------------------------
-#include <fstream>
-#include <iostream>
-#include <algorithm>
-#include <iomanip>
-#include <thread>
-#include <cstdint>
-#include <map>
-#include <cmath>
-#include <boost/filesystem.hpp>
-
-//-- private headers -----------------------------------------------------
-#include "fileFastx.h"
-#include "selection.h"
-
-//-- source control system ID (if needed)---------------------------------
-
-//-- exported global variables - definitions (should be empty) -----------
-
-//-- private constants ---------------------------------------------------
-const size_t SeqWriteBufferSize = 0;
-const size_t SamWriteBufferSize = 499;
-
-//-- private types -------------------------------------------------------
-
-//-- private functions --------- declarations ----------------------------
-
-//-- private global variables -- definitions (should be empty) -----------
-
-//-- exported functions -------- definitions -----------------------------
-// construct using existing index on disk
-selectION::selectION
-(
-	selection_settings& settings,
-	std::string dbPrefix
-) : m_settings(settings)
-{
-	m_index = new fmIndex(settings.get_m_fmIndex_settings(), dbPrefix + ".h5");
-	m_aligner = new pseudoAligner(settings.get_m_pseudoAligner_settings(), *m_index);
-	m_settings.logging().log(e_logInfo, "SelectION instance created");	
-}
-
-
-
-
-// virtual destructor
-selectION::~selectION()
-{
-	delete m_aligner;
-	delete m_index;
-}
-
-
-
-
-// build from fasta/ fastq
-void
-selectION::buildFromFastx
-(
-	selection_settings& settings,
-	std::string filename
-)
-{
-	buildFromFastx(settings, filename, filename);
-}
-
-
-
-
-// build from fasta/ fastq
-void
-selectION::buildFromFastx
-(
-	selection_settings& settings,
-	std::string fileName,
-	std::string dbPrefix
-)
-{
-	// get size of file (ignore header and newline overhead)
-	std::string refSequence;
-	fileFastx reader(fileName);
-	try
-	{
-		fmIndex::allocateMemory(refSequence, reader.predicateMemoryRequirement());
-	}
-	catch (std::exception e)
-	{
-		settings.logging().log(e_logFatal, "Failed to allocate memory for reference sequence");
-		return;
-	}	
-	// names and offsets of chapters
-	std::map<uint32_t, std::string> nameOffset;
-	uint32_t offset = 0;
-	settings.logging().log(e_logInfo, "Loaded reference " + fileName);
-	while (!reader.empty())
-	{
-		auto record = reader.getRecord();
-		if (record == NULL)
-			break;
-		std::string name;
-		size_t pos = record->getName().find(' ', 1);
-		if (pos != std::string::npos)
-			name = record->getName().substr(0, pos);
-		else
-			name = record->getName().substr(0);
-		nameOffset[offset] = name;
-		offset += static_cast<uint32_t>(record->size());
-		refSequence.append(record->getSequence());
-	}
-
-	// build index
-	if (refSequence.size() > 0)
-	{
-		settings.logging().log(e_logInfo, "Building Index for " +
-										  std::to_string(nameOffset.size()) +
-										  " segments (" +
-										  std::to_string(offset) + " Bp)");
-		fmIndex::build(settings.get_m_fmIndex_settings(), refSequence, dbPrefix + ".h5", nameOffset);
-	}
-	else
-		settings.logging().log(e_logError, "No reference sequence found. Specify valid fastq or fasta input file");
-}
-
-
-
-
-// scan sequence file for matches
-void 
-selectION::select
-(
-	ISequenceFile& seqFile, 
-	positionFilter& filter,
-	std::string outputPath
-)
-{
-	if (!boost::filesystem::is_directory(outputPath))
-	{
-		m_settings.logging().log(e_logError, "Output path is not a directory");
-		return;
-	}
-	if (m_settings.m_sam != "" && boost::filesystem::is_directory(m_settings.m_sam))
-	{
-		m_settings.logging().log(e_logError, "SAM Output path is a directory");
-		return;
-	}
-	if (m_settings.m_sam != "")
-		m_samOutput = true;
-	m_writeActive = true;
-	auto writer = std::thread(&selectION::writeWorker, this, outputPath, seqFile.extension());
-	std::vector<std::thread> worker;
-	for (uint32_t i = 1; i < m_settings.m_threads; i++)
-		worker.push_back(std::thread(&selectION::selectionWorker, this, std::ref(seqFile), std::ref(filter)));
-	selectionWorker(seqFile, filter);
-	for (auto it = worker.begin(); it != worker.end(); ++it)
-		(*it).join();
-	m_writeActive = false;
-	m_writeCondition.notify_all();
-	writer.join();
-}
-
-
-
-
-
-//-- private functions --------- definitions -----------------------------
-// worker function reading records from disk, aligning and writing back
-void 
-selectION::selectionWorker
-(
-	ISequenceFile& seqs,
-	positionFilter& filter
-)
-{
-	const auto qualityThreshold = m_settings.m_qualityThreshold;
-	const auto activeSelectors = filter.getActiveSelectorCount();
-	for (;;)
-	{
-		std::shared_ptr<sequenceBase> record = NULL;
-		{
-			std::unique_lock<std::mutex> lock(m_mutex);
-			if (!seqs.empty())
-				record = seqs.getRecord();
-		}
-		if (record == NULL)
-			break;
-		auto position = m_aligner->estimatePosition(record->getSequence());
-		auto recordName = record->getName();
-		position.QNAME = recordName.substr(0, recordName.find(' '));;
-		bool notify = false;
-		// write pseudo alignment to sam output file
-		if (m_samOutput)
-		{
-			position.TLEN = record->size();
-			if (position.MAPQ < qualityThreshold)
-				position.FLAG |= samFlag::e_unmapped;
-			{
-				std::lock_guard<std::mutex> lock(m_mutex);
-				m_samRecords.push_back(position);
-			}
-			if (m_samRecords.size() > SamWriteBufferSize)
-				notify = true;
-		}		
-		// write matched records to output directory
-		if (activeSelectors > 0 && position.MAPQ >= qualityThreshold)
-		{
-			auto matches = filter.match(position.RNAME, position.POS, static_cast<uint32_t>(record->size()));
-			if (matches.size() == 0)
-				continue;
-			std::lock_guard<std::mutex> lock(m_mutex);
-			for (auto it = matches.begin(); it != matches.end(); ++it)
-			{
-				m_selected[(*it)].push_back(record);
-			}
-			if (m_selected.size() > SeqWriteBufferSize)
-				notify = true;
-		}
-		// notify file writer thread
-		if (notify == true)
-			m_writeCondition.notify_one();
-	}
-	m_writeCondition.notify_one();
-}
-
-
-
-
-// worker function writing selected records to stream or disk
-void 
-selectION::writeWorker
-(
-	std::string outputPath,
-	std::string fileExtension
-)
-{
-	boost::filesystem::path dir(outputPath);
-	boost::filesystem::path samFile(m_settings.m_sam);
-	fileSAM samOut(samFile.generic_string());
-	samHeaderProgram hp;
-	hp.ID = "SelectION";
-	hp.Name = "SelectION";
-	hp.Version = "1.0";
-	hp.commandLine = m_settings.m_cmd;
-	auto chapters = m_index->getChapters();
-	std::sort(chapters.begin(), chapters.end(),
-				[](std::pair<std::string, uint32_t> a, std::pair<std::string, uint32_t> b)
-				{ return a.second > b.second; });
-	samHeader h;
-	h.program = hp;
-	h.majorFormat = 1;
-	h.minorFormat = 0;
-	h.sequences = chapters;
-	samOut.writeHeader(h);
-	while (m_writeActive)
-	{
-		std::map<std::string, std::vector<std::shared_ptr<sequenceBase>>> recordBuffer;
-		std::vector<samRecord> samBuffer;
-		{
-			std::unique_lock<std::mutex> lock(m_mutex);
-			// pause thread
-			m_writeCondition.wait(lock);
-			// lock re-aquired, save to copy
-			recordBuffer = std::move(m_selected);
-			samBuffer = std::move(m_samRecords);
-		}
-		// write selected records if existent
-		if (recordBuffer.size())
-		{
-			uint32_t recordsComplete = 0;
-			bool success = true;
-			for (auto it = recordBuffer.begin(); it != recordBuffer.end(); ++it)
-			{
-				try
-				{
-					boost::filesystem::path file = (*it).first + fileExtension;				
-					std::ofstream outputStream((dir / file).generic_string(), std::ofstream::app);
-					for (auto it2 = (*it).second.begin(); it2 != (*it).second.end(); ++it2)
-					{
-						outputStream << (*it2);
-						recordsComplete++;
-					}			
-				}
-				catch (std::exception&)
-				{
-					success = false;
-					// TODO handle exceptions on output
-				}
-			}
-			if (success)
-				m_settings.logging().log(e_logInfo, "Successfully wrote " + 
-					std::to_string(recordsComplete) + 
-					" record to disk.");
-			else
-				m_settings.logging().log(e_logError, "Error writing sequence record");
-		}	
-		// write sam records if existent
-		if (samBuffer.size())
-		{
-			try
-			{
-				samOut.append(samBuffer);
-				m_settings.logging().log(e_logInfo, "Successfully wrote " +
-					std::to_string(samBuffer.size()) +
-					" records to sam.");
-			}
-			catch (std::exception&)
-			{
-				m_settings.logging().log(e_logError, "Error writing sam record");
-				// TODO handle exceptions on output
-			}
-		}
-	}
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class selectION
+//
+//  DESCRIPTION   :	Use pseudo-alignment to filter reads from fastq files
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <iomanip>
+#include <thread>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <cmath>
+#include <boost/filesystem.hpp>
+
+//-- private headers -----------------------------------------------------
+#include "fileFastx.h"
+#include "selection.h"
+#include "selectorWriter.h"
+#include "fileBAM.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const size_t SeqWriteBufferSize = 0;
+const size_t SamWriteBufferSize = 64 * 1024;		// bytes of encoded sam records
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// construct using existing index on disk
+selectION::selectION
+(
+	selection_settings& settings,
+	std::string dbPrefix
+) : m_settings(settings)
+{
+	m_index = new fmIndex(settings.get_m_fmIndex_settings(), indexFile(settings, dbPrefix));
+	m_aligner = new pseudoAligner(settings.get_m_pseudoAligner_settings(), *m_index);
+	m_settings.logging().log(e_logInfo, "SelectION instance created");	
+}
+
+
+
+
+// virtual destructor
+selectION::~selectION()
+{
+	delete m_aligner;
+	delete m_index;
+}
+
+
+
+
+// build from fasta/ fastq
+void
+selectION::buildFromFastx
+(
+	selection_settings& settings,
+	std::string filename
+)
+{
+	buildFromFastx(settings, filename, filename);
+}
+
+
+
+
+// build from fasta/ fastq
+void
+selectION::buildFromFastx
+(
+	selection_settings& settings,
+	std::string fileName,
+	std::string dbPrefix
+)
+{
+	// get size of file (ignore header and newline overhead)
+	std::string refSequence;
+	fileFastx reader(fileName, settings.get_m_threads());
+	try
+	{
+		fmIndex::allocateMemory(refSequence, reader.predicateMemoryRequirement());
+	}
+	catch (std::exception e)
+	{
+		settings.logging().log(e_logFatal, "Failed to allocate memory for reference sequence");
+		return;
+	}	
+	// names and offsets of chapters
+	std::map<uint32_t, std::string> nameOffset;
+	uint32_t offset = 0;
+	settings.logging().log(e_logInfo, "Loaded reference " + fileName);
+	while (!reader.empty())
+	{
+		auto record = reader.getRecord();
+		if (record == NULL)
+			break;
+		std::string name;
+		size_t pos = record->getName().find(' ', 1);
+		if (pos != std::string::npos)
+			name = record->getName().substr(0, pos);
+		else
+			name = record->getName().substr(0);
+		nameOffset[offset] = name;
+		offset += static_cast<uint32_t>(record->size());
+		refSequence.append(record->getSequenceData(), record->size());
+	}
+
+	// build index
+	if (refSequence.size() > 0)
+	{
+		settings.logging().log(e_logInfo, "Building Index for " +
+										  std::to_string(nameOffset.size()) +
+										  " segments (" +
+										  std::to_string(offset) + " Bp)");
+		fmIndex::build(settings.get_m_fmIndex_settings(), refSequence, dbPrefix + ".h5", nameOffset);
+		if (settings.get_m_fmIndex_settings().get_m_nativeIndex())
+		{
+			std::string().swap(refSequence);
+			convertIndex(settings, dbPrefix);
+		}
+		else if (boost::filesystem::remove(dbPrefix + ".fmi"))
+			settings.logging().log(e_logInfo, "Removed outdated native index " + dbPrefix + ".fmi");
+	}
+	else
+		settings.logging().log(e_logError, "No reference sequence found. Specify valid fastq or fasta input file");
+}
+
+
+
+
+// convert hdf5 index to memory mapped native index
+void
+selectION::convertIndex
+(
+	selection_settings& settings,
+	std::string dbPrefix
+)
+{
+	fmIndex index(settings.get_m_fmIndex_settings(), dbPrefix + ".h5");
+	index.saveNative(dbPrefix + ".fmi");
+	settings.logging().log(e_logInfo, "Wrote native index " + dbPrefix + ".fmi");
+}
+
+
+
+
+// compile regions to selector index with reference names of index
+void
+selectION::compileSelectors
+(
+	selection_settings& settings,
+	std::string dbPrefix,
+	std::string regionsFile,
+	std::string feature,
+	std::string selectorFile
+)
+{
+	// chapter names only, the index itself is not loaded
+	const auto chapters = fmIndex::readChapters(indexFile(settings, dbPrefix));
+	positionFilter filter;
+	const uint32_t selectors = filter.addSelectors(regionsFile, feature);
+	const uint32_t unresolved = filter.resolveReferences(chapters);
+	if (unresolved > 0)
+		settings.logging().log(e_logWarning, std::to_string(unresolved) + " selectors on references not in index");
+	filter.saveIndex(selectorFile);
+	settings.logging().log(e_logInfo, "Wrote " + std::to_string(selectors) + " selectors to " + selectorFile);
+}
+
+
+
+
+// rename references of filter to chapters of index, return unresolved selectors
+uint32_t
+selectION::resolveSelectors
+(
+	positionFilter& filter
+)
+{
+	return filter.resolveReferences(m_index->getChapters());
+}
+
+
+
+
+// scan sequence file for matches, false on error
+bool 
+selectION::select
+(
+	ISequenceFile& seqFile, 
+	positionFilter& filter,
+	std::string outputPath
+)
+{
+	if (!boost::filesystem::is_directory(outputPath))
+	{
+		m_settings.logging().log(e_logError, "Output path is not a directory");
+		return false;
+	}
+	if (m_settings.m_sam != "" && boost::filesystem::is_directory(m_settings.m_sam))
+	{
+		m_settings.logging().log(e_logError, "SAM Output path is a directory");
+		return false;
+	}
+	if (m_settings.m_sam != "")
+		m_samOutput = openSamFile();
+	m_scanError = std::exception_ptr();
+	m_writeActive = true;
+	auto writer = std::thread(&selectION::writeWorker, this, outputPath, seqFile.extension());
+	std::vector<std::thread> worker;
+	for (uint32_t i = 1; i < m_settings.m_threads; i++)
+		worker.push_back(std::thread(&selectION::selectionWorker, this, std::ref(seqFile), std::ref(filter)));
+	selectionWorker(seqFile, filter);
+	for (auto it = worker.begin(); it != worker.end(); ++it)
+		(*it).join();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_writeActive = false;
+	}
+	m_writeCondition.notify_all();
+	writer.join();
+	m_samFile.reset();
+	// records read before the error are written, the scan is still incomplete
+	if (m_scanError)
+	{
+		try
+		{
+			std::rethrow_exception(m_scanError);
+		}
+		catch (std::exception& e)
+		{
+			m_settings.logging().log(e_logError, std::string("Scan incomplete: ") + e.what());
+		}
+		return false;
+	}
+	return true;
+}
+
+
+
+
+// estimate position of single sequence, safe to call from multiple threads
+samRecord
+selectION::estimatePosition
+(
+	std::string const & sequence
+)
+{
+	return m_aligner->estimatePosition(sequence);
+}
+
+
+
+
+// start incremental estimate of read received in chunks, decides at quality threshold
+std::shared_ptr<alignmentSession>
+selectION::startSession
+(
+	void
+)
+{
+	return std::make_shared<alignmentSession>(*m_aligner, m_settings.m_qualityThreshold);
+}
+
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// native index if present and converted from current hdf5 index, hdf5 index otherwise
+std::string
+selectION::indexFile
+(
+	selection_settings& settings,
+	std::string dbPrefix
+)
+{
+	const std::string nativeFile = dbPrefix + ".fmi";
+	const std::string sourceFile = dbPrefix + ".h5";
+	if (!boost::filesystem::exists(nativeFile))
+		return sourceFile;
+	if (boost::filesystem::exists(sourceFile) && !fmIndex::isNativeCurrent(nativeFile, sourceFile))
+	{
+		settings.logging().log(e_logWarning, "Native index " + nativeFile + " is outdated, using " + sourceFile);
+		return sourceFile;
+	}
+	return nativeFile;
+}
+
+
+
+
+// create alignment output file and write header, false on error
+bool
+selectION::openSamFile
+(
+	void
+)
+{
+	samHeaderProgram hp;
+	hp.ID = "SelectION";
+	hp.Name = "SelectION";
+	hp.Version = "1.0";
+	hp.commandLine = m_settings.m_cmd;
+	auto chapters = m_index->getChapters();
+	std::sort(chapters.begin(), chapters.end(),
+				[](std::pair<std::string, uint32_t> a, std::pair<std::string, uint32_t> b)
+				{ return a.second > b.second; });
+	samHeader h;
+	h.program = hp;
+	h.majorFormat = 1;
+	h.minorFormat = 0;
+	h.sequences = chapters;
+	boost::filesystem::path samFile(m_settings.m_sam);
+	try
+	{
+		if (m_settings.m_bam)
+			m_samFile.reset(new fileBAM(samFile.generic_string(), m_settings.m_threads));
+		else
+			m_samFile.reset(new fileSAM(samFile.generic_string()));
+		m_samFile->writeHeader(h);
+	}
+	catch (std::exception& e)
+	{
+		m_settings.logging().log(e_logError, std::string("Error writing sam header: ") + e.what());
+		m_samFile.reset();
+		return false;
+	}
+	return true;
+}
+
+
+
+
+// worker function reading records from disk, aligning and writing back
+void 
+selectION::selectionWorker
+(
+	ISequenceFile& seqs,
+	positionFilter& filter
+)
+{
+	const auto qualityThreshold = m_settings.m_qualityThreshold;
+	const auto activeSelectors = filter.getActiveSelectorCount();
+	std::vector<std::shared_ptr<sequenceBase>> records;
+	// records are encoded by the workers, buffer is reused for all batches
+	std::string samData;
+	std::vector<uint32_t> matches;
+	for (;;)
+	{
+		// read errors stop all workers, each drains the input up to the error
+		try
+		{
+			if (!seqs.getRecords(records))
+				break;
+		}
+		catch (std::exception&)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_scanError)
+				m_scanError = std::current_exception();
+			break;
+		}
+		// results of batch are passed to the writer at once
+		uint32_t samCount = 0;
+		samData.clear();
+		std::map<std::string, std::vector<std::shared_ptr<sequenceBase>>> selected;
+		for (auto it = records.begin(); it != records.end(); ++it)
+		{
+			auto const & record = *it;
+			auto position = m_settings.m_align ? m_aligner->seedAlign(record->getSequence()) :
+												 m_aligner->estimatePosition(record->getSequence());
+			auto recordName = record->getName();
+			position.QNAME = recordName.substr(0, recordName.find(' '));
+			// write pseudo alignment to sam output file
+			if (m_samOutput)
+			{
+				position.TLEN = record->size();
+				if (position.MAPQ < qualityThreshold)
+					position.FLAG |= samFlag::e_unmapped;
+				m_samFile->encode(position, samData);
+				samCount++;
+			}		
+			// write matched records to output directory
+			if (activeSelectors > 0 && position.MAPQ >= qualityThreshold)
+			{
+				filter.match(filter.getReferenceId(position.RNAME), position.POS, static_cast<uint32_t>(record->size()), matches);
+				for (auto it2 = matches.begin(); it2 != matches.end(); ++it2)
+					selected[filter.getDescription(*it2)].push_back(record);
+			}
+		}
+		bool notify = false;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_samData.append(samData);
+			m_samCount += samCount;
+			if (m_samData.size() > SamWriteBufferSize)
+				notify = true;
+			for (auto it = selected.begin(); it != selected.end(); ++it)
+				m_selected[(*it).first].insert(m_selected[(*it).first].end(), (*it).second.begin(), (*it).second.end());
+			if (m_selected.size() > SeqWriteBufferSize)
+				notify = true;
+		}
+		// notify file writer thread
+		if (notify == true)
+			m_writeCondition.notify_one();
+	}
+	m_writeCondition.notify_one();
+}
+
+
+
+
+// worker function writing selected records to stream or disk
+void 
+selectION::writeWorker
+(
+	std::string outputPath,
+	std::string fileExtension
+)
+{
+	boost::filesystem::path dir(outputPath);
+	// encoded sam records, swapped with the shared buffer to keep both allocations
+	std::string samBuffer;
+	// selector files stay open and buffered for the whole run
+	selectorWriter selectorOutput(dir.generic_string(), fileExtension);
+	bool writeActive = true;
+	while (writeActive)
+	{
+		std::map<std::string, std::vector<std::shared_ptr<sequenceBase>>> recordBuffer;
+		size_t samCount = 0;
+		samBuffer.clear();
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			// pause thread until buffers are filled or workers finished
+			m_writeCondition.wait(lock, [this]{ return !m_writeActive ||
+				m_samData.size() > SamWriteBufferSize ||
+				m_selected.size() > SeqWriteBufferSize; });
+			// lock re-aquired, save to copy, final pass drains remaining records
+			writeActive = m_writeActive;
+			recordBuffer = std::move(m_selected);
+			samBuffer.swap(m_samData);
+			samCount = m_samCount;
+			m_samCount = 0;
+			m_selected.clear();
+		}
+		// write selected records if existent
+		if (recordBuffer.size())
+		{
+			uint32_t recordsComplete = 0;
+			bool success = true;
+			for (auto it = recordBuffer.begin(); it != recordBuffer.end(); ++it)
+			{
+				try
+				{
+					for (auto it2 = (*it).second.begin(); it2 != (*it).second.end(); ++it2)
+					{
+						selectorOutput.append((*it).first, (*it2).get());
+						recordsComplete++;
+					}			
+				}
+				catch (std::exception&)
+				{
+					success = false;
+					// TODO handle exceptions on output
+				}
+			}
+			if (success)
+				m_settings.logging().log(e_logInfo, "Successfully wrote " + 
+					std::to_string(recordsComplete) + 
+					" record to disk.");
+			else
+				m_settings.logging().log(e_logError, "Error writing sequence record");
+		}	
+		// final pass writes remaining buffered records
+		if (!writeActive)
+		{
+			try
+			{
+				selectorOutput.flush();
+			}
+			catch (std::exception&)
+			{
+				m_settings.logging().log(e_logError, "Error writing sequence record");
+			}
+		}
+		// write sam records if existent
+		if (samBuffer.size())
+		{
+			try
+			{
+				m_samFile->appendEncoded(samBuffer);
+				m_settings.logging().log(e_logInfo, "Successfully wrote " +
+					std::to_string(samCount) +
+					" records to sam.");
+			}
+			catch (std::exception&)
+			{
+				m_settings.logging().log(e_logError, "Error writing sam record");
+				// TODO handle exceptions on output
+			}
+		}
+	}
+	if (m_samOutput)
+	{
+		try
+		{
+			m_samFile->close();
+		}
+		catch (std::exception&)
+		{
+			m_settings.logging().log(e_logError, "Error writing sam record");
+		}
+	}
 }
\ No newline at end of file
@@ -0,0 +1,210 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class selectionClient
+//
+//  DESCRIPTION   :	Connection to selectionServer sending batched
+//					position queries
+//
+//  RESTRICTIONS  : POSIX sockets
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+//-- private headers -----------------------------------------------------
+#include "selectionClient.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const size_t ReceiveChunk = 64 * 1024;			// bytes received at once
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor, connects to server socket
+selectionClient::selectionClient
+(
+	std::string socketPath
+)
+{
+	sockaddr_un address;
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (socketPath.size() >= sizeof(address.sun_path))
+		throw std::invalid_argument("Socket path too long: " + socketPath);
+	std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+	m_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (m_socket < 0)
+		throw std::runtime_error("Failed to create socket");
+	if (connect(m_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+	{
+		close(m_socket);
+		throw std::runtime_error("Failed to connect to " + socketPath);
+	}
+}
+
+
+
+
+// virtual destructor
+selectionClient::~selectionClient()
+{
+	if (m_socket >= 0)
+		close(m_socket);
+}
+
+
+
+
+// estimate positions of reads or chunks of reads, results in order of queries
+std::vector<serveResult>
+selectionClient::query
+(
+	std::vector<serveQuery> const & queries
+)
+{
+	std::string request;
+	for (auto it = queries.begin(); it != queries.end(); ++it)
+		request += ((*it).chunk ? "+" : "") + (*it).id + "\t" + (*it).sequence + "\n";
+	request += "\n";
+	if (!writeSocket(m_socket, request))
+		throw std::runtime_error("Connection to server lost");
+	std::vector<serveResult> results;
+	auto lines = readResponse();
+	for (auto it = lines.begin(); it != lines.end(); ++it)
+		results.push_back(string2serveResult(*it));
+	if (results.size() != queries.size())
+		throw std::runtime_error("Incomplete response from server");
+	return results;
+}
+
+
+
+
+// release sessions of reads sent in chunks
+void
+selectionClient::endSessions
+(
+	std::vector<std::string> const & ids
+)
+{
+	std::string request;
+	for (auto it = ids.begin(); it != ids.end(); ++it)
+		request += "-" + (*it) + "\n";
+	if (!request.empty() && !writeSocket(m_socket, request))
+		throw std::runtime_error("Connection to server lost");
+}
+
+
+
+
+// send reads in chunks until decided or complete, last result of each read
+std::vector<serveResult>
+selectionClient::stream
+(
+	std::vector<serveQuery> const & reads,
+	uint32_t chunkSize
+)
+{
+	std::vector<serveResult> results(reads.size());
+	std::vector<size_t> pending;		// reads without decision
+	std::vector<std::string> ids;
+	for (size_t i = 0; i < reads.size(); i++)
+	{
+		pending.push_back(i);
+		ids.push_back(reads[i].id);
+	}
+	// one chunk of each pending read per request, as received from sequencer
+	for (size_t offset = 0; !pending.empty(); offset += chunkSize)
+	{
+		std::vector<serveQuery> chunks;
+		for (auto it = pending.begin(); it != pending.end(); ++it)
+		{
+			serveQuery chunk;
+			chunk.id = reads[*it].id;
+			chunk.sequence = reads[*it].sequence.substr(offset, chunkSize);
+			chunk.chunk = true;
+			chunks.push_back(chunk);
+		}
+		auto chunkResults = query(chunks);
+		std::vector<size_t> next;
+		for (size_t i = 0; i < pending.size(); i++)
+		{
+			results[pending[i]] = chunkResults[i];
+			if (!chunkResults[i].decided && offset + chunkSize < reads[pending[i]].sequence.size())
+				next.push_back(pending[i]);
+		}
+		pending.swap(next);
+	}
+	endSessions(ids);
+	return results;
+}
+
+
+
+
+// latency histogram of server as protocol lines
+std::string
+selectionClient::getStatistics
+(
+	void
+)
+{
+	if (!writeSocket(m_socket, "#stats\n"))
+		throw std::runtime_error("Connection to server lost");
+	std::string statistics;
+	auto lines = readResponse();
+	for (auto it = lines.begin(); it != lines.end(); ++it)
+		statistics += (*it) + "\n";
+	return statistics;
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// receive lines up to empty line
+std::vector<std::string>
+selectionClient::readResponse
+(
+	void
+)
+{
+	std::vector<std::string> lines;
+	std::vector<char> chunk(ReceiveChunk);
+	size_t start = 0;
+	for (;;)
+	{
+		for (size_t end = m_buffer.find('\n', start); end != std::string::npos; end = m_buffer.find('\n', start))
+		{
+			std::string line = m_buffer.substr(start, end - start);
+			start = end + 1;
+			if (line.empty())
+			{
+				m_buffer.erase(0, start);
+				return lines;
+			}
+			lines.push_back(line);
+		}
+		const ssize_t received = recv(m_socket, chunk.data(), chunk.size(), 0);
+		if (received <= 0)
+			throw std::runtime_error("Connection to server lost");
+		m_buffer.append(chunk.data(), received);
+	}
+}
@@ -0,0 +1,547 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class selectionServer
+//
+//  DESCRIPTION   :	Resident index answering batched position queries
+//					on a Unix domain socket
+//
+//  RESTRICTIONS  : POSIX sockets
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <csignal>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+
+//-- private headers -----------------------------------------------------
+#include "selectionServer.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const size_t LatencyBuckets = 32;				// power of two microsecond buckets
+const int PollTimeout = 200;					// milliseconds between checks for interrupt
+const size_t ReceiveChunk = 64 * 1024;			// bytes received at once
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+extern "C" void interruptServer(int);
+
+//-- private global variables -- definitions (should be empty) -----------
+// set by signal handler, checked by accept and client loops
+volatile std::sig_atomic_t serverInterrupted = 0;
+
+//-- exported functions -------- definitions -----------------------------
+// constructor
+selectionServer::selectionServer
+(
+	selection_settings& settings,
+	selectION& selection,
+	positionFilter& filter
+) :m_settings(settings), m_selection(selection), m_filter(filter), m_latency(LatencyBuckets)
+{
+	for (auto it = m_latency.begin(); it != m_latency.end(); ++it)
+		(*it) = 0;
+	m_requests = 0;
+	m_reads = 0;
+	// thread of request takes part in processing its batch
+	for (uint32_t i = 1; i < m_settings.get_m_threads(); i++)
+		m_workers.push_back(std::thread(&selectionServer::queryWorker, this));
+}
+
+
+
+
+// virtual destructor
+selectionServer::~selectionServer()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_batchQueued.notify_all();
+	for (auto it = m_workers.begin(); it != m_workers.end(); ++it)
+		(*it).join();
+}
+
+
+
+
+// accept clients on socket until interrupted by SIGINT or SIGTERM
+void
+selectionServer::run
+(
+	std::string socketPath
+)
+{
+	sockaddr_un address;
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (socketPath.size() >= sizeof(address.sun_path))
+		throw std::invalid_argument("Socket path too long: " + socketPath);
+	std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+	// remove socket of previous run, never other files
+	struct stat status;
+	if (stat(socketPath.c_str(), &status) == 0)
+	{
+		if (!S_ISSOCK(status.st_mode))
+			throw std::invalid_argument("Socket path exists and is no socket: " + socketPath);
+		unlink(socketPath.c_str());
+	}
+	const int listenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listenSocket < 0)
+		throw std::runtime_error("Failed to create socket");
+	if (bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+		listen(listenSocket, SOMAXCONN) < 0)
+	{
+		close(listenSocket);
+		throw std::runtime_error("Failed to listen on " + socketPath);
+	}
+	serverInterrupted = 0;
+	std::signal(SIGINT, interruptServer);
+	std::signal(SIGTERM, interruptServer);
+	m_settings.logging().log(e_logInfo, "Serving queries on " + socketPath);
+	std::vector<std::thread> clients;
+	while (!serverInterrupted)
+	{
+		// threads of disconnected clients are released while serving
+		joinFinishedClients(clients);
+		pollfd request;
+		request.fd = listenSocket;
+		request.events = POLLIN;
+		request.revents = 0;
+		if (poll(&request, 1, PollTimeout) <= 0)
+			continue;
+		const int clientSocket = accept(listenSocket, NULL, NULL);
+		if (clientSocket >= 0)
+			clients.push_back(std::thread(&selectionServer::clientWorker, this, clientSocket));
+	}
+	for (auto it = clients.begin(); it != clients.end(); ++it)
+		(*it).join();
+	close(listenSocket);
+	unlink(socketPath.c_str());
+	std::signal(SIGINT, SIG_DFL);
+	std::signal(SIGTERM, SIG_DFL);
+	m_settings.logging().log(e_logInfo, "Stopped serving after " + std::to_string(m_requests) +
+										" requests with " + std::to_string(m_reads) + " reads");
+}
+
+
+
+
+// estimate positions of batch, uses all worker threads
+std::vector<serveResult>
+selectionServer::query
+(
+	std::vector<serveQuery> const & queries
+)
+{
+	return query(queries, std::vector<std::shared_ptr<alignmentSession>>(queries.size()));
+}
+
+
+
+
+// estimate positions of batch, chunks are appended to their sessions
+std::vector<serveResult>
+selectionServer::query
+(
+	std::vector<serveQuery> const & queries,
+	std::vector<std::shared_ptr<alignmentSession>> const & sessions
+)
+{
+	std::vector<serveResult> results(queries.size());
+	if (queries.empty())
+		return results;
+	auto batch = std::make_shared<serveBatch>();
+	batch->queries = &queries;
+	batch->sessions = &sessions;
+	batch->results = &results;
+	batch->size = queries.size();
+	batch->next = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_batches.push_back(batch);
+	}
+	m_batchQueued.notify_all();
+	processBatch(*batch);
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_batchDone.wait(lock, [&batch]{ return batch->finished == batch->size; });
+		auto it = std::find(m_batches.begin(), m_batches.end(), batch);
+		if (it != m_batches.end())
+			m_batches.erase(it);
+	}
+	m_reads += queries.size();
+	return results;
+}
+
+
+
+
+// latency histogram of requests as protocol lines
+std::string
+selectionServer::getStatistics
+(
+	void
+)
+{
+	std::string statistics = "#requests\t" + std::to_string(m_requests) + "\n" +
+							 "#reads\t" + std::to_string(m_reads) + "\n";
+	for (size_t i = 0; i < m_latency.size(); i++)
+	{
+		const uint64_t count = m_latency[i];
+		if (count > 0)
+			statistics += "#latency_us\t" + std::to_string((1ULL << i) - 1) + "\t" +
+						  std::to_string((1ULL << (i + 1)) - 1) + "\t" + std::to_string(count) + "\n";
+	}
+	return statistics;
+}
+
+
+
+
+// result to protocol line without line break
+std::string
+serveResult2string
+(
+	serveResult const & result
+)
+{
+	std::string selectors;
+	for (auto it = result.selectors.begin(); it != result.selectors.end(); ++it)
+		selectors += (it == result.selectors.begin() ? "" : ",") + (*it);
+	return (result.chunk ? (result.decided ? "+" : "?") : "") + result.id + "\t" +
+		   result.reference + "\t" +
+		   std::to_string(result.position) + "\t" +
+		   (result.reference == "*" ? "*" : result.reverse ? "-" : "+") + "\t" +
+		   std::to_string(result.mapq) + "\t" +
+		   (selectors.empty() ? "*" : selectors);
+}
+
+
+
+
+// protocol line to result
+serveResult
+string2serveResult
+(
+	std::string const & line
+)
+{
+	std::vector<std::string> cols;
+	size_t start = 0;
+	for (size_t end = line.find('\t'); end != std::string::npos; end = line.find('\t', start))
+	{
+		cols.push_back(line.substr(start, end - start));
+		start = end + 1;
+	}
+	cols.push_back(line.substr(start));
+	if (cols.size() != 6)
+		throw std::invalid_argument("Malformed result: " + line);
+	serveResult result;
+	result.id = cols[0];
+	if (!result.id.empty() && (result.id[0] == '+' || result.id[0] == '?'))
+	{
+		result.chunk = true;
+		result.decided = result.id[0] == '+';
+		result.id.erase(0, 1);
+	}
+	result.reference = cols[1];
+	result.position = static_cast<uint32_t>(std::stoul(cols[2]));
+	result.reverse = cols[3] == "-";
+	result.mapq = static_cast<uint32_t>(std::stoul(cols[4]));
+	if (cols[5] != "*")
+	{
+		start = 0;
+		for (size_t end = cols[5].find(','); end != std::string::npos; end = cols[5].find(',', start))
+		{
+			result.selectors.push_back(cols[5].substr(start, end - start));
+			start = end + 1;
+		}
+		result.selectors.push_back(cols[5].substr(start));
+	}
+	return result;
+}
+
+
+
+// send complete data on socket, false if peer disconnected
+bool
+writeSocket
+(
+	int socket,
+	std::string const & data
+)
+{
+	size_t sent = 0;
+	while (sent < data.size())
+	{
+		const ssize_t n = send(socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+		if (n <= 0)
+			return false;
+		sent += n;
+	}
+	return true;
+}
+
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// estimate position and selector matches of single read or next chunk
+serveResult
+selectionServer::classify
+(
+	serveQuery const & query,
+	std::shared_ptr<alignmentSession> const & session
+)
+{
+	serveResult result;
+	result.id = query.id;
+	samRecord position;
+	size_t length = query.sequence.size();
+	if (session != NULL)
+	{
+		result.chunk = true;
+		result.decided = session->append(query.sequence);
+		position = session->result();
+		length = session->size();
+	}
+	else
+		position = m_selection.estimatePosition(query.sequence);
+	result.reference = position.RNAME;
+	result.position = position.POS;
+	result.reverse = (position.FLAG & samFlag::e_reverseComplement) != 0;
+	result.mapq = position.MAPQ;
+	// selectors of final decisions only
+	if (result.decided && position.MAPQ >= m_settings.get_m_qualityThreshold())
+		result.selectors = m_filter.match(position.RNAME, position.POS, static_cast<uint32_t>(length));
+	return result;
+}
+
+
+
+
+// classify unclaimed reads of batch
+void
+selectionServer::processBatch
+(
+	serveBatch& batch
+)
+{
+	for (;;)
+	{
+		// results of claimed reads only, batch may be released by its request afterwards
+		const size_t i = batch.next++;
+		if (i >= batch.size)
+			break;
+		(*batch.results)[i] = classify((*batch.queries)[i], (*batch.sessions)[i]);
+		bool complete;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			complete = ++batch.finished == batch.size;
+		}
+		if (complete)
+			m_batchDone.notify_all();
+	}
+}
+
+
+
+
+// worker thread processing queued batches
+void
+selectionServer::queryWorker
+(
+	void
+)
+{
+	for (;;)
+	{
+		std::shared_ptr<serveBatch> batch;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_batchQueued.wait(lock, [this]{ return m_stop || !m_batches.empty(); });
+			if (m_stop)
+				break;
+			batch = m_batches.front();
+			if (batch->next >= batch->size)
+			{
+				m_batches.pop_front();
+				continue;
+			}
+		}
+		processBatch(*batch);
+	}
+}
+
+
+
+
+// read requests of one client until disconnect
+void
+selectionServer::clientWorker
+(
+	int clientSocket
+)
+{
+	std::vector<char> chunk(ReceiveChunk);
+	std::string buffer;
+	std::vector<serveQuery> queries;
+	// sessions of reads streamed in chunks, live until ended or disconnect
+	std::unordered_map<std::string, std::shared_ptr<alignmentSession>> sessions;
+	std::vector<std::shared_ptr<alignmentSession>> querySessions;
+	std::unordered_map<std::string, size_t> queryChunks;		// chunks of request by read
+	auto requestStart = std::chrono::steady_clock::now();
+	bool connected = true;
+	while (connected && !serverInterrupted)
+	{
+		pollfd request;
+		request.fd = clientSocket;
+		request.events = POLLIN;
+		request.revents = 0;
+		if (poll(&request, 1, PollTimeout) <= 0)
+			continue;
+		const ssize_t received = recv(clientSocket, chunk.data(), chunk.size(), 0);
+		if (received <= 0)
+			break;
+		buffer.append(chunk.data(), received);
+		size_t start = 0;
+		for (size_t end = buffer.find('\n'); end != std::string::npos && connected; end = buffer.find('\n', start))
+		{
+			std::string line = buffer.substr(start, end - start);
+			start = end + 1;
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+			if (line.empty())
+			{
+				// end of request, answer in order of reads
+				auto results = query(queries, querySessions);
+				std::string response;
+				for (auto it = results.begin(); it != results.end(); ++it)
+					response += serveResult2string(*it) + "\n";
+				response += "\n";
+				connected = writeSocket(clientSocket, response);
+				recordLatency(std::chrono::duration_cast<std::chrono::microseconds>(
+					std::chrono::steady_clock::now() - requestStart).count());
+				queries.clear();
+				querySessions.clear();
+				queryChunks.clear();
+			}
+			else if (line == "#stats")
+				connected = writeSocket(clientSocket, getStatistics() + "\n");
+			else if (line[0] == '-')
+				sessions.erase(line.substr(1));
+			else
+			{
+				if (queries.empty())
+					requestStart = std::chrono::steady_clock::now();
+				const bool chunk = line[0] == '+';
+				const size_t tab = line.find('\t');
+				serveQuery query;
+				query.id = line.substr(chunk ? 1 : 0, tab == std::string::npos ? tab : tab - (chunk ? 1 : 0));
+				if (tab != std::string::npos)
+					query.sequence = line.substr(tab + 1);
+				query.chunk = chunk;
+				if (!chunk)
+				{
+					queries.push_back(query);
+					querySessions.push_back(std::shared_ptr<alignmentSession>());
+					continue;
+				}
+				// chunks of a read within one request are answered once
+				auto pending = queryChunks.find(query.id);
+				if (pending != queryChunks.end())
+				{
+					queries[(*pending).second].sequence.append(query.sequence);
+					continue;
+				}
+				auto& session = sessions[query.id];
+				if (session == NULL)
+					session = m_selection.startSession();
+				queryChunks[query.id] = queries.size();
+				queries.push_back(query);
+				querySessions.push_back(session);
+			}
+		}
+		buffer.erase(0, start);
+	}
+	close(clientSocket);
+	std::lock_guard<std::mutex> lock(m_clientMutex);
+	m_finishedClients.push_back(std::this_thread::get_id());
+}
+
+
+
+
+// join client threads that have finished since last call
+void
+selectionServer::joinFinishedClients
+(
+	std::vector<std::thread>& clients
+)
+{
+	std::vector<std::thread::id> finished;
+	{
+		std::lock_guard<std::mutex> lock(m_clientMutex);
+		finished.swap(m_finishedClients);
+	}
+	for (auto it = finished.begin(); it != finished.end(); ++it)
+	{
+		auto client = std::find_if(clients.begin(), clients.end(),
+			[&it](std::thread const & t) { return t.get_id() == *it; });
+		if (client == clients.end())
+			continue;
+		(*client).join();
+		std::swap(*client, clients.back());
+		clients.pop_back();
+	}
+}
+
+
+
+
+// add request duration to histogram
+void
+selectionServer::recordLatency
+(
+	uint64_t microseconds
+)
+{
+	size_t bucket = 0;
+	while (bucket + 1 < m_latency.size() && (microseconds + 1) >> (bucket + 1))
+		bucket++;
+	m_latency[bucket]++;
+	m_requests++;
+}
+
+
+
+
+// set interrupt flag only, loops stop within poll timeout
+extern "C" void
+interruptServer
+(
+	int
+)
+{
+	serverInterrupted = 1;
+}
+
@@ -0,0 +1,165 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class selectorWriter
+//
+//  DESCRIPTION   :	Buffered output files of selectors, files stay open
+//					for the whole scan
+//
+//  RESTRICTIONS  : not thread safe, used by the writer thread only
+//
+//  REQUIRES      : POSIX file descriptors
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <stdexcept>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <boost/filesystem.hpp>
+
+//-- private headers -----------------------------------------------------
+#include "selectorWriter.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const size_t SelectorBufferSize = 256 * 1024;		// write selector once buffer is full
+const size_t MaxBufferedBytes = 64 * 1024 * 1024;	// write all selectors beyond
+const size_t MaxOpenFiles = 256;					// below common descriptor limits
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor, files are created in outputPath on first write
+selectorWriter::selectorWriter
+(
+	std::string outputPath,
+	std::string fileExtension
+) : m_outputPath(outputPath), m_fileExtension(fileExtension), m_stream(&m_appendBuffer)
+{
+
+}
+
+
+
+
+// virtual destructor, writes remaining records
+selectorWriter::~selectorWriter()
+{
+	try
+	{
+		flush();
+	}
+	catch (std::exception&)
+	{
+		// errors are reported by explicit flush
+	}
+	for (auto it = m_openFiles.begin(); it != m_openFiles.end(); ++it)
+		::close((*it)->descriptor);
+}
+
+
+
+
+// append record to buffer of selector, full buffers are written to disk
+void
+selectorWriter::append
+(
+	std::string const & selector,
+	const sequenceBase* record
+)
+{
+	selectorFile& file = m_files[selector];
+	const size_t size = file.buffer.size();
+	m_appendBuffer.setTarget(&file.buffer);
+	m_stream << record;
+	m_buffered += file.buffer.size() - size;
+	if (file.buffer.size() >= SelectorBufferSize)
+		write(selector, file);
+	if (m_buffered >= MaxBufferedBytes)
+		flush();
+}
+
+
+
+
+// write buffers of all selectors to disk
+void
+selectorWriter::flush
+(
+	void
+)
+{
+	for (auto it = m_files.begin(); it != m_files.end(); ++it)
+	{
+		if (!(*it).second.buffer.empty())
+			write((*it).first, (*it).second);
+	}
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// write buffer of selector, opens file if required
+void
+selectorWriter::write
+(
+	std::string const & selector,
+	selectorFile& file
+)
+{
+	const std::string filePath = (boost::filesystem::path(m_outputPath) / (selector + m_fileExtension)).generic_string();
+	if (file.descriptor < 0)
+	{
+		if (m_openFiles.size() >= MaxOpenFiles)
+			closeLeastRecent();
+		file.descriptor = ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+		if (file.descriptor < 0)
+			throw std::runtime_error("Could not open " + filePath + " for writing");
+		file.recent = m_openFiles.insert(m_openFiles.begin(), &file);
+	}
+	else
+		m_openFiles.splice(m_openFiles.begin(), m_openFiles, file.recent);
+	const char* data = file.buffer.data();
+	size_t remaining = file.buffer.size();
+	while (remaining > 0)
+	{
+		const ssize_t written = ::write(file.descriptor, data, remaining);
+		if (written < 0 && errno == EINTR)
+			continue;
+		if (written <= 0)
+			throw std::runtime_error("Failed to write " + filePath);
+		data += written;
+		remaining -= static_cast<size_t>(written);
+	}
+	m_buffered -= file.buffer.size();
+	file.buffer.clear();
+}
+
+
+
+
+// close file written least recently to stay below open file limit
+void
+selectorWriter::closeLeastRecent
+(
+	void
+)
+{
+	if (m_openFiles.empty())
+		return;
+	selectorFile* leastRecent = m_openFiles.back();
+	::close(leastRecent->descriptor);
+	leastRecent->descriptor = -1;
+	m_openFiles.pop_back();
+}
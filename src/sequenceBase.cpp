@@ -1,118 +1,193 @@
-// \MODULE\---------------------------------------------------------------
-//
-//  CONTENTS      : Class sequenceRecord
-//
-//  DESCRIPTION   :	Container base class for sequence records
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-// All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-
-//-- standard headers ----------------------------------------------------
-
-//-- private headers -----------------------------------------------------
-#include "sequenceBase.h"
-
-//-- source control system ID (if needed)---------------------------------
-
-//-- exported global variables - definitions (should be empty) -----------
-
-//-- private constants ---------------------------------------------------
-
-//-- private types -------------------------------------------------------
-
-//-- private functions --------- declarations ----------------------------
-
-//-- private global variables -- definitions (should be empty) -----------
-
-//-- exported functions -------- definitions -----------------------------
-// constructor
-sequenceBase::sequenceBase
-(
-	std::string name,
-	std::string sequence
-)
-{
-	m_name = name;
-	m_sequence = sequence;
-}
-
-
-
-
-// constructor
-sequenceBase::sequenceBase()
-{
-
-}
-
-
-
-
-// virtual destructor
-sequenceBase::~sequenceBase()
-{
-
-}
-
-
-
-
-// get methods
-size_t 
-sequenceBase::size()
-{
-	return m_sequence.size();
-}
-
-
-
-std::string 
-sequenceBase::getName(void)const
-{
-	return m_name;
-}
-
-
-
-
-std::string 
-sequenceBase::getSequence(void)const
-{
-	return m_sequence;
-}
-
-
-
-
-// write record to stream 
-void 
-sequenceBase::write2Stream
-(
-	std::ostream& stream
-)const
-{
-	stream << m_sequence << std::endl;
-}
-
-
-
-
-std::ostream& operator<< 
-(
-	std::ostream& outStream, 
-	const sequenceBase* seq
-)
-{
-	seq->write2Stream(outStream);
-	return outStream;
-}
-
-
-
-
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class sequenceRecord
+//
+//  DESCRIPTION   :	Container base class for sequence records
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+
+//-- private headers -----------------------------------------------------
+#include "sequenceBase.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor
+sequenceBase::sequenceBase
+(
+	std::string name,
+	std::string sequence
+)
+{
+	auto buffer = std::make_shared<std::vector<char>>();
+	buffer->reserve(name.size() + sequence.size());
+	m_name = appendField(*buffer, name);
+	m_sequence = appendField(*buffer, sequence);
+	m_buffer = buffer;
+}
+
+
+
+
+// constructor, fields refer to shared buffer
+sequenceBase::sequenceBase
+(
+	sequenceBuffer buffer,
+	sequenceField name,
+	sequenceField sequence
+) :m_buffer(buffer), m_name(name), m_sequence(sequence)
+{
+
+}
+
+
+
+
+// constructor
+sequenceBase::sequenceBase()
+{
+
+}
+
+
+
+
+// virtual destructor
+sequenceBase::~sequenceBase()
+{
+
+}
+
+
+
+
+// get methods
+size_t 
+sequenceBase::size()
+{
+	return m_sequence.length;
+}
+
+
+
+std::string 
+sequenceBase::getName(void)const
+{
+	return getField(m_name);
+}
+
+
+
+
+std::string 
+sequenceBase::getSequence(void)const
+{
+	return getField(m_sequence);
+}
+
+
+
+
+const char*
+sequenceBase::getSequenceData(void)const
+{
+	return m_buffer ? m_buffer->data() + m_sequence.offset : NULL;
+}
+
+
+
+
+// field as string, empty if not set
+std::string
+sequenceBase::getField
+(
+	sequenceField const & field
+)const
+{
+	if (!m_buffer || field.length == 0)
+		return std::string();
+	return std::string(m_buffer->data() + field.offset, field.length);
+}
+
+
+
+
+// write field without copy to stream
+void
+sequenceBase::writeField
+(
+	std::ostream& stream,
+	sequenceField const & field
+)const
+{
+	if (m_buffer && field.length > 0)
+		stream.write(m_buffer->data() + field.offset, field.length);
+}
+
+
+
+
+// append value to buffer, return its location
+sequenceField
+sequenceBase::appendField
+(
+	std::vector<char>& buffer,
+	std::string const & value
+)
+{
+	sequenceField field;
+	field.offset = buffer.size();
+	field.length = value.size();
+	buffer.insert(buffer.end(), value.begin(), value.end());
+	return field;
+}
+
+
+
+
+// write record to stream 
+void 
+sequenceBase::write2Stream
+(
+	std::ostream& stream
+)const
+{
+	writeField(stream, m_sequence);
+	stream << '\n';
+}
+
+
+
+
+std::ostream& operator<< 
+(
+	std::ostream& outStream, 
+	const sequenceBase* seq
+)
+{
+	seq->write2Stream(outStream);
+	return outStream;
+}
+
+
+
+
 //-- private functions --------- definitions -----------------------------
\ No newline at end of file
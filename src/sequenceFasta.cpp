@@ -1,133 +1,165 @@
-// \MODULE\---------------------------------------------------------------
-//
-//  CONTENTS      : Class fastaRecord
-//
-//  DESCRIPTION   :	Container class for fasta sequence record
-//
-//  RESTRICTIONS  : none
-//
-//  REQUIRES      : none
-//
-// -----------------------------------------------------------------------
-// All rights reserved to Pay Gieelmann, Germany
-// -----------------------------------------------------------------------
-
-//-- standard headers ----------------------------------------------------
-#include <string>
-#include <cstdint>
-#include <cstddef>
-#include <algorithm>
-
-//-- private headers -----------------------------------------------------
-#include "sequenceFasta.h"
-
-//-- source control system ID (if needed)---------------------------------
-
-//-- exported global variables - definitions (should be empty) -----------
-
-//-- private constants ---------------------------------------------------
-const ptrdiff_t FastaLineWidth = 60;
-
-//-- private types -------------------------------------------------------
-
-//-- private functions --------- declarations ----------------------------
-
-//-- private global variables -- definitions (should be empty) -----------
-
-//-- exported functions -------- definitions -----------------------------
-// constructor
-sequenceFasta::sequenceFasta
-(
-	std::string name, 
-	std::string sequence, 
-	std::vector<std::string> comments
-	) :sequenceBase(name, sequence)
-{
-	m_name = name;
-	m_comments = comments;
-}
-
-
-
-
-// constructor
-sequenceFasta::sequenceFasta
-(
-	std::istream& str
-)
-{
-	if (str.peek() == '>')
-	{
-		std::string buffer;
-		if (std::getline(str, buffer).good())
-			m_name = buffer.substr(1);
-		while (str.peek() == ';')
-		{
-			if (std::getline(str, buffer).good())
-				m_comments.push_back(buffer.substr(1));
-			else
-				break;
-		}
-		while (str.good() && str.peek() != '>')
-		{
-			std::getline(str, buffer);
-			m_sequence.append(buffer);
-		}
-	}
-}
-
-
-
-
-// virtual destructor
-sequenceFasta::~sequenceFasta()
-{
-
-}
-
-
-
-
-// get methods
-std::string 
-sequenceFasta::getName(void)const
-{
-	return m_name;
-}
-
-
-
-
-std::vector<std::string> 
-sequenceFasta::getComments(void)const
-{
-	return m_comments;
-}
-
-
-
-
-// write record to stream 
-void
-sequenceFasta::write2Stream
-(
-	std::ostream& stream
-)const
-{
-	stream << ">" << m_name << std::endl;
-	for (auto it = m_comments.begin(); it != m_comments.end(); ++it)
-		stream << ";" << *it << std::endl;
-	auto const & seq =  getSequence();
-	auto seqIter = seq.begin();
-	while (seqIter != seq.end())
-	{
-		uint32_t line = std::min(FastaLineWidth, std::distance(seqIter, seq.end()));
-		stream.write(&*seqIter, line) << std::endl;
-		seqIter += line;
-	}
-}
-
-
-
-
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : Class fastaRecord
+//
+//  DESCRIPTION   :	Container class for fasta sequence record
+//
+//  RESTRICTIONS  : none
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+//-- private headers -----------------------------------------------------
+#include "sequenceFasta.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const ptrdiff_t FastaLineWidth = 60;
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor
+sequenceFasta::sequenceFasta
+(
+	std::string name, 
+	std::string sequence, 
+	std::vector<std::string> comments
+)
+{
+	auto buffer = std::make_shared<std::vector<char>>();
+	m_name = appendField(*buffer, name);
+	m_sequence = appendField(*buffer, sequence);
+	for (auto it = comments.begin(); it != comments.end(); ++it)
+		m_comments.push_back(appendField(*buffer, *it));
+	m_buffer = buffer;
+}
+
+
+
+
+// constructor
+sequenceFasta::sequenceFasta
+(
+	std::istream& str
+)
+{
+	auto record = std::make_shared<std::vector<char>>();
+	if (str.peek() == '>')
+	{
+		std::string buffer;
+		if (std::getline(str, buffer).good())
+			m_name = appendField(*record, buffer.substr(1));
+		while (str.peek() == ';')
+		{
+			if (std::getline(str, buffer).good())
+				m_comments.push_back(appendField(*record, buffer.substr(1)));
+			else
+				break;
+		}
+		std::string sequence;
+		while (str.good() && str.peek() != '>')
+		{
+			std::getline(str, buffer);
+			sequence.append(buffer);
+		}
+		m_sequence = appendField(*record, sequence);
+	}
+	m_buffer = record;
+}
+
+
+
+
+// constructor, fields refer to shared buffer
+sequenceFasta::sequenceFasta
+(
+	sequenceBuffer buffer,
+	sequenceField name,
+	sequenceField sequence,
+	std::vector<sequenceField> comments
+) :sequenceBase(buffer, name, sequence), m_comments(comments)
+{
+
+}
+
+
+
+
+// virtual destructor
+sequenceFasta::~sequenceFasta()
+{
+
+}
+
+
+
+
+// get methods
+std::string 
+sequenceFasta::getName(void)const
+{
+	return getField(m_name);
+}
+
+
+
+
+std::vector<std::string> 
+sequenceFasta::getComments(void)const
+{
+	std::vector<std::string> comments;
+	for (auto it = m_comments.begin(); it != m_comments.end(); ++it)
+		comments.push_back(getField(*it));
+	return comments;
+}
+
+
+
+
+// write record to stream 
+void
+sequenceFasta::write2Stream
+(
+	std::ostream& stream
+)const
+{
+	stream << ">";
+	writeField(stream, m_name);
+	stream << '\n';
+	for (auto it = m_comments.begin(); it != m_comments.end(); ++it)
+	{
+		stream << ";";
+		writeField(stream, *it);
+		stream << '\n';
+	}
+	const char* seqIter = getSequenceData();
+	const char* seqEnd = seqIter + m_sequence.length;
+	while (seqIter != seqEnd)
+	{
+		uint32_t line = static_cast<uint32_t>(std::min(FastaLineWidth, std::distance(seqIter, seqEnd)));
+		stream.write(seqIter, line) << '\n';
+		seqIter += line;
+	}
+}
+
+
+
+
 //-- private functions --------- definitions -----------------------------
\ No newline at end of file
@@ -0,0 +1,320 @@
+// \MODULE\---------------------------------------------------------------
+//
+//  CONTENTS      : suffix array construction by induced sorting
+//
+//  DESCRIPTION   :	linear time SA-IS construction of the suffix array,
+//					streamed in segments like suffixArray
+//
+//  RESTRICTIONS  : input terminated by unique '$'
+//
+//  REQUIRES      : none
+//
+// -----------------------------------------------------------------------
+// All rights reserved to Pay Gieelmann, Germany
+// -----------------------------------------------------------------------
+
+//-- standard headers ----------------------------------------------------
+#include <algorithm>
+#include <stdexcept>
+
+//-- private headers -----------------------------------------------------
+#include "suffixArraySAIS.h"
+#include "kmerCounter.h"
+
+//-- source control system ID (if needed)---------------------------------
+
+//-- exported global variables - definitions (should be empty) -----------
+
+//-- private constants ---------------------------------------------------
+const uint32_t EmptySlot = 0xFFFFFFFF;			// unused suffix array entry
+
+//-- private types -------------------------------------------------------
+
+//-- private functions --------- declarations ----------------------------
+template<typename T>
+static void getBuckets(const T* s, const uint32_t n, const uint32_t K, std::vector<uint32_t>& bkt, const bool end);
+template<typename T>
+static void induceL(const T* s, uint32_t* SA, const uint32_t n, const uint32_t K,
+					std::vector<bool> const & t, std::vector<uint32_t>& bkt);
+template<typename T>
+static void induceS(const T* s, uint32_t* SA, const uint32_t n, const uint32_t K,
+					std::vector<bool> const & t, std::vector<uint32_t>& bkt);
+template<typename T>
+static void sais(const T* s, uint32_t* SA, const uint32_t n, const uint32_t K);
+
+//-- private global variables -- definitions (should be empty) -----------
+
+//-- exported functions -------- definitions -----------------------------
+// constructor
+suffixArraySAIS::suffixArraySAIS
+(
+	std::string& S,
+	uint32_t t
+) :m_S(S)
+{
+	kmerCounter counter(S, t);
+	m_alphabet = counter.getAlphabet();
+	m_alphabetCount = counter.getAlphabetCount();
+	const size_t sentinel = m_alphabet.find('$');
+	if (sentinel == std::string::npos || m_alphabetCount[sentinel] != 1 ||
+		m_S.size() >= EmptySlot || *m_S.rbegin() != '$')
+		throw std::invalid_argument("Induced sorting requires input terminated by unique '$'");
+}
+
+
+
+
+// virtual destructor
+suffixArraySAIS::~suffixArraySAIS()
+{
+
+}
+
+
+
+
+// get alphabet
+std::string
+suffixArraySAIS::getAlphabet
+(
+	void
+)
+{
+	return m_alphabet;
+}
+
+
+
+
+// get number of characters for each letter in alphabet
+std::vector<uint32_t>
+suffixArraySAIS::getAlphabetCount
+(
+	void
+)
+{
+	return m_alphabetCount;
+}
+
+
+
+
+// prepare for streaming suffix array
+uint32_t
+suffixArraySAIS::prepareForStream
+(
+	uint32_t maxBlockSize
+)
+{
+	const uint32_t n = static_cast<uint32_t>(m_S.size());
+	if (m_SA.size() != n)
+	{
+		// sentinel is the unique smallest symbol, other characters ranked in alphabet order
+		std::vector<uint8_t> rank(256, 0);
+		uint8_t nextRank = 1;
+		for (auto it = m_alphabet.begin(); it != m_alphabet.end(); ++it)
+			if ((*it) != '$')
+				rank[static_cast<uint8_t>(*it)] = nextRank++;
+		std::vector<uint8_t> s(n);
+		for (uint32_t i = 0; i < n; ++i)
+			s[i] = rank[static_cast<uint8_t>(m_S[i])];
+		m_SA.resize(n);		// may throw bad_alloc
+		sais<uint8_t>(s.data(), m_SA.data(), n, nextRank);
+	}
+	m_segmentSize = maxBlockSize > 0 ? maxBlockSize : 1;
+	m_streamPosition = 0;
+	return std::min(m_segmentSize, n);
+}
+
+
+
+
+// get next Segment from suffix array stream
+std::vector<uint32_t>
+suffixArraySAIS::getNextSegment
+(
+	void
+)
+{
+	if (m_streamPosition >= m_SA.size())
+	{
+		std::vector<uint32_t>().swap(m_SA);
+		return std::vector<uint32_t>();
+	}
+	const size_t end = std::min(m_SA.size(), m_streamPosition + m_segmentSize);
+	std::vector<uint32_t> segment(m_SA.begin() + m_streamPosition, m_SA.begin() + end);
+	m_streamPosition = end;
+	return segment;
+}
+
+
+
+
+//-- private functions --------- definitions -----------------------------
+// bucket start or end positions for symbols of s
+template<typename T>
+static void
+getBuckets
+(
+	const T* s,
+	const uint32_t n,
+	const uint32_t K,
+	std::vector<uint32_t>& bkt,
+	const bool end
+)
+{
+	bkt.assign(K, 0);
+	for (uint32_t i = 0; i < n; ++i)
+		bkt[s[i]]++;
+	uint32_t sum = 0;
+	for (uint32_t k = 0; k < K; ++k)
+	{
+		sum += bkt[k];
+		bkt[k] = end ? sum : sum - bkt[k];
+	}
+}
+
+
+
+
+// induce L-type suffixes from sorted suffixes
+template<typename T>
+static void
+induceL
+(
+	const T* s,
+	uint32_t* SA,
+	const uint32_t n,
+	const uint32_t K,
+	std::vector<bool> const & t,
+	std::vector<uint32_t>& bkt
+)
+{
+	getBuckets(s, n, K, bkt, false);
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		const uint32_t j = SA[i];
+		if (j != EmptySlot && j > 0 && !t[j - 1])
+			SA[bkt[s[j - 1]]++] = j - 1;
+	}
+}
+
+
+
+
+// induce S-type suffixes from sorted suffixes
+template<typename T>
+static void
+induceS
+(
+	const T* s,
+	uint32_t* SA,
+	const uint32_t n,
+	const uint32_t K,
+	std::vector<bool> const & t,
+	std::vector<uint32_t>& bkt
+)
+{
+	getBuckets(s, n, K, bkt, true);
+	for (uint32_t i = n; i-- > 0;)
+	{
+		const uint32_t j = SA[i];
+		if (j != EmptySlot && j > 0 && t[j - 1])
+			SA[--bkt[s[j - 1]]] = j - 1;
+	}
+}
+
+
+
+
+// suffix array of s with symbols in [0, K), s[n - 1] unique smallest
+template<typename T>
+static void
+sais
+(
+	const T* s,
+	uint32_t* SA,
+	const uint32_t n,
+	const uint32_t K
+)
+{
+	if (n == 1)
+	{
+		SA[0] = 0;
+		return;
+	}
+	// classify suffixes as S-type (true) or L-type (false)
+	std::vector<bool> t(n, false);
+	t[n - 1] = true;
+	for (uint32_t i = n - 1; i-- > 0;)
+		t[i] = s[i] < s[i + 1] || (s[i] == s[i + 1] && t[i + 1]);
+	auto isLMS = [&t](uint32_t i) -> bool{return i > 0 && t[i] && !t[i - 1]; };
+
+	// sort LMS substrings by induction from bucket ends
+	std::vector<uint32_t> bkt;
+	getBuckets(s, n, K, bkt, true);
+	std::fill(SA, SA + n, EmptySlot);
+	for (uint32_t i = 1; i < n; ++i)
+		if (isLMS(i))
+			SA[--bkt[s[i]]] = i;
+	induceL(s, SA, n, K, t, bkt);
+	induceS(s, SA, n, K, t, bkt);
+
+	// compact sorted LMS substrings and name them
+	uint32_t n1 = 0;
+	for (uint32_t i = 0; i < n; ++i)
+		if (SA[i] != EmptySlot && isLMS(SA[i]))
+			SA[n1++] = SA[i];
+	std::fill(SA + n1, SA + n, EmptySlot);
+	uint32_t name = 0;
+	uint32_t prev = EmptySlot;
+	for (uint32_t i = 0; i < n1; ++i)
+	{
+		const uint32_t pos = SA[i];
+		bool diff = false;
+		for (uint32_t d = 0; ; ++d)
+		{
+			if (prev == EmptySlot || s[pos + d] != s[prev + d] || t[pos + d] != t[prev + d])
+			{
+				diff = true;
+				break;
+			}
+			else if (d > 0 && (isLMS(pos + d) || isLMS(prev + d)))
+				break;
+		}
+		if (diff)
+		{
+			name++;
+			prev = pos;
+		}
+		SA[n1 + pos / 2] = name - 1;
+	}
+	for (uint32_t i = n, j = n; i-- > n1;)
+		if (SA[i] != EmptySlot)
+			SA[--j] = SA[i];
+
+	// sort reduced string, recurse if names are not unique
+	uint32_t* s1 = SA + n - n1;
+	if (name < n1)
+		sais<uint32_t>(s1, SA, n1, name);
+	else
+		for (uint32_t i = 0; i < n1; ++i)
+			SA[s1[i]] = i;
+
+	// induce suffix array from sorted LMS suffixes
+	getBuckets(s, n, K, bkt, true);
+	for (uint32_t i = 1, j = 0; i < n; ++i)
+		if (isLMS(i))
+			s1[j++] = i;
+	for (uint32_t i = 0; i < n1; ++i)
+		SA[i] = s1[SA[i]];
+	std::fill(SA + n1, SA + n, EmptySlot);
+	for (uint32_t i = n1; i-- > 0;)
+	{
+		const uint32_t j = SA[i];
+		SA[i] = EmptySlot;
+		SA[--bkt[s[j]]] = j;
+	}
+	induceL(s, SA, n, K, t, bkt);
+	induceS(s, SA, n, K, t, bkt);
+}